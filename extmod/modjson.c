@@ -130,100 +130,138 @@ static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_dumps_obj, mod_json_dumps);
 // strings).  It does 1 pass over the input stream.  It tries to be fast and
 // small in code size, while not using more RAM than necessary.
 
+// CIRCUITPY-CHANGE
+
+// The parser reads through a window instead of asking the stream for one
+// byte at a time. It only reads ahead on streams that can seek: once the
+// value is complete, the stream is moved back to where a byte at a time
+// parser would have left it, so whatever follows is still there. Other
+// native streams, such as sockets and UARTs, are still read a byte at a time,
+// so nothing after the value is consumed. loads parses the str or bytes in
+// place, and objects that only have a `readinto` method are read in chunks of
+// CIRCUITPY_JSON_READ_CHUNK_SIZE.
+
+#define JSON_WINDOW_SIZE 256
+#define CIRCUITPY_JSON_READ_CHUNK_SIZE 64
+
 typedef struct _json_stream_t {
+    // MP_OBJ_NULL when parsing from memory.
     mp_obj_t stream_obj;
+    // NULL when reading with the object's `readinto` method.
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
-    int errcode;
-    // CIRCUITPY-CHANGE
     mp_obj_t python_readinto[2 + 1];
     mp_obj_array_t bytearray_obj;
-    size_t start;
-    size_t end;
+    // buf[pos:len] has been read but not parsed yet.
+    const byte *buf;
+    size_t pos;
+    size_t len;
+    size_t chunk_size;
+    bool read_ahead;
     byte cur;
+    byte window[JSON_WINDOW_SIZE];
 } json_stream_t;
 
 #define S_EOF (0) // null is not allowed in json stream so is ok as EOF marker
-#define S_END(s) ((s).cur == S_EOF)
-#define S_CUR(s) ((s).cur)
-#define S_NEXT(s) (json_stream_next(&(s)))
+#define S_END(s) ((s)->cur == S_EOF)
+#define S_CUR(s) ((s)->cur)
+#define S_NEXT(s) (json_stream_next(s))
 
-static byte json_stream_next(json_stream_t *s) {
-    mp_uint_t ret = s->read(s->stream_obj, &s->cur, 1, &s->errcode);
-    // CIRCUITPY-CHANGE
-    JSON_DEBUG("  usjon_stream_next err:%2d cur: %c \n", s->errcode, s->cur);
-    if (s->errcode != 0) {
-        mp_raise_OSError(s->errcode);
-    }
-    if (ret == 0) {
-        s->cur = S_EOF;
+static void json_stream_init(json_stream_t *s, mp_obj_t stream_obj) {
+    const mp_stream_p_t *stream_p = mp_proto_get(0, stream_obj);
+    s->stream_obj = stream_obj;
+    s->buf = s->window;
+    s->pos = 0;
+    s->len = 0;
+    s->read_ahead = false;
+    s->cur = 0;
+    if (stream_p == NULL) {
+        mp_load_method(stream_obj, MP_QSTR_readinto, s->python_readinto);
+        s->bytearray_obj.base.type = &mp_type_bytearray;
+        s->bytearray_obj.typecode = BYTEARRAY_TYPECODE;
+        s->bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
+        s->bytearray_obj.free = 0;
+        s->bytearray_obj.items = s->window;
+        s->python_readinto[2] = MP_OBJ_FROM_PTR(&s->bytearray_obj);
+        s->read = NULL;
+        s->chunk_size = CIRCUITPY_JSON_READ_CHUNK_SIZE;
+    } else {
+        stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+        s->read = stream_p->read;
+        if (stream_p->ioctl != NULL) {
+            int errcode;
+            s->read_ahead = mp_stream_seek(stream_obj, 0, MP_SEEK_CUR, &errcode) != (mp_off_t)-1;
+        }
+        s->chunk_size = s->read_ahead ? JSON_WINDOW_SIZE : 1;
     }
-    return s->cur;
 }
 
-// CIRCUITPY-CHANGE
-
-// We read from an object's `readinto` method in chunks larger than the json
-// parser needs to reduce the number of function calls done.
-
-#define CIRCUITPY_JSON_READ_CHUNK_SIZE 64
-
-static mp_uint_t json_python_readinto(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode) {
-    (void)size;  // Ignore size because we know it's always 1.
-    json_stream_t *s = obj;
+static void json_stream_init_buffer(json_stream_t *s, const byte *buf, size_t len) {
+    s->stream_obj = MP_OBJ_NULL;
+    s->buf = buf;
+    s->pos = 0;
+    s->len = len;
+    s->read_ahead = false;
+    s->cur = 0;
+}
 
-    if (s->start == s->end) {
-        *errcode = 0;
-        mp_obj_t ret = mp_call_method_n_kw(1, 0, s->python_readinto);
-        if (ret == mp_const_none) {
-            *errcode = MP_EAGAIN;
-            return MP_STREAM_ERROR;
+static void json_stream_fill(json_stream_t *s) {
+    if (s->stream_obj == MP_OBJ_NULL) {
+        return;
+    }
+    mp_uint_t ret;
+    if (s->read == NULL) {
+        mp_obj_t ret_obj = mp_call_method_n_kw(1, 0, s->python_readinto);
+        if (ret_obj == mp_const_none) {
+            mp_raise_OSError(MP_EAGAIN);
         }
-        s->start = 0;
-        s->end = mp_obj_get_int(ret);
-        if (s->end == 0) {
-            return 0;
+        ret = MIN((mp_uint_t)mp_obj_get_int(ret_obj), s->chunk_size);
+    } else {
+        int errcode;
+        ret = s->read(s->stream_obj, s->window, s->chunk_size, &errcode);
+        if (ret == MP_STREAM_ERROR) {
+            mp_raise_OSError(errcode);
         }
     }
+    s->pos = 0;
+    s->len = ret;
+}
 
-    *((uint8_t *)buf) = ((uint8_t *)s->bytearray_obj.items)[s->start];
-    s->start++;
-    return 1;
+static byte json_stream_next(json_stream_t *s) {
+    if (s->pos == s->len) {
+        json_stream_fill(s);
+    }
+    s->cur = s->pos < s->len ? s->buf[s->pos++] : S_EOF;
+    // CIRCUITPY-CHANGE
+    JSON_DEBUG("  usjon_stream_next cur: %c \n", s->cur);
+    return s->cur;
 }
 
-static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
-    const mp_stream_p_t *stream_p = mp_proto_get(0, stream_obj);
-    json_stream_t s;
-    uint8_t character_buffer[CIRCUITPY_JSON_READ_CHUNK_SIZE];
-    if (stream_p == NULL) {
-        s.start = 0;
-        s.end = 0;
-        mp_load_method(stream_obj, MP_QSTR_readinto, s.python_readinto);
-        s.bytearray_obj.base.type = &mp_type_bytearray;
-        s.bytearray_obj.typecode = BYTEARRAY_TYPECODE;
-        s.bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
-        s.bytearray_obj.free = 0;
-        s.bytearray_obj.items = character_buffer;
-        s.python_readinto[2] = MP_OBJ_FROM_PTR(&s.bytearray_obj);
-        s.stream_obj = &s;
-        s.read = json_python_readinto;
-    } else {
-        stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-        s.stream_obj = stream_obj;
-        s.read = stream_p->read;
-        s.errcode = 0;
-        s.cur = 0;
+// Moves the stream back over what was read ahead.
+static void json_stream_sync(json_stream_t *s) {
+    if (s->read_ahead && s->pos < s->len) {
+        int errcode;
+        if (mp_stream_seek(s->stream_obj, -(mp_off_t)(s->len - s->pos), MP_SEEK_CUR, &errcode) == (mp_off_t)-1) {
+            mp_raise_OSError(errcode);
+        }
     }
+    s->pos = 0;
+    s->len = 0;
+}
 
-    JSON_DEBUG("got JSON stream\n");
-    vstr_t vstr;
-    vstr_init(&vstr, 8);
+static NORETURN void json_syntax_error(json_stream_t *s) {
+    json_stream_sync(s);
+    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+}
+
+// Parses one value, starting with the current character, and leaves the
+// character after it current.
+static mp_obj_t json_parse_value(json_stream_t *s, vstr_t *vstr) {
     mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
     stack.len = 0;
     stack.items = NULL;
     mp_obj_t stack_top = MP_OBJ_NULL;
     const mp_obj_type_t *stack_top_type = NULL;
     mp_obj_t stack_key = MP_OBJ_NULL;
-    S_NEXT(s);
     for (;;) {
     cont:
         if (S_END(s)) {
@@ -266,7 +304,7 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                 }
                 break;
             case '"':
-                vstr_reset(&vstr);
+                vstr_reset(vstr);
                 for (; !S_END(s) && S_CUR(s) != '"';) {
                     byte c = S_CUR(s);
                     if (c == '\\') {
@@ -296,12 +334,12 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                                     }
                                     num = (num << 4) | c;
                                 }
-                                vstr_add_char(&vstr, num);
+                                vstr_add_char(vstr, num);
                                 goto str_cont;
                             }
                         }
                     }
-                    vstr_add_byte(&vstr, c);
+                    vstr_add_byte(vstr, c);
                 str_cont:
                     S_NEXT(s);
                 }
@@ -309,7 +347,7 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                     goto fail;
                 }
                 S_NEXT(s);
-                next = mp_obj_new_str(vstr.buf, vstr.len);
+                next = mp_obj_new_str(vstr->buf, vstr->len);
                 break;
             case '-':
             case '0':
@@ -323,9 +361,9 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
             case '8':
             case '9': {
                 bool flt = false;
-                vstr_reset(&vstr);
+                vstr_reset(vstr);
                 for (;;) {
-                    vstr_add_byte(&vstr, cur);
+                    vstr_add_byte(vstr, cur);
                     cur = S_CUR(s);
                     if (cur == '.' || cur == 'E' || cur == 'e') {
                         flt = true;
@@ -337,9 +375,9 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                     S_NEXT(s);
                 }
                 if (flt) {
-                    next = mp_parse_num_float(vstr.buf, vstr.len, false, NULL);
+                    next = mp_parse_num_float(vstr->buf, vstr->len, false, NULL);
                 } else {
-                    next = mp_parse_num_integer(vstr.buf, vstr.len, 10, NULL);
+                    next = mp_parse_num_integer(vstr->buf, vstr->len, 10, NULL);
                 }
                 break;
             }
@@ -404,7 +442,22 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
         }
     }
 success:
-    // CIRCUITPY-CHANGE
+    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
+        // not exactly 1 object
+        goto fail;
+    }
+    return stack_top;
+
+fail:
+    json_syntax_error(s);
+}
+
+static mp_obj_t _mod_json_load(json_stream_t *s, bool return_first_json) {
+    JSON_DEBUG("got JSON stream\n");
+    vstr_t vstr;
+    vstr_init(&vstr, 8);
+    S_NEXT(s);
+    mp_obj_t value = json_parse_value(s, &vstr);
 
     // It is legal for a stream to have contents after JSON.
     // E.g., A UART is not closed after receiving an object; in load() we will
@@ -416,42 +469,121 @@ success:
         }
         if (!S_END(s)) {
             // unexpected chars
-            goto fail;
+            json_syntax_error(s);
         }
     }
-    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
-        // not exactly 1 object
-        goto fail;
-    }
+    json_stream_sync(s);
     vstr_clear(&vstr);
-    return stack_top;
-
-fail:
-    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+    return value;
 }
 
 // CIRCUITPY-CHANGE
 static mp_obj_t mod_json_load(mp_obj_t stream_obj) {
-    return _mod_json_load(stream_obj, true);
+    json_stream_t s;
+    json_stream_init(&s, stream_obj);
+    return _mod_json_load(&s, true);
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_load_obj, mod_json_load);
 
 static mp_obj_t mod_json_loads(mp_obj_t obj) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(obj, &bufinfo, MP_BUFFER_READ);
-    vstr_t vstr = {bufinfo.len, bufinfo.len, (char *)bufinfo.buf, true};
-    mp_obj_stringio_t sio = {{&mp_type_stringio}, &vstr, 0, MP_OBJ_NULL};
     // CIRCUITPY-CHANGE
-    return _mod_json_load(MP_OBJ_FROM_PTR(&sio), false);
+    json_stream_t s;
+    json_stream_init_buffer(&s, bufinfo.buf, bufinfo.len);
+    return _mod_json_load(&s, false);
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_loads_obj, mod_json_loads);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_JSON_ITERLOAD
+
+// iterload parses one element of the top-level array each time it's asked
+// for the next one, so only that element is ever in memory.
+
+typedef struct _mp_obj_json_iterload_t {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    vstr_t vstr;
+    bool started;
+    bool after_element;
+    bool finished;
+    json_stream_t s;
+} mp_obj_json_iterload_t;
+
+static mp_obj_t json_iterload_iternext(mp_obj_t self_in) {
+    mp_obj_json_iterload_t *self = MP_OBJ_TO_PTR(self_in);
+    json_stream_t *s = &self->s;
+    if (self->finished) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (!self->started) {
+        S_NEXT(s);
+        while (unichar_isspace(S_CUR(s))) {
+            S_NEXT(s);
+        }
+        if (S_CUR(s) != '[') {
+            goto fail;
+        }
+        S_NEXT(s);
+        self->started = true;
+    }
+    while (unichar_isspace(S_CUR(s))) {
+        S_NEXT(s);
+    }
+    if (S_CUR(s) == ']') {
+        // Leave the stream just after the array.
+        self->finished = true;
+        json_stream_sync(s);
+        vstr_clear(&self->vstr);
+        return MP_OBJ_STOP_ITERATION;
+    }
+    // Elements are separated by exactly one comma.
+    if (self->after_element) {
+        if (S_CUR(s) != ',') {
+            goto fail;
+        }
+        S_NEXT(s);
+        while (unichar_isspace(S_CUR(s))) {
+            S_NEXT(s);
+        }
+    }
+    if (S_END(s) || S_CUR(s) == ',' || S_CUR(s) == ']') {
+        goto fail;
+    }
+    mp_obj_t value = json_parse_value(s, &self->vstr);
+    self->after_element = true;
+    return value;
+
+fail:
+    self->finished = true;
+    json_syntax_error(s);
+}
+
+static mp_obj_t mod_json_iterload(mp_obj_t stream_obj) {
+    mp_obj_json_iterload_t *self = mp_obj_malloc(mp_obj_json_iterload_t, &mp_type_polymorph_iter);
+    self->iternext = json_iterload_iternext;
+    vstr_init(&self->vstr, 8);
+    self->started = false;
+    self->after_element = false;
+    self->finished = false;
+    json_stream_init(&self->s, stream_obj);
+    return MP_OBJ_FROM_PTR(self);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_iterload_obj, mod_json_iterload);
+
+#endif
+
 static const mp_rom_map_elem_t mp_module_json_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_json) },
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&mod_json_dump_obj) },
     { MP_ROM_QSTR(MP_QSTR_dumps), MP_ROM_PTR(&mod_json_dumps_obj) },
     { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&mod_json_load_obj) },
     { MP_ROM_QSTR(MP_QSTR_loads), MP_ROM_PTR(&mod_json_loads_obj) },
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_JSON_ITERLOAD
+    { MP_ROM_QSTR(MP_QSTR_iterload), MP_ROM_PTR(&mod_json_iterload_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_json_globals, mp_module_json_globals_table);
@@ -45,8 +45,18 @@
 
 #define FLAG_DEBUG 0x1000
 
+// CIRCUITPY-CHANGE
+// Longest literal prefix that a search looks for before running the matcher.
+#define RE_PREFIX_MAX (8)
+
 typedef struct _mp_obj_re_t {
     mp_obj_base_t base;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_COMPILE_CACHE
+    mp_obj_t pattern;
+    #endif
+    uint8_t prefix_len;
+    char prefix[RE_PREFIX_MAX];
     ByteProg re;
 } mp_obj_re_t;
 
@@ -194,6 +204,52 @@ static void re_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     mp_printf(print, "<re %p>", self);
 }
 
+// CIRCUITPY-CHANGE
+// Runs the program against subj. A search for a pattern that starts with a
+// literal only tries the positions where that literal is found.
+static int re_exec_prog(mp_obj_re_t *self, const Subject *subj, const char **caps, int caps_num, bool is_anchored) {
+    if (is_anchored || self->prefix_len == 0) {
+        return re1_5_recursiveloopprog(&self->re, (Subject *)subj, caps, caps_num, is_anchored);
+    }
+    Subject at = *subj;
+    size_t prefix_len = self->prefix_len;
+    while ((size_t)(at.end - at.begin) >= prefix_len) {
+        const char *p = memchr(at.begin, self->prefix[0], at.end - at.begin - prefix_len + 1);
+        if (p == NULL) {
+            break;
+        }
+        if (memcmp(p + 1, self->prefix + 1, prefix_len - 1) == 0) {
+            at.begin = p;
+            if (re1_5_recursiveloopprog(&self->re, &at, caps, caps_num, true)) {
+                return 1;
+            }
+        }
+        at.begin = p + 1;
+    }
+    return 0;
+}
+
+// CIRCUITPY-CHANGE
+// Returns a new match object if the program matches subj, which is within str,
+// or None. Nothing is allocated on the heap when there is no match.
+static mp_obj_t re_exec_subject(mp_obj_re_t *self, const Subject *subj, mp_obj_t str, bool is_anchored) {
+    int caps_num = (self->re.sub + 1) * 2;
+    const char **caps = mp_local_alloc(caps_num * sizeof(char *));
+    // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
+    memset((char **)caps, 0, caps_num * sizeof(char *));
+    mp_obj_t ret = mp_const_none;
+    if (re_exec_prog(self, subj, caps, caps_num, is_anchored)) {
+        mp_obj_match_t *match = mp_obj_malloc_var(mp_obj_match_t, caps, char *, caps_num, (mp_obj_type_t *)&match_type);
+        memcpy((char **)match->caps, caps, caps_num * sizeof(char *));
+        match->num_matches = caps_num / 2; // caps_num counts start and end pointers
+        match->str = str;
+        ret = MP_OBJ_FROM_PTR(match);
+    }
+    // cast is a workaround for a bug in msvc (see above)
+    mp_local_free((char **)caps);
+    return ret;
+}
+
 // Note: this function can't be named re_exec because it may clash with system headers, eg on FreeBSD
 static mp_obj_t re_exec_helper(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
@@ -238,20 +294,8 @@ static mp_obj_t re_exec_helper(bool is_anchored, uint n_args, const mp_obj_t *ar
         subj.end = (const char *)endpos_ptr;
     }
     #endif
-    int caps_num = (self->re.sub + 1) * 2;
-    mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, caps, char *, caps_num);
-    // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
-    memset((char *)match->caps, 0, caps_num * sizeof(char *));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
-    if (res == 0) {
-        m_del_var(mp_obj_match_t, caps, char *, caps_num, match);
-        return mp_const_none;
-    }
-
-    match->base.type = (mp_obj_type_t *)&match_type;
-    match->num_matches = caps_num / 2; // caps_num counts start and end pointers
-    match->str = args[1];
-    return MP_OBJ_FROM_PTR(match);
+    // CIRCUITPY-CHANGE
+    return re_exec_subject(self, &subj, args[1], is_anchored);
 }
 
 static mp_obj_t re_match(size_t n_args, const mp_obj_t *args) {
@@ -283,7 +327,8 @@ static mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     while (true) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char **)caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        // CIRCUITPY-CHANGE
+        int res = re_exec_prog(self, &subj, caps, caps_num, false);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -343,7 +388,8 @@ static mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     for (;;) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char *)match->caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        // CIRCUITPY-CHANGE
+        int res = re_exec_prog(self, &subj, match->caps, caps_num, false);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -432,6 +478,73 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_sub_obj, 3, 5, re_sub_helper);
 
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_RE_FINDITER
+
+// finditer searches for the next match only when asked for it, so apart from
+// the match objects it returns, iterating allocates nothing.
+
+typedef struct _mp_obj_re_finditer_t {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    mp_obj_re_t *re;
+    mp_obj_t str;
+    // Offset in str where the next search starts.
+    size_t pos;
+} mp_obj_re_finditer_t;
+
+static mp_obj_t re_finditer_iternext(mp_obj_t self_in) {
+    mp_obj_re_finditer_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t len;
+    const char *begin = mp_obj_str_get_data(self->str, &len);
+    if (self->pos > len) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    Subject subj;
+    subj.begin_line = begin;
+    subj.begin = begin + self->pos;
+    subj.end = begin + len;
+    mp_obj_t match_in = re_exec_subject(self->re, &subj, self->str, false);
+    if (match_in == mp_const_none) {
+        self->pos = len + 1;
+        return MP_OBJ_STOP_ITERATION;
+    }
+    mp_obj_match_t *match = MP_OBJ_TO_PTR(match_in);
+    self->pos = match->caps[1] - begin;
+    if (match->caps[0] == match->caps[1]) {
+        // Step past an empty match, by a whole character in a str.
+        self->pos++;
+        #if MICROPY_PY_BUILTINS_STR_UNICODE
+        if (mp_obj_get_type(self->str) == &mp_type_str) {
+            while (self->pos < len && UTF8_IS_CONT(begin[self->pos])) {
+                self->pos++;
+            }
+        }
+        #endif
+    }
+    return match_in;
+}
+
+static mp_obj_t re_finditer(mp_obj_t self_in, mp_obj_t str_in) {
+    mp_obj_re_t *re;
+    if (mp_obj_is_type(self_in, (mp_obj_type_t *)&re_type)) {
+        re = MP_OBJ_TO_PTR(self_in);
+    } else {
+        re = MP_OBJ_TO_PTR(mod_re_compile(1, &self_in));
+    }
+    size_t len;
+    mp_obj_str_get_data(str_in, &len);
+    mp_obj_re_finditer_t *self = mp_obj_malloc(mp_obj_re_finditer_t, &mp_type_polymorph_iter);
+    self->iternext = re_finditer_iternext;
+    self->re = re;
+    self->str = str_in;
+    self->pos = 0;
+    return MP_OBJ_FROM_PTR(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(re_finditer_obj, re_finditer);
+
+#endif
+
 #if !MICROPY_ENABLE_DYNRUNTIME
 static const mp_rom_map_elem_t re_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_match), MP_ROM_PTR(&re_match_obj) },
@@ -440,6 +553,10 @@ static const mp_rom_map_elem_t re_locals_dict_table[] = {
     #if MICROPY_PY_RE_SUB
     { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&re_sub_obj) },
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_FINDITER
+    { MP_ROM_QSTR(MP_QSTR_finditer), MP_ROM_PTR(&re_finditer_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(re_locals_dict, re_locals_dict_table);
@@ -453,8 +570,70 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     );
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_RE_COMPILE_CACHE && !MICROPY_ENABLE_DYNRUNTIME
+
+// Patterns compiled without flags, most recently used first. A program is
+// never changed by running it, so the same one can be shared by every caller.
+MP_REGISTER_ROOT_POINTER(mp_obj_t re_compile_cache[MICROPY_PY_RE_COMPILE_CACHE]);
+
+static mp_obj_t re_cache_lookup(mp_obj_t pattern) {
+    size_t len;
+    const char *str = mp_obj_str_get_data(pattern, &len);
+    mp_obj_t *cache = MP_STATE_VM(re_compile_cache);
+    for (size_t i = 0; i < MICROPY_PY_RE_COMPILE_CACHE && cache[i] != MP_OBJ_NULL; i++) {
+        mp_obj_t hit = cache[i];
+        mp_obj_re_t *o = MP_OBJ_TO_PTR(hit);
+        if (o->pattern != pattern) {
+            size_t o_len;
+            const char *o_str = mp_obj_str_get_data(o->pattern, &o_len);
+            if (o_len != len || memcmp(o_str, str, len) != 0) {
+                continue;
+            }
+        }
+        memmove(&cache[1], &cache[0], i * sizeof(mp_obj_t));
+        cache[0] = hit;
+        return hit;
+    }
+    return MP_OBJ_NULL;
+}
+
+static void re_cache_insert(mp_obj_t re) {
+    mp_obj_t *cache = MP_STATE_VM(re_compile_cache);
+    memmove(&cache[1], &cache[0], (MICROPY_PY_RE_COMPILE_CACHE - 1) * sizeof(mp_obj_t));
+    cache[0] = re;
+}
+
+#endif
+
+// CIRCUITPY-CHANGE
+// Finds the literal bytes that every match starts with: the Char instructions
+// that run before the first branch. Save only records the position, so it is
+// stepped over.
+static void re_find_prefix(mp_obj_re_t *o) {
+    const char *pc = o->re.insts + NON_ANCHORED_PREFIX;
+    o->prefix_len = 0;
+    while (o->prefix_len < RE_PREFIX_MAX) {
+        if (*pc == Char) {
+            o->prefix[o->prefix_len++] = pc[1];
+        } else if (*pc != Save) {
+            break;
+        }
+        pc += 2;
+    }
+}
+
 static mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_COMPILE_CACHE && !MICROPY_ENABLE_DYNRUNTIME
+    if (n_args == 1) {
+        mp_obj_t cached = re_cache_lookup(args[0]);
+        if (cached != MP_OBJ_NULL) {
+            return cached;
+        }
+    }
+    #endif
     const char *re_str = mp_obj_str_get_str(args[0]);
     int size = re1_5_sizecode(re_str);
     if (size == -1) {
@@ -477,6 +656,16 @@ static mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
         re1_5_dumpcode(&o->re);
     }
     #endif
+    // CIRCUITPY-CHANGE
+    re_find_prefix(o);
+    #if MICROPY_PY_RE_COMPILE_CACHE
+    o->pattern = args[0];
+    #if !MICROPY_ENABLE_DYNRUNTIME
+    if (n_args == 1) {
+        re_cache_insert(MP_OBJ_FROM_PTR(o));
+    }
+    #endif
+    #endif
     return MP_OBJ_FROM_PTR(o);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_compile_obj, 1, 2, mod_re_compile);
@@ -490,6 +679,10 @@ static const mp_rom_map_elem_t mp_module_re_globals_table[] = {
     #if MICROPY_PY_RE_SUB
     { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&re_sub_obj) },
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_FINDITER
+    { MP_ROM_QSTR(MP_QSTR_finditer), MP_ROM_PTR(&re_finditer_obj) },
+    #endif
     #if MICROPY_PY_RE_DEBUG
     { MP_ROM_QSTR(MP_QSTR_DEBUG), MP_ROM_INT(FLAG_DEBUG) },
     #endif
@@ -133,6 +133,142 @@ static mp_obj_t mp_vfs_proxy_call(mp_vfs_mount_t *vfs, qstr meth_name, size_t n_
     return mp_call_method_n_kw(n_args, 0, meth);
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_VFS_IMPORT_CACHE
+
+// An import stats each place a module could be: the directory, the .py and the
+// .mpy, in each sys.path entry. On FAT each of those is a scan of the
+// directory. Instead, each directory is listed once into
+// MP_STATE_VM(vfs_import_cache), which maps the mount point followed by the
+// directory to a bytes object. That holds, for each entry, 'd' for a directory,
+// 'f' for a file or '?' if ilistdir didn't say, and the null terminated name.
+// Anything that may change which files exist clears the cache.
+
+void mp_vfs_import_cache_clear(void) {
+    MP_STATE_VM(vfs_import_cache) = MP_OBJ_NULL;
+}
+
+static char import_cache_fold(char c, bool fold_case) {
+    return fold_case ? (char)unichar_tolower((byte)c) : c;
+}
+
+// Returns the listing of dir, or MP_OBJ_NULL if it couldn't be listed.
+static mp_obj_t import_cache_list_dir(mp_vfs_mount_t *vfs, const char *dir, size_t dir_len, bool fold_case) {
+    vstr_t listing;
+    vstr_init(&listing, 64);
+    mp_obj_t dir_obj = mp_obj_new_str(dir, dir_len);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_obj_t iter = mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &dir_obj);
+        mp_obj_t entry;
+        while ((entry = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+            mp_obj_t *items;
+            size_t n_items;
+            mp_obj_get_array(entry, &n_items, &items);
+            size_t name_len;
+            const char *name = mp_obj_str_get_data(items[0], &name_len);
+            mp_int_t mode = n_items > 1 ? mp_obj_get_int(items[1]) : 0;
+            // Links and anything else unusual are left to import_stat.
+            vstr_add_byte(&listing, mode == MP_S_IFDIR ? 'd' : mode == MP_S_IFREG ? 'f' : '?');
+            for (size_t i = 0; i < name_len; i++) {
+                vstr_add_byte(&listing, import_cache_fold(name[i], fold_case));
+            }
+            vstr_add_byte(&listing, '\0');
+        }
+        nlr_pop();
+    } else {
+        vstr_clear(&listing);
+        // A directory that doesn't exist has no entries. Any other error, like
+        // EIO or ENOTDIR, is left to import_stat.
+        mp_obj_base_t *exc = nlr.ret_val;
+        mp_int_t errcode = 0;
+        if (!mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(exc->type), MP_OBJ_FROM_PTR(&mp_type_OSError)) ||
+            !mp_obj_get_int_maybe(mp_obj_exception_get_value(MP_OBJ_FROM_PTR(exc)), &errcode) ||
+            errcode != MP_ENOENT) {
+            return MP_OBJ_NULL;
+        }
+        vstr_init(&listing, 0);
+    }
+    return mp_obj_new_bytes_from_vstr(&listing);
+}
+
+// Looks path up in the cached listing of its directory. Returns false if the
+// listing can't answer, and the path must be stat'ed instead.
+static bool import_cache_stat(mp_vfs_mount_t *vfs, const char *path, mp_import_stat_t *stat) {
+    const char *slash = strrchr(path, '/');
+    const char *name = slash == NULL ? path : slash + 1;
+    size_t dir_len = slash == NULL ? 0 : slash == path ? 1 : (size_t)(slash - path);
+    size_t name_len = strlen(name);
+    if (name_len == 0) {
+        return false;
+    }
+
+    // FAT matches names without regard to case. Only ASCII is folded here, so
+    // leave other names to FAT.
+    bool fold_case = false;
+    #if MICROPY_VFS_FAT
+    if (mp_obj_get_type(vfs->obj) == &mp_fat_vfs_type) {
+        fold_case = true;
+        for (size_t i = 0; i < name_len; i++) {
+            if ((name[i] & 0x80) != 0) {
+                return false;
+            }
+        }
+    }
+    #endif
+
+    if (MP_STATE_VM(vfs_import_cache) == MP_OBJ_NULL) {
+        MP_STATE_VM(vfs_import_cache) = mp_obj_new_dict(0);
+    }
+    mp_obj_dict_t *cache = MP_OBJ_TO_PTR(MP_STATE_VM(vfs_import_cache));
+    vstr_t key;
+    vstr_init(&key, vfs->len + dir_len);
+    vstr_add_strn(&key, vfs->str, vfs->len);
+    vstr_add_strn(&key, path, dir_len);
+    mp_obj_t key_obj = mp_obj_new_str_from_vstr(&key);
+    mp_map_elem_t *elem = mp_map_lookup(&cache->map, key_obj, MP_MAP_LOOKUP);
+    mp_obj_t listing_obj;
+    if (elem != NULL) {
+        listing_obj = elem->value;
+    } else {
+        listing_obj = import_cache_list_dir(vfs, path, dir_len, fold_case);
+        if (listing_obj == MP_OBJ_NULL) {
+            return false;
+        }
+        // Listing may have run code that cleared the cache.
+        if (MP_STATE_VM(vfs_import_cache) != MP_OBJ_FROM_PTR(cache)) {
+            return false;
+        }
+        mp_obj_dict_store(MP_OBJ_FROM_PTR(cache), key_obj, listing_obj);
+    }
+
+    size_t listing_len;
+    const char *entry = mp_obj_str_get_data(listing_obj, &listing_len);
+    const char *end = entry + listing_len;
+    while (entry < end) {
+        const char *entry_name = entry + 1;
+        size_t entry_len = strlen(entry_name);
+        if (entry_len == name_len) {
+            size_t i = 0;
+            while (i < name_len && entry_name[i] == import_cache_fold(name[i], fold_case)) {
+                i++;
+            }
+            if (i == name_len) {
+                if (*entry == '?') {
+                    return false;
+                }
+                *stat = *entry == 'd' ? MP_IMPORT_STAT_DIR : MP_IMPORT_STAT_FILE;
+                return true;
+            }
+        }
+        entry = entry_name + entry_len + 1;
+    }
+    *stat = MP_IMPORT_STAT_NO_EXIST;
+    return true;
+}
+
+#endif
+
 mp_import_stat_t mp_vfs_import_stat(const char *path) {
     const char *path_out;
     mp_vfs_mount_t *vfs = mp_vfs_lookup_path(path, &path_out);
@@ -143,6 +279,13 @@ mp_import_stat_t mp_vfs_import_stat(const char *path) {
     // If the mounted object has the VFS protocol, call its import_stat helper
     const mp_obj_type_t *type = mp_obj_get_type(vfs->obj);
     if (MP_OBJ_TYPE_HAS_SLOT(type, protocol)) {
+        // CIRCUITPY-CHANGE
+        #if MICROPY_VFS_IMPORT_CACHE
+        mp_import_stat_t stat;
+        if (import_cache_stat(vfs, path_out, &stat)) {
+            return stat;
+        }
+        #endif
         const mp_vfs_proto_t *proto = MP_OBJ_TYPE_GET_SLOT(type, protocol);
         return proto->import_stat(MP_OBJ_TO_PTR(vfs->obj), path_out);
     }
@@ -284,6 +427,8 @@ mp_obj_t mp_vfs_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args
         vfsp = &(*vfsp)->next;
     }
     *vfsp = vfs;
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_cache_clear();
 
     return mp_const_none;
 }
@@ -313,6 +458,8 @@ mp_obj_t mp_vfs_umount(mp_obj_t mnt_in) {
     if (MP_STATE_VM(vfs_cur) == vfs) {
         MP_STATE_VM(vfs_cur) = MP_VFS_ROOT;
     }
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_cache_clear();
 
     // call the underlying object to do any unmounting operation
     mp_vfs_proxy_call(vfs, MP_QSTR_umount, 0, NULL);
@@ -343,11 +490,17 @@ mp_obj_t mp_vfs_open(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
     #endif
 
     mp_vfs_mount_t *vfs = lookup_path(args[ARG_file].u_obj, &args[ARG_file].u_obj);
+    // CIRCUITPY-CHANGE
+    if (strpbrk(mp_obj_str_get_str(args[ARG_mode].u_obj), "wax+") != NULL) {
+        mp_vfs_import_cache_clear();
+    }
     return mp_vfs_proxy_call(vfs, MP_QSTR_open, 2, (mp_obj_t *)&args);
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mp_vfs_open_obj, 0, mp_vfs_open);
 
 mp_obj_t mp_vfs_chdir(mp_obj_t path_in) {
+    // CIRCUITPY-CHANGE: relative paths are cached too
+    mp_vfs_import_cache_clear();
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
     if (vfs == MP_VFS_ROOT) {
@@ -477,6 +630,8 @@ mp_obj_t mp_vfs_mkdir(mp_obj_t path_in) {
     if (vfs == MP_VFS_ROOT || (vfs != MP_VFS_NONE && !strcmp(mp_obj_str_get_str(path_out), "/"))) {
         mp_raise_OSError(MP_EEXIST);
     }
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_cache_clear();
     return mp_vfs_proxy_call(vfs, MP_QSTR_mkdir, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_mkdir_obj, mp_vfs_mkdir);
@@ -484,6 +639,8 @@ MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_mkdir_obj, mp_vfs_mkdir);
 mp_obj_t mp_vfs_remove(mp_obj_t path_in) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_cache_clear();
     return mp_vfs_proxy_call(vfs, MP_QSTR_remove, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_remove_obj, mp_vfs_remove);
@@ -496,6 +653,8 @@ mp_obj_t mp_vfs_rename(mp_obj_t old_path_in, mp_obj_t new_path_in) {
         // can't rename across filesystems
         mp_raise_OSError(MP_EPERM);
     }
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_cache_clear();
     return mp_vfs_proxy_call(old_vfs, MP_QSTR_rename, 2, args);
 }
 MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_rename_obj, mp_vfs_rename);
@@ -503,6 +662,8 @@ MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_rename_obj, mp_vfs_rename);
 mp_obj_t mp_vfs_rmdir(mp_obj_t path_in) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
+    // CIRCUITPY-CHANGE
+    mp_vfs_import_cache_clear();
     return mp_vfs_proxy_call(vfs, MP_QSTR_rmdir, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_rmdir_obj, mp_vfs_rmdir);
@@ -606,5 +767,9 @@ int mp_vfs_mount_romfs_protected(void) {
 
 MP_REGISTER_ROOT_POINTER(struct _mp_vfs_mount_t *vfs_cur);
 MP_REGISTER_ROOT_POINTER(struct _mp_vfs_mount_t *vfs_mount_table);
+// CIRCUITPY-CHANGE
+#if MICROPY_VFS_IMPORT_CACHE
+MP_REGISTER_ROOT_POINTER(mp_obj_t vfs_import_cache);
+#endif
 
 #endif // MICROPY_VFS
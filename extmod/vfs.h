@@ -52,6 +52,8 @@
 #define MP_BLOCKDEV_FLAG_CONCURRENT_WRITE_PROTECTED (0x0020)
 // Bit set when something has claimed the right to mutate the blockdev.
 #define MP_BLOCKDEV_FLAG_LOCKED (0x0040)
+// Bit set when the VM references blocks in place, and holds the lock until it ends.
+#define MP_BLOCKDEV_FLAG_MAPPED (0x0080)
 
 // constants for block protocol ioctl
 #define MP_BLOCKDEV_IOCTL_INIT          (1)
@@ -60,6 +62,12 @@
 #define MP_BLOCKDEV_IOCTL_BLOCK_COUNT   (4)
 #define MP_BLOCKDEV_IOCTL_BLOCK_SIZE    (5)
 #define MP_BLOCKDEV_IOCTL_BLOCK_ERASE   (6)
+// CIRCUITPY-CHANGE: Only asked of native block devices. MEMMAP gives the
+// address of block arg if it can be read directly. Once the addresses of all
+// the blocks needed are known, MEMMAP_LOCK keeps the device from changing
+// until soft reset, or fails if it can't.
+#define MP_BLOCKDEV_IOCTL_MEMMAP        (0x100)
+#define MP_BLOCKDEV_IOCTL_MEMMAP_LOCK   (0x101)
 
 // Constants for vfs.rom_ioctl() function.
 #define MP_VFS_ROM_IOCTL_GET_NUMBER_OF_SEGMENTS     (1) // rom_ioctl(1)
@@ -107,6 +115,10 @@ int mp_vfs_blockdev_read_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t b
 int mp_vfs_blockdev_write(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, const uint8_t *buf);
 int mp_vfs_blockdev_write_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t block_off, size_t len, const uint8_t *buf);
 mp_obj_t mp_vfs_blockdev_ioctl(mp_vfs_blockdev_t *self, uintptr_t cmd, uintptr_t arg);
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+const uint8_t *mp_vfs_blockdev_memmap(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks);
+#endif
 
 mp_vfs_mount_t *mp_vfs_lookup_path(const char *path, const char **path_out);
 mp_import_stat_t mp_vfs_import_stat(const char *path);
@@ -126,6 +138,16 @@ mp_obj_t mp_vfs_rmdir(mp_obj_t path_in);
 mp_obj_t mp_vfs_stat(mp_obj_t path_in);
 mp_obj_t mp_vfs_statvfs(mp_obj_t path_in);
 
+// CIRCUITPY-CHANGE
+// Forget the directory listings kept for import. Call this after anything that
+// may change which files exist, other than the mp_vfs_ functions above.
+#if MICROPY_VFS_IMPORT_CACHE
+void mp_vfs_import_cache_clear(void);
+#else
+static inline void mp_vfs_import_cache_clear(void) {
+}
+#endif
+
 int mp_vfs_mount_and_chdir_protected(mp_obj_t bdev, mp_obj_t mount_point);
 #if MICROPY_VFS_ROM && MICROPY_VFS_ROM_IOCTL
 int mp_vfs_mount_romfs_protected(void);
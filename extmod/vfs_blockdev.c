@@ -183,4 +183,27 @@ mp_obj_t mp_vfs_blockdev_ioctl(mp_vfs_blockdev_t *self, uintptr_t cmd, uintptr_t
     }
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+// Returns where the given blocks can be read directly, or NULL if they can't.
+const uint8_t *mp_vfs_blockdev_memmap(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks) {
+    if ((self->flags & (MP_BLOCKDEV_FLAG_NATIVE | MP_BLOCKDEV_FLAG_HAVE_IOCTL)) != (MP_BLOCKDEV_FLAG_NATIVE | MP_BLOCKDEV_FLAG_HAVE_IOCTL)
+        || num_blocks == 0) {
+        return NULL;
+    }
+    bool (*f)(mp_obj_t self, uint32_t, uint32_t, size_t *) = (void *)(uintptr_t)self->u.ioctl[2];
+    size_t first;
+    size_t last;
+    size_t unused;
+    // Only lock the device once the blocks are known to be mapped in one run.
+    if (!f(self->u.ioctl[1], MP_BLOCKDEV_IOCTL_MEMMAP, block_num, &first) || first == 0
+        || !f(self->u.ioctl[1], MP_BLOCKDEV_IOCTL_MEMMAP, block_num + num_blocks - 1, &last)
+        || last != first + (num_blocks - 1) * self->block_size
+        || !f(self->u.ioctl[1], MP_BLOCKDEV_IOCTL_MEMMAP_LOCK, 0, &unused)) {
+        return NULL;
+    }
+    return (const uint8_t *)first;
+}
+#endif
+
 #endif // MICROPY_VFS
@@ -53,4 +53,9 @@ typedef struct _pyb_file_obj_t {
     FIL fp;
 } pyb_file_obj_t;
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+const uint8_t *mp_vfs_fat_file_memmap(mp_obj_t self_in, size_t *len);
+#endif
+
 #endif  // MICROPY_INCLUDED_EXTMOD_VFS_FAT_H
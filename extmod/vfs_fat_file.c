@@ -143,6 +143,28 @@ static mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
     }
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+// Returns where the whole of a file opened for reading can be read in place,
+// or NULL if it can't. It can when the file is in one run of clusters, on a
+// block device that can map them. Mapping locks the block device until the VM
+// ends, so this is only used to import .mpy files.
+const uint8_t *mp_vfs_fat_file_memmap(mp_obj_t self_in, size_t *len) {
+    pyb_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    FATFS *fatfs = self->fp.obj.fs;
+    // The fast seek table made by open has one fragment when the clusters
+    // follow each other: the table size, the cluster count, the first
+    // cluster and a terminating 0.
+    if (fatfs == NULL || (self->fp.flag & FA_WRITE) || self->fp.cltbl == NULL || self->fp.cltbl[0] != 4) {
+        return NULL;
+    }
+    fs_user_mount_t *vfs = fatfs->drv;
+    DWORD block_num = fatfs->database + fatfs->csize * (self->fp.cltbl[2] - 2);
+    *len = f_size(&self->fp);
+    return mp_vfs_blockdev_memmap(&vfs->blockdev, block_num, (*len + vfs->blockdev.block_size - 1) / vfs->blockdev.block_size);
+}
+#endif
+
 // TODO gc hook to close the file if not already closed
 
 static const mp_rom_map_elem_t vfs_fat_rawfile_locals_dict_table[] = {
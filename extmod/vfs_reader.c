@@ -32,6 +32,10 @@
 #include "py/stream.h"
 #include "py/reader.h"
 #include "extmod/vfs.h"
+// CIRCUITPY-CHANGE
+#if MICROPY_VFS_FAT
+#include "extmod/vfs_fat.h"
+#endif
 
 #if MICROPY_READER_VFS
 
@@ -76,13 +80,9 @@ static void mp_reader_vfs_close(void *data) {
     m_del_obj(mp_reader_vfs_t, reader);
 }
 
-void mp_reader_new_file(mp_reader_t *reader, qstr filename) {
-    mp_obj_t args[2] = {
-        MP_OBJ_NEW_QSTR(filename),
-        MP_OBJ_NEW_QSTR(MP_QSTR_rb),
-    };
-    mp_obj_t file = mp_vfs_open(MP_ARRAY_SIZE(args), &args[0], (mp_map_t *)&mp_const_empty_map);
-
+// CIRCUITPY-CHANGE: split out of mp_reader_new_file so that
+// mp_reader_new_file_in_place can open the file first.
+static void mp_reader_new_vfs_file(mp_reader_t *reader, mp_obj_t file) {
     const mp_stream_p_t *stream_p = mp_get_stream(file);
     int errcode = 0;
 
@@ -119,4 +119,36 @@ void mp_reader_new_file(mp_reader_t *reader, qstr filename) {
     reader->close = mp_reader_vfs_close;
 }
 
+static mp_obj_t mp_reader_open_file(qstr filename) {
+    mp_obj_t args[2] = {
+        MP_OBJ_NEW_QSTR(filename),
+        MP_OBJ_NEW_QSTR(MP_QSTR_rb),
+    };
+    return mp_vfs_open(MP_ARRAY_SIZE(args), &args[0], (mp_map_t *)&mp_const_empty_map);
+}
+
+void mp_reader_new_file(mp_reader_t *reader, qstr filename) {
+    mp_reader_new_vfs_file(reader, mp_reader_open_file(filename));
+}
+
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+void mp_reader_new_file_in_place(mp_reader_t *reader, qstr filename) {
+    mp_obj_t file = mp_reader_open_file(filename);
+    #if MICROPY_VFS_FAT
+    if (mp_obj_is_type(file, &mp_type_vfs_fat_fileio)) {
+        size_t len;
+        const uint8_t *data = mp_vfs_fat_file_memmap(file, &len);
+        if (data != NULL) {
+            mp_reader_new_mem(reader, data, len, MP_READER_IS_ROM);
+            // The mapping outlives the file.
+            mp_stream_close(file);
+            return;
+        }
+    }
+    #endif
+    mp_reader_new_vfs_file(reader, file);
+}
+#endif
+
 #endif // MICROPY_READER_VFS
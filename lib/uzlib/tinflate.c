@@ -546,6 +546,7 @@ void uzlib_uncompress_init(TINF_DATA *d, void *dict, unsigned int dictLen)
    d->dict_ring = dict;
    d->dict_idx = 0;
    d->curlen = 0;
+   d->blocks = 0;
 }
 
 /* inflate next output bytes from compressed stream */
@@ -557,6 +558,14 @@ int uzlib_uncompress(TINF_DATA *d)
         /* start a new block */
         if (d->btype == -1) {
 next_blk:
+            d->blocks++;
+            d->block_source = d->source;
+            d->block_source_limit = d->source_limit;
+            d->block_dest = d->dest;
+            d->block_dict_idx = d->dict_idx;
+            d->block_tag = d->tag;
+            d->block_bitcount = d->bitcount;
+
             /* read final block flag */
             d->bfinal = tinf_getbit(d);
             /* read block type (2 bits) */
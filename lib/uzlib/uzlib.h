@@ -119,6 +119,17 @@ struct uzlib_uncomp {
     unsigned int dict_size;
     unsigned int dict_idx;
 
+    /* Where the most recent block started, and how many blocks have been
+       started. A caller that runs out of input part way through a block can
+       go back to its start, where the trees are decoded again. */
+    unsigned int blocks;
+    const unsigned char *block_source;
+    const unsigned char *block_source_limit;
+    unsigned char *block_dest;
+    unsigned int block_dict_idx;
+    unsigned int block_tag;
+    unsigned int block_bitcount;
+
     TINF_TREE ltree; /* dynamic length/symbol tree */
     TINF_TREE dtree; /* dynamic distance tree */
 };
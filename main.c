@@ -402,6 +402,8 @@ static void cleanup_after_vm(mp_obj_t exception) {
     // Free the heap last because other modules may reference heap memory and need to shut down.
     filesystem_flush();
     stop_mp();
+    // Nothing references mapped .mpy files any more.
+    filesystem_release_mapped();
 
     // Let the workflows know we've reset in case they want to restart.
     supervisor_workflow_reset();
@@ -868,8 +870,11 @@ static void __attribute__ ((noinline)) run_boot_py(safe_mode_t safe_mode) {
         port_boot_info();
         #endif
 
+        // boot.py may remount CIRCUITPY, which can't be done while imports are mapped from it.
+        filesystem_set_mapping_allowed(false);
         bool found_boot = maybe_run_list(boot_py_filenames, MP_ARRAY_SIZE(boot_py_filenames));
         (void)found_boot;
+        filesystem_set_mapping_allowed(true);
 
 
         #ifdef CIRCUITPY_BOOT_OUTPUT_FILE
@@ -100,6 +100,14 @@ static bool supervisor_flash_write_block(const uint8_t *src, uint32_t block) {
     return true;
 }
 
+const uint8_t *supervisor_flash_get_mapped_address(uint32_t block_num) {
+    int32_t addr = convert_block_to_flash_addr(block_num);
+    if (addr == -1) {
+        return NULL;
+    }
+    return (const uint8_t *)addr;
+}
+
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
     for (size_t i = 0; i < num_blocks; i++) {
         if (!supervisor_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
@@ -49,7 +49,8 @@ void common_hal_paralleldisplaybus_parallelbus_construct_nonsequential(paralleld
     self->config.wr_gpio_num = common_hal_mcu_pin_number(write);   // write strobe
     self->config.clk_src = LCD_CLK_SRC_DEFAULT;
     self->config.bus_width = n_pins;
-    self->config.max_transfer_bytes = 512;
+    // BusDisplay sends at least one row of the display at a time.
+    self->config.max_transfer_bytes = MAX(4096, CIRCUITPY_BUSDISPLAY_AREA_BUFFER_SIZE);
     for (uint8_t i = 0; i < n_pins; i++) {
         self->config.data_gpio_nums[i] = common_hal_mcu_pin_number(data_pins[i]);
     }
@@ -58,7 +59,7 @@ void common_hal_paralleldisplaybus_parallelbus_construct_nonsequential(paralleld
     esp_lcd_panel_io_i80_config_t panel_io_config = {
         .cs_gpio_num = -1, // We manage CS
         .pclk_hz = frequency,
-        .trans_queue_depth = 1, // We block anyway
+        .trans_queue_depth = 1, // At most one color transfer is in flight
         .on_color_trans_done = _transfer_done,
         .user_ctx = self,
         .lcd_cmd_bits = 8,
@@ -68,6 +69,7 @@ void common_hal_paralleldisplaybus_parallelbus_construct_nonsequential(paralleld
     panel_io_config.dc_levels.dc_data_level = 1;
     panel_io_config.dc_levels.dc_idle_level = 1;
     CHECK_ESP_RESULT(esp_lcd_new_panel_io_i80(self->bus_handle, &panel_io_config, &self->panel_io_handle));
+    self->transfer_done = true;
 
     if (read != NULL) {
         common_hal_never_reset_pin(read);
@@ -169,20 +171,39 @@ bool common_hal_paralleldisplaybus_parallelbus_begin_transaction(mp_obj_t obj) {
 }
 
 
+static void _wait_for_transfer(paralleldisplaybus_parallelbus_obj_t *self) {
+    while (!self->transfer_done) {
+        RUN_BACKGROUND_TASKS;
+    }
+}
+
+void common_hal_paralleldisplaybus_parallelbus_send_async(mp_obj_t obj, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    paralleldisplaybus_parallelbus_obj_t *self = MP_OBJ_TO_PTR(obj);
+    if (byte_type != DISPLAY_DATA || data_length == 0) {
+        common_hal_paralleldisplaybus_parallelbus_send(obj, byte_type, chip_select, data, data_length);
+        return;
+    }
+    _wait_for_transfer(self);
+    // The DMA reads straight from data. end_transaction waits for it to finish.
+    self->transfer_done = false;
+    CHECK_ESP_RESULT(esp_lcd_panel_io_tx_color(self->panel_io_handle, -1, data, data_length));
+}
+
 void common_hal_paralleldisplaybus_parallelbus_send(mp_obj_t obj, display_byte_type_t byte_type,
     display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
     paralleldisplaybus_parallelbus_obj_t *self = MP_OBJ_TO_PTR(obj);
     if (data_length == 0) {
         return;
     }
+    // Everything goes out in order, after any data that is still being sent.
+    _wait_for_transfer(self);
     if (byte_type == DISPLAY_DATA) {
         // We don't use the color transmit function because this buffer will be small-ish. displayio
         // will already partition it into small pieces.
         self->transfer_done = false;
         CHECK_ESP_RESULT(esp_lcd_panel_io_tx_color(self->panel_io_handle, -1, data, data_length));
-        while (!self->transfer_done) {
-            RUN_BACKGROUND_TASKS;
-        }
+        _wait_for_transfer(self);
     } else if (data_length == 1) {
         CHECK_ESP_RESULT(esp_lcd_panel_io_tx_param(self->panel_io_handle, data[0], NULL, 0));
     } else {
@@ -192,5 +213,6 @@ void common_hal_paralleldisplaybus_parallelbus_send(mp_obj_t obj, display_byte_t
 
 void common_hal_paralleldisplaybus_parallelbus_end_transaction(mp_obj_t obj) {
     paralleldisplaybus_parallelbus_obj_t *self = MP_OBJ_TO_PTR(obj);
+    _wait_for_transfer(self);
     gpio_set_level(self->cs_pin_number, true);
 }
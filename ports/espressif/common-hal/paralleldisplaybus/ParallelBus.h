@@ -18,5 +18,6 @@ typedef struct {
     esp_lcd_i80_bus_config_t config;
     esp_lcd_i80_bus_handle_t bus_handle;
     esp_lcd_panel_io_handle_t panel_io_handle;
-    bool transfer_done;
+    // Set from the DMA done interrupt.
+    volatile bool transfer_done;
 } paralleldisplaybus_parallelbus_obj_t;
@@ -16,6 +16,7 @@
 #define MICROPY_PY_SYS_PLATFORM             "Espressif"
 
 #define CIRCUITPY_DIGITALIO_HAVE_INPUT_ONLY (1)
+#define CIRCUITPY_PARALLELDISPLAYBUS_HAVE_SEND_ASYNC (1)
 
 #include "py/circuitpy_mpconfig.h"
 
@@ -0,0 +1,15 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+// The unix port has no pins. This lets the display code, which takes an optional backlight pin,
+// build for the coverage tests.
+typedef struct {
+    mp_obj_base_t base;
+} mcu_pin_obj_t;
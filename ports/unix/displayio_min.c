@@ -4,7 +4,10 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <string.h>
+
 #include "py/enum.h"
+#include "py/mphal.h"
 #include "py/obj.h"
 #include "py/runtime.h"
 
@@ -12,6 +15,16 @@
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/displayio/Palette.h"
+#if CIRCUITPY_BUSDISPLAY
+#include "shared-bindings/displayio/Group.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-bindings/digitalio/DigitalInOut.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/time/__init__.h"
+#include "shared-module/displayio/__init__.h"
+#include "supervisor/shared/display.h"
+#include "supervisor/shared/tick.h"
+#endif
 
 MAKE_ENUM_VALUE(displayio_colorspace_type, displayio_colorspace, RGB888, DISPLAYIO_COLORSPACE_RGB888);
 MAKE_ENUM_VALUE(displayio_colorspace_type, displayio_colorspace, RGB565, DISPLAYIO_COLORSPACE_RGB565);
@@ -59,12 +72,135 @@ static MP_DEFINE_CONST_DICT(displayio_colorspace_locals_dict, displayio_colorspa
 MAKE_PRINTER(displayio, displayio_colorspace);
 MAKE_ENUM_TYPE(displayio, ColorSpace, displayio_colorspace);
 
+#if CIRCUITPY_BUSDISPLAY
+// Only BusDisplay is built, so this keeps just enough of the display registry for it. There is no
+// terminal and nothing refreshes in the background; tests call refresh() themselves.
+
+primary_display_t displays[CIRCUITPY_DISPLAY_LIMIT];
+
+static mp_obj_t splash_children_items[0];
+static mp_obj_list_t splash_children = {
+    .base = {.type = &mp_type_list },
+    .alloc = 0,
+    .len = 0,
+    .items = splash_children_items,
+};
+
+displayio_group_t circuitpython_splash = {
+    .base = {.type = &displayio_group_type },
+    .x = 0,
+    .y = 0,
+    .scale = 1,
+    .members = &splash_children,
+    .item_removed = false,
+    .in_group = false,
+    .hidden = false,
+    .hidden_by_parent = false,
+    .readonly = true,
+};
+
+void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
+}
+
+void supervisor_stop_terminal(void) {
+}
+
+// The unix port doesn't build the supervisor, whose tick code needs a port tick source and the
+// background callback queue. BusDisplay only uses it to time refreshes and init sequence delays, and
+// the host clock does that.
+uint64_t supervisor_ticks_ms64(void) {
+    return mp_hal_ticks_ms();
+}
+
+void supervisor_enable_tick(void) {
+}
+
+void supervisor_disable_tick(void) {
+}
+
+void common_hal_time_delay_ms(uint32_t delay) {
+    mp_hal_delay_ms(delay);
+}
+
+// The unix port has no pins, and so no microcontroller or digitalio modules. BusDisplay only uses
+// them for its optional backlight pin, so these just reject any pin and leave the backlight unset.
+const mcu_pin_obj_t *validate_obj_is_free_pin_or_none(mp_obj_t obj, qstr arg_name) {
+    if (obj != mp_const_none) {
+        raise_ValueError_invalid_pin();
+    }
+    return NULL;
+}
+
+NORETURN void raise_ValueError_invalid_pin(void) {
+    mp_arg_error_invalid(MP_QSTR_pin);
+}
+
+bool common_hal_mcu_pin_is_free(const mcu_pin_obj_t *pin) {
+    return false;
+}
+
+void common_hal_never_reset_pin(const mcu_pin_obj_t *pin) {
+}
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    digitalio_digitalinout_type,
+    MP_QSTR_DigitalInOut,
+    MP_TYPE_FLAG_NONE
+    );
+
+digitalinout_result_t common_hal_digitalio_digitalinout_construct(digitalio_digitalinout_obj_t *self, const mcu_pin_obj_t *pin) {
+    return DIGITALINOUT_PIN_BUSY;
+}
+
+void common_hal_digitalio_digitalinout_deinit(digitalio_digitalinout_obj_t *self) {
+}
+
+void common_hal_digitalio_digitalinout_set_value(digitalio_digitalinout_obj_t *self, bool value) {
+}
+
+primary_display_t *allocate_display_or_raise(void) {
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        mp_const_obj_t display_type = displays[i].display_base.type;
+        if (display_type == NULL || display_type == &mp_type_NoneType) {
+            memset(&displays[i], 0, sizeof(displays[i]));
+            displays[i].display_base.type = &mp_type_NoneType;
+            return &displays[i];
+        }
+    }
+    mp_raise_RuntimeError(MP_ERROR_TEXT("Too many displays"));
+}
+
+void displayio_gc_collect(void) {
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        if (displays[i].display_base.type == &busdisplay_busdisplay_type) {
+            busdisplay_busdisplay_collect_ptrs(&displays[i].display);
+        }
+    }
+}
+
+static mp_obj_t displayio_release_displays(void) {
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        if (displays[i].display_base.type == &busdisplay_busdisplay_type) {
+            release_busdisplay(&displays[i].display);
+        }
+        displays[i].display_base.type = &mp_type_NoneType;
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(displayio_release_displays_obj, displayio_release_displays);
+#endif
+
 static const mp_rom_map_elem_t displayio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_displayio) },
     { MP_ROM_QSTR(MP_QSTR_Bitmap), MP_ROM_PTR(&displayio_bitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_Colorspace), MP_ROM_PTR(&displayio_colorspace_type) },
     { MP_ROM_QSTR(MP_QSTR_ColorConverter), MP_ROM_PTR(&displayio_colorconverter_type) },
     { MP_ROM_QSTR(MP_QSTR_Palette), MP_ROM_PTR(&displayio_palette_type) },
+    #if CIRCUITPY_BUSDISPLAY
+    { MP_ROM_QSTR(MP_QSTR_Group), MP_ROM_PTR(&displayio_group_type) },
+    { MP_ROM_QSTR(MP_QSTR_TileGrid), MP_ROM_PTR(&displayio_tilegrid_type) },
+    { MP_ROM_QSTR(MP_QSTR_release_displays), MP_ROM_PTR(&displayio_release_displays_obj) },
+    #endif
 };
 static MP_DEFINE_CONST_DICT(displayio_module_globals, displayio_module_globals_table);
 
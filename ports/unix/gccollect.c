@@ -31,6 +31,11 @@
 
 #include "shared/runtime/gchelper.h"
 
+// CIRCUITPY-CHANGE: displays live outside the heap.
+#if CIRCUITPY_BUSDISPLAY
+#include "shared-module/displayio/__init__.h"
+#endif
+
 #if MICROPY_ENABLE_GC
 
 void gc_collect(void) {
@@ -39,6 +44,9 @@ void gc_collect(void) {
     #if MICROPY_PY_THREAD
     mp_thread_gc_others();
     #endif
+    #if CIRCUITPY_BUSDISPLAY
+    displayio_gc_collect();
+    #endif
     gc_collect_end();
 }
 
@@ -645,6 +645,16 @@ MP_NOINLINE int main_(int argc, char **argv) {
         // CIRCUITPY-CHANGE: test native base classes work as needed by CircuitPython libraries.
         extern const mp_obj_type_t native_base_class_type;
         mp_store_global(MP_QSTR_NativeBaseClass, MP_OBJ_FROM_PTR(&native_base_class_type));
+        #if CIRCUITPY_BUSDISPLAY
+        // CIRCUITPY-CHANGE: a display bus to test BusDisplay with.
+        extern const mp_obj_type_t simulated_display_bus_type;
+        mp_store_global(MP_QSTR_SimulatedDisplayBus, MP_OBJ_FROM_PTR(&simulated_display_bus_type));
+        #endif
+        #if MICROPY_VFS_FAT
+        // CIRCUITPY-CHANGE: a block device to test mapped .mpy imports with.
+        extern const mp_obj_type_t simulated_flash_type;
+        mp_store_global(MP_QSTR_SimulatedFlash, MP_OBJ_FROM_PTR(&simulated_flash_type));
+        #endif
         mp_store_global(MP_QSTR_getenv_int, MP_OBJ_FROM_PTR(&mod_os_getenv_int_obj));
         mp_store_global(MP_QSTR_getenv_str, MP_OBJ_FROM_PTR(&mod_os_getenv_str_obj));
     }
@@ -160,6 +160,9 @@ typedef long mp_off_t;
 #define MICROPY_FATFS_MKFS_FAT32       (1)
 // CIRCUITPY-CHANGE: allow FAT label access
 #define MICROPY_FATFS_USE_LABEL (1)
+// CIRCUITPY-CHANGE: the shared bindings that take an open file, such as OnDiskBitmap, expect a FAT
+// file, as on the boards.
+#define mp_type_fileio mp_type_vfs_fat_fileio
 
 #define MICROPY_ALLOC_PATH_MAX      (PATH_MAX)
 
@@ -0,0 +1,197 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "simulated_display_bus.h"
+
+#include "py/gc.h"
+#include "py/objarray.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+#if CIRCUITPY_BUSDISPLAY
+
+#define CASET (0x2a)
+#define RASET (0x2b)
+#define RAMWR (0x2c)
+
+static void write_pixel_byte(simulated_display_bus_obj_t *self, uint8_t value) {
+    if (self->x >= self->width || self->y >= self->height) {
+        return;
+    }
+    mp_obj_array_t *framebuffer = MP_OBJ_TO_PTR(self->framebuffer);
+    uint8_t *pixel = (uint8_t *)framebuffer->items + 2 * (self->y * self->width + self->x);
+    pixel[self->high_byte_sent ? 1 : 0] = value;
+    if (!self->high_byte_sent) {
+        self->high_byte_sent = true;
+        return;
+    }
+    self->high_byte_sent = false;
+    self->x++;
+    if (self->x > self->window[1]) {
+        self->x = self->window[0];
+        self->y++;
+    }
+}
+
+static void receive(simulated_display_bus_obj_t *self, display_byte_type_t byte_type,
+    const uint8_t *data, uint32_t data_length) {
+    for (uint32_t i = 0; i < data_length; i++) {
+        if (byte_type == DISPLAY_COMMAND) {
+            self->command = data[i];
+            self->parameter_count = 0;
+            self->high_byte_sent = false;
+            if (self->command == RAMWR) {
+                self->ram_writes++;
+                self->x = self->window[0];
+                self->y = self->window[2];
+            }
+        } else if (self->command == RAMWR) {
+            write_pixel_byte(self, data[i]);
+        } else if ((self->command == CASET || self->command == RASET) && self->parameter_count < 4) {
+            self->parameters[self->parameter_count++] = data[i];
+            if (self->parameter_count == 4) {
+                uint16_t *bounds = self->window + (self->command == CASET ? 0 : 2);
+                bounds[0] = self->parameters[0] << 8 | self->parameters[1];
+                bounds[1] = self->parameters[2] << 8 | self->parameters[3];
+            }
+        }
+    }
+}
+
+static void finish_pending(simulated_display_bus_obj_t *self) {
+    if (self->pending != NULL) {
+        receive(self, DISPLAY_DATA, self->pending, self->pending_length);
+        self->pending = NULL;
+        self->pending_length = 0;
+    }
+}
+
+bool simulated_display_bus_reset(mp_obj_t self_in) {
+    return false;
+}
+
+bool simulated_display_bus_bus_free(mp_obj_t self_in) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return !self->in_transaction;
+}
+
+bool simulated_display_bus_begin_transaction(mp_obj_t self_in) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->in_transaction) {
+        return false;
+    }
+    self->in_transaction = true;
+    return true;
+}
+
+void simulated_display_bus_send(mp_obj_t self_in, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    // Like a real bus, a blocking send goes after anything still in flight.
+    finish_pending(self);
+    receive(self, byte_type, data, data_length);
+}
+
+void simulated_display_bus_send_async(mp_obj_t self_in, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    finish_pending(self);
+    self->pending = data;
+    self->pending_length = data_length;
+    self->async_sends++;
+}
+
+void simulated_display_bus_end_transaction(mp_obj_t self_in) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    finish_pending(self);
+    self->in_transaction = false;
+}
+
+void simulated_display_bus_collect_ptrs(mp_obj_t self_in) {
+    gc_collect_ptr(MP_OBJ_TO_PTR(self_in));
+}
+
+// SimulatedDisplayBus(width, height, *, asynchronous=True)
+static mp_obj_t simulated_display_bus_make_new(const mp_obj_type_t *type, size_t n_args,
+    size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_asynchronous };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_asynchronous, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t width = mp_arg_validate_int_range(args[ARG_width].u_int, 1, 0xffff, MP_QSTR_width);
+    mp_int_t height = mp_arg_validate_int_range(args[ARG_height].u_int, 1, 0xffff, MP_QSTR_height);
+
+    simulated_display_bus_obj_t *self = mp_obj_malloc(simulated_display_bus_obj_t, type);
+    self->framebuffer = mp_obj_new_bytearray_of_zeros(width * height * 2);
+    self->pending = NULL;
+    self->pending_length = 0;
+    self->async_sends = 0;
+    self->ram_writes = 0;
+    self->width = width;
+    self->height = height;
+    self->window[0] = 0;
+    self->window[1] = width - 1;
+    self->window[2] = 0;
+    self->window[3] = height - 1;
+    self->command = 0;
+    self->parameter_count = 0;
+    self->high_byte_sent = false;
+    self->asynchronous = args[ARG_asynchronous].u_bool;
+    self->in_transaction = false;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// The pixels received so far, two bytes per pixel in the order they were sent.
+static mp_obj_t simulated_display_bus_get_framebuffer(mp_obj_t self_in) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return self->framebuffer;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(simulated_display_bus_get_framebuffer_obj, simulated_display_bus_get_framebuffer);
+
+MP_PROPERTY_GETTER(simulated_display_bus_framebuffer_obj,
+    (mp_obj_t)&simulated_display_bus_get_framebuffer_obj);
+
+// How many sends returned before their data was used.
+static mp_obj_t simulated_display_bus_get_async_sends(mp_obj_t self_in) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(self->async_sends);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(simulated_display_bus_get_async_sends_obj, simulated_display_bus_get_async_sends);
+
+MP_PROPERTY_GETTER(simulated_display_bus_async_sends_obj,
+    (mp_obj_t)&simulated_display_bus_get_async_sends_obj);
+
+// How many RAM writes were started, one for each region of pixels sent.
+static mp_obj_t simulated_display_bus_get_ram_writes(mp_obj_t self_in) {
+    simulated_display_bus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(self->ram_writes);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(simulated_display_bus_get_ram_writes_obj, simulated_display_bus_get_ram_writes);
+
+MP_PROPERTY_GETTER(simulated_display_bus_ram_writes_obj,
+    (mp_obj_t)&simulated_display_bus_get_ram_writes_obj);
+
+static const mp_rom_map_elem_t simulated_display_bus_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&simulated_display_bus_framebuffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_async_sends), MP_ROM_PTR(&simulated_display_bus_async_sends_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ram_writes), MP_ROM_PTR(&simulated_display_bus_ram_writes_obj) },
+};
+static MP_DEFINE_CONST_DICT(simulated_display_bus_locals_dict, simulated_display_bus_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    simulated_display_bus_type,
+    MP_QSTR_SimulatedDisplayBus,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, simulated_display_bus_make_new,
+    locals_dict, &simulated_display_bus_locals_dict
+    );
+
+#endif
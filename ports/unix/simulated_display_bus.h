@@ -0,0 +1,46 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+#include "shared-bindings/displayio/__init__.h"
+
+// A display bus for the coverage tests. It emulates a 16-bit MIPI DCS controller (column, row and
+// write RAM commands) into a framebuffer. Data sent asynchronously is only written into the
+// framebuffer when the transaction ends, the way a DMA transfer reads it, so a caller that changes
+// the data too early shows up as a corrupted framebuffer.
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t framebuffer;
+    const uint8_t *pending;
+    uint32_t pending_length;
+    uint32_t async_sends;
+    uint32_t ram_writes;
+    uint16_t width;
+    uint16_t height;
+    uint16_t window[4]; // x1, x2, y1, y2 inclusive, as sent.
+    uint16_t x;
+    uint16_t y;
+    uint8_t command;
+    uint8_t parameters[4];
+    uint8_t parameter_count;
+    bool high_byte_sent;
+    bool asynchronous;
+    bool in_transaction;
+} simulated_display_bus_obj_t;
+
+extern const mp_obj_type_t simulated_display_bus_type;
+
+bool simulated_display_bus_reset(mp_obj_t self);
+bool simulated_display_bus_bus_free(mp_obj_t self);
+bool simulated_display_bus_begin_transaction(mp_obj_t self);
+void simulated_display_bus_send(mp_obj_t self, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length);
+void simulated_display_bus_send_async(mp_obj_t self, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length);
+void simulated_display_bus_end_transaction(mp_obj_t self);
+void simulated_display_bus_collect_ptrs(mp_obj_t self);
@@ -0,0 +1,184 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/objarray.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "extmod/vfs.h"
+#include "extmod/vfs_fat.h"
+
+#if defined(MICROPY_UNIX_COVERAGE) && MICROPY_VFS_FAT
+
+// A block device in RAM that a VfsFat can call natively and that can map its
+// blocks, like the internal flash behind CIRCUITPY on boards with memory-mapped
+// flash. Its blocks can't change once they are mapped.
+
+#define SIMULATED_FLASH_BLOCK_SIZE (512)
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t blocks;
+    uint32_t block_count;
+    bool mapped;
+} simulated_flash_obj_t;
+
+static uint8_t *block_address(simulated_flash_obj_t *self, uint32_t block_num) {
+    mp_obj_array_t *blocks = MP_OBJ_TO_PTR(self->blocks);
+    return (uint8_t *)blocks->items + block_num * SIMULATED_FLASH_BLOCK_SIZE;
+}
+
+static mp_uint_t simulated_flash_read_blocks(mp_obj_t self_in, uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
+    simulated_flash_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (block_num + num_blocks > self->block_count) {
+        return MP_EIO;
+    }
+    memcpy(dest, block_address(self, block_num), num_blocks * SIMULATED_FLASH_BLOCK_SIZE);
+    return 0;
+}
+
+static mp_uint_t simulated_flash_write_blocks(mp_obj_t self_in, const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
+    simulated_flash_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->mapped) {
+        return MP_EROFS;
+    }
+    if (block_num + num_blocks > self->block_count) {
+        return MP_EIO;
+    }
+    memcpy(block_address(self, block_num), src, num_blocks * SIMULATED_FLASH_BLOCK_SIZE);
+    return 0;
+}
+
+static bool simulated_flash_ioctl(mp_obj_t self_in, uint32_t cmd, uint32_t arg, size_t *out_value) {
+    simulated_flash_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    *out_value = 0;
+    switch (cmd) {
+        case MP_BLOCKDEV_IOCTL_INIT:
+        case MP_BLOCKDEV_IOCTL_DEINIT:
+        case MP_BLOCKDEV_IOCTL_SYNC:
+            break;
+        case MP_BLOCKDEV_IOCTL_BLOCK_COUNT:
+            *out_value = self->block_count;
+            break;
+        case MP_BLOCKDEV_IOCTL_BLOCK_SIZE:
+            *out_value = SIMULATED_FLASH_BLOCK_SIZE;
+            break;
+        case MP_BLOCKDEV_IOCTL_MEMMAP:
+            if (arg >= self->block_count) {
+                return false;
+            }
+            *out_value = (size_t)block_address(self, arg);
+            break;
+        case MP_BLOCKDEV_IOCTL_MEMMAP_LOCK:
+            self->mapped = true;
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+static mp_obj_t simulated_flash_make_new(const mp_obj_type_t *type, size_t n_args,
+    size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_block_count };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_block_count, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t block_count = mp_arg_validate_int_range(args[ARG_block_count].u_int, 1, 0xffff, MP_QSTR_block_count);
+
+    simulated_flash_obj_t *self = mp_obj_malloc(simulated_flash_obj_t, type);
+    self->blocks = mp_obj_new_bytearray_of_zeros(block_count * SIMULATED_FLASH_BLOCK_SIZE);
+    self->block_count = block_count;
+    self->mapped = false;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static mp_obj_t simulated_flash_readblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_WRITE);
+    mp_uint_t ret = simulated_flash_read_blocks(self_in, bufinfo.buf, mp_obj_get_int(block_num), bufinfo.len / SIMULATED_FLASH_BLOCK_SIZE);
+    if (ret != 0) {
+        mp_raise_OSError(ret);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(simulated_flash_readblocks_obj, simulated_flash_readblocks);
+
+static mp_obj_t simulated_flash_writeblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_READ);
+    mp_uint_t ret = simulated_flash_write_blocks(self_in, bufinfo.buf, mp_obj_get_int(block_num), bufinfo.len / SIMULATED_FLASH_BLOCK_SIZE);
+    if (ret != 0) {
+        mp_raise_OSError(ret);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(simulated_flash_writeblocks_obj, simulated_flash_writeblocks);
+
+static mp_obj_t simulated_flash_obj_ioctl(mp_obj_t self_in, mp_obj_t cmd, mp_obj_t arg) {
+    size_t out_value;
+    if (simulated_flash_ioctl(self_in, mp_obj_get_int(cmd), mp_obj_get_int(arg), &out_value)) {
+        return MP_OBJ_NEW_SMALL_INT(out_value);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(simulated_flash_obj_ioctl_obj, simulated_flash_obj_ioctl);
+
+// Makes the given VfsFat on this device call it natively, as the VfsFat for
+// CIRCUITPY calls the internal flash. Only native block devices are asked to
+// map blocks.
+static mp_obj_t simulated_flash_use_natively(mp_obj_t self_in, mp_obj_t vfs_in) {
+    if (!mp_obj_is_type(vfs_in, &mp_fat_vfs_type)) {
+        mp_raise_TypeError(NULL);
+    }
+    fs_user_mount_t *vfs = MP_OBJ_TO_PTR(vfs_in);
+    vfs->blockdev.flags |= MP_BLOCKDEV_FLAG_NATIVE | MP_BLOCKDEV_FLAG_HAVE_IOCTL;
+    vfs->blockdev.readblocks[0] = mp_const_none;
+    vfs->blockdev.readblocks[1] = self_in;
+    vfs->blockdev.readblocks[2] = (mp_obj_t)simulated_flash_read_blocks; // native version
+    vfs->blockdev.writeblocks[0] = mp_const_none;
+    vfs->blockdev.writeblocks[1] = self_in;
+    vfs->blockdev.writeblocks[2] = (mp_obj_t)simulated_flash_write_blocks; // native version
+    vfs->blockdev.u.ioctl[0] = mp_const_none;
+    vfs->blockdev.u.ioctl[1] = self_in;
+    vfs->blockdev.u.ioctl[2] = (mp_obj_t)simulated_flash_ioctl; // native version
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(simulated_flash_use_natively_obj, simulated_flash_use_natively);
+
+// Whether blocks have been mapped, after which they can't be written.
+static mp_obj_t simulated_flash_get_mapped(mp_obj_t self_in) {
+    simulated_flash_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(self->mapped);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(simulated_flash_get_mapped_obj, simulated_flash_get_mapped);
+
+MP_PROPERTY_GETTER(simulated_flash_mapped_obj,
+    (mp_obj_t)&simulated_flash_get_mapped_obj);
+
+static const mp_rom_map_elem_t simulated_flash_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&simulated_flash_readblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&simulated_flash_writeblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ioctl), MP_ROM_PTR(&simulated_flash_obj_ioctl_obj) },
+    { MP_ROM_QSTR(MP_QSTR_use_natively), MP_ROM_PTR(&simulated_flash_use_natively_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mapped), MP_ROM_PTR(&simulated_flash_mapped_obj) },
+};
+static MP_DEFINE_CONST_DICT(simulated_flash_locals_dict, simulated_flash_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    simulated_flash_type,
+    MP_QSTR_SimulatedFlash,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, simulated_flash_make_new,
+    locals_dict, &simulated_flash_locals_dict
+    );
+
+#endif
@@ -37,6 +37,17 @@
 #define MICROPY_GC_SPLIT_HEAP          (1)
 #define MICROPY_GC_SPLIT_HEAP_N_HEAPS  (4)
 
+// CIRCUITPY-CHANGE: Enable testing of incremental sweep, with a small slice
+// so that allocations regularly happen while a sweep is pending.
+#define MICROPY_GC_INCREMENTAL_SWEEP   (1)
+#define MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS (64)
+// CIRCUITPY-CHANGE: Enable testing of the import directory cache.
+#define MICROPY_VFS_IMPORT_CACHE       (1)
+// CIRCUITPY-CHANGE: Enable testing of the re compiled pattern cache.
+#define MICROPY_PY_RE_COMPILE_CACHE    (4)
+// CIRCUITPY-CHANGE: Enable testing of the ordered map index.
+#define MICROPY_OPT_MAP_ORDERED_INDEX  (1)
+
 // Enable additional features.
 #define MICROPY_DEBUG_PARSE_RULE_NAME  (1)
 #define MICROPY_TRACKED_ALLOC          (1)
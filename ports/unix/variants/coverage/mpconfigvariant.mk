@@ -22,12 +22,16 @@ SRC_C += $(SRC_QRIO)
 CFLAGS += -DCIRCUITPY_QRIO=1
 $(BUILD)/lib/quirc/lib/%.o: CFLAGS += -Wno-shadow -Wno-sign-compare -include shared-module/qrio/quirc_alloc.h
 
+SRC_C += lib/AnimatedGIF/gif.c
+$(BUILD)/lib/AnimatedGIF/gif.o: CFLAGS += -DCIRCUITPY
+
 SRC_C += lib/tjpgd/src/tjpgd.c
 $(BUILD)/lib/tjpgd/src/tjpgd.o: CFLAGS += -Wno-shadow -Wno-cast-align
 
 SRC_BITMAP := \
 	shared/runtime/context_manager_helpers.c \
 	displayio_min.c \
+	simulated_display_bus.c \
 	shared-bindings/__future__/__init__.c \
 	shared-bindings/aesio/aes.c \
 	shared-bindings/aesio/__init__.c \
@@ -52,14 +56,24 @@ SRC_BITMAP := \
 	shared-bindings/audiomp3/MP3Decoder.c \
 	shared-bindings/bitmapfilter/__init__.c \
 	shared-bindings/bitmaptools/__init__.c \
+	shared-bindings/busdisplay/__init__.c \
+	shared-bindings/busdisplay/BusDisplay.c \
 	shared-bindings/codeop/__init__.c \
 	shared-bindings/displayio/Bitmap.c \
 	shared-bindings/displayio/ColorConverter.c \
+	shared-bindings/displayio/Group.c \
+	shared-bindings/displayio/OnDiskBitmap.c \
 	shared-bindings/displayio/Palette.c \
+	shared-bindings/displayio/TileGrid.c \
 	shared-bindings/floppyio/__init__.c \
+	shared-bindings/gifio/__init__.c \
+	shared-bindings/gifio/GifWriter.c \
+	shared-bindings/gifio/OnDiskGif.c \
 	shared-bindings/jpegio/__init__.c \
 	shared-bindings/jpegio/JpegDecoder.c \
 	shared-bindings/locale/__init__.c \
+	shared-bindings/msgpack/ExtType.c \
+	shared-bindings/msgpack/__init__.c \
 	shared-bindings/rainbowio/__init__.c \
 	shared-bindings/struct/__init__.c \
 	shared-bindings/synthio/__init__.c \
@@ -76,6 +90,7 @@ SRC_BITMAP := \
 	shared-bindings/vectorio/Polygon.c \
 	shared-bindings/vectorio/Rectangle.c \
 	shared-bindings/vectorio/VectorShape.c \
+	shared-bindings/zlib/Decompress.c \
 	shared-bindings/zlib/__init__.c \
 	shared-module/aesio/aes.c \
 	shared-module/aesio/__init__.c \
@@ -99,13 +114,23 @@ SRC_BITMAP := \
 	shared-module/audiomixer/MixerVoice.c \
 	shared-module/bitmapfilter/__init__.c \
 	shared-module/bitmaptools/__init__.c \
+	shared-module/busdisplay/BusDisplay.c \
 	shared-module/displayio/area.c \
 	shared-module/displayio/Bitmap.c \
+	shared-module/displayio/bus_core.c \
 	shared-module/displayio/ColorConverter.c \
+	shared-module/displayio/display_core.c \
+	shared-module/displayio/Group.c \
+	shared-module/displayio/OnDiskBitmap.c \
 	shared-module/displayio/Palette.c \
+	shared-module/displayio/TileGrid.c \
 	shared-module/floppyio/__init__.c \
+	shared-module/gifio/__init__.c \
+	shared-module/gifio/GifWriter.c \
+	shared-module/gifio/OnDiskGif.c \
 	shared-module/jpegio/__init__.c \
 	shared-module/jpegio/JpegDecoder.c \
+	shared-module/msgpack/__init__.c \
 	shared-module/os/getenv.c \
 	shared-module/rainbowio/__init__.c \
 	shared-module/struct/__init__.c \
@@ -123,6 +148,7 @@ SRC_BITMAP := \
 	shared-module/vectorio/Rectangle.c \
 	shared-module/vectorio/VectorShape.c \
 	shared-module/traceback/__init__.c \
+	shared-module/zlib/Decompress.c \
 	shared-module/zlib/__init__.c \
 
 SRC_C += $(SRC_BITMAP)
@@ -157,13 +183,19 @@ CFLAGS += \
 	-DCIRCUITPY_AUDIOMP3=1 \
 	-DCIRCUITPY_AUDIOCORE_DEBUG=1 \
 	-DCIRCUITPY_BITMAPTOOLS=1 \
+	-DCIRCUITPY_BUSDISPLAY=1 \
+	-DCIRCUITPY_BUSDISPLAY_AREA_BUFFER_SIZE=512 \
 	-DCIRCUITPY_CODEOP=1 \
+	-DCIRCUITPY_DISPLAY_LIMIT=1 \
+	-DCIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT=8 \
+	-DCIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHE_SIZE=0 \
 	-DCIRCUITPY_DISPLAYIO_UNIX=1 \
 	-DCIRCUITPY_FLOPPYIO=1 \
 	-DCIRCUITPY_FUTURE=1 \
 	-DCIRCUITPY_GIFIO=1 \
 	-DCIRCUITPY_JPEGIO=1 \
 	-DCIRCUITPY_LOCALE=1 \
+	-DCIRCUITPY_MSGPACK=1 \
 	-DCIRCUITPY_OS_GETENV=1 \
 	-DCIRCUITPY_RAINBOWIO=1 \
 	-DCIRCUITPY_STRUCT=1 \
@@ -173,7 +205,9 @@ CFLAGS += \
 	-DCIRCUITPY_VECTORIO=1 \
 	-DCIRCUITPY_ZLIB=1
 
+$(BUILD)/shared-bindings/msgpack/ExtType.o $(BUILD)/shared-bindings/msgpack/__init__.o: CFLAGS += -Wno-missing-field-initializers
+
 # CIRCUITPY-CHANGE: test native base classes.
-SRC_C += coverage.c native_base_class.c
+SRC_C += coverage.c native_base_class.c simulated_flash.c
 SRC_CXX += coveragecpp.cpp
 CIRCUITPY_MESSAGE_COMPRESSION_LEVEL = 1
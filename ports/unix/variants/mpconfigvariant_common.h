@@ -75,6 +75,9 @@
 // Extra memory debugging.
 #define MICROPY_MALLOC_USES_ALLOCATED_SIZE (1)
 #define MICROPY_MEM_STATS              (1)
+// CIRCUITPY-CHANGE: the free run cache also adds the free run counts that
+// the tests expect in micropython.mem_info().
+#define MICROPY_GC_FREE_RUN_CACHE      (8)
 
 // Enable a small performance boost for the VM.
 #define MICROPY_OPT_COMPUTED_GOTO      (1)
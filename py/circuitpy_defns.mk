@@ -801,6 +801,7 @@ SRC_SHARED_MODULE_ALL = \
 	vectorio/__init__.c \
 	warnings/__init__.c \
 	watchdog/__init__.c \
+	zlib/Decompress.c \
 	zlib/__init__.c \
 
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
@@ -75,6 +75,7 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_GC_ALLOC_THRESHOLD       (0)
 #define MICROPY_GC_SPLIT_HEAP            (1)
 #define MICROPY_GC_SPLIT_HEAP_AUTO       (1)
+#define MICROPY_GC_FREE_RUN_CACHE        (CIRCUITPY_FULL_BUILD ? 8 : 0)
 #define MP_PLAT_ALLOC_HEAP(size) port_malloc(size, false)
 #define MP_PLAT_FREE_HEAP(ptr) port_free(ptr)
 #include "supervisor/port_heap.h"
@@ -88,10 +89,13 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_OPT_COMPUTED_GOTO        (1)
 #define MICROPY_OPT_COMPUTED_GOTO_SAVE_SPACE (CIRCUITPY_COMPUTED_GOTO_SAVE_SPACE)
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH  (CIRCUITPY_OPT_LOAD_ATTR_FAST_PATH)
+#define MICROPY_OPT_LOAD_METHOD_CACHE    (CIRCUITPY_OPT_LOAD_METHOD_CACHE)
 #define MICROPY_OPT_MAP_LOOKUP_CACHE  (CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
+#define MICROPY_OPT_MAP_ORDERED_INDEX    (CIRCUITPY_OPT_MAP_ORDERED_INDEX)
 #define MICROPY_OPT_MPZ_BITWISE          (0)
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (CIRCUITPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
+#define MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE (CIRCUITPY_FULL_BUILD)
 
 #define MICROPY_PY_ARRAY                 (CIRCUITPY_ARRAY)
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN    (1)
@@ -269,6 +273,10 @@ typedef long mp_off_t;
 #define MICROPY_PY_DOUBLE_TYPECODE       (CIRCUITPY_FULL_BUILD ? 1 : 0)
 #endif
 
+#ifndef MICROPY_PY_JSON_ITERLOAD
+#define MICROPY_PY_JSON_ITERLOAD             (CIRCUITPY_FULL_BUILD)
+#endif
+
 #ifndef MICROPY_PY_FUNCTION_ATTRS
 #define MICROPY_PY_FUNCTION_ATTRS            (CIRCUITPY_FULL_BUILD)
 #endif
@@ -280,6 +288,8 @@ typedef long mp_off_t;
 #define MICROPY_PY_RE_MATCH_GROUPS           (CIRCUITPY_RE)
 #define MICROPY_PY_RE_MATCH_SPAN_START_END   (CIRCUITPY_RE)
 #define MICROPY_PY_RE_SUB                    (CIRCUITPY_RE)
+#define MICROPY_PY_RE_FINDITER               (CIRCUITPY_RE)
+#define MICROPY_PY_RE_COMPILE_CACHE          (CIRCUITPY_FULL_BUILD ? 4 : 0)
 
 #define CIRCUITPY_MICROPYTHON_ADVANCED        (0)
 
@@ -385,6 +395,24 @@ typedef long mp_off_t;
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (128)
 #endif
 
+// Most areas a display refreshes at once. Dirty areas beyond this are merged together.
+#ifndef CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT
+#define CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT (CIRCUITPY_FULL_BUILD ? 24 : 8)
+#endif
+
+// Smallest size in bytes of each buffer that a BusDisplay renders into before sending it. Buffers
+// are made larger when needed to hold one row of the display. When the bus can send in the
+// background, two are used so that one is rendered while the other is sent.
+#ifndef CIRCUITPY_BUSDISPLAY_AREA_BUFFER_SIZE
+#define CIRCUITPY_BUSDISPLAY_AREA_BUFFER_SIZE (512)
+#endif
+
+// Bytes of OnDiskBitmap pixel data to keep in RAM. At least one row is cached, if it fits,
+// unless this is 0, which turns the cache off.
+#ifndef CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHE_SIZE
+#define CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHE_SIZE (CIRCUITPY_FULL_BUILD ? 4096 : 0)
+#endif
+
 #else
 #define CIRCUITPY_DISPLAY_LIMIT (0)
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (0)
@@ -463,6 +491,16 @@ void background_callback_run_all(void);
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #endif
 
+#ifndef MICROPY_VFS_IMPORT_CACHE
+#define MICROPY_VFS_IMPORT_CACHE (CIRCUITPY_FULL_BUILD)
+#endif
+
+// How many erase sectors of external flash can be cached in ram between flushes.
+// Each one takes 4kB, allocated only when writes need it.
+#ifndef CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (CIRCUITPY_FULL_BUILD ? 4 : 1)
+#endif
+
 #ifndef CIRCUITPY_PYSTACK_SIZE
 #define CIRCUITPY_PYSTACK_SIZE 2048
 #endif
@@ -615,6 +653,10 @@ void background_callback_run_all(void);
 #define CIRCUITPY_DIGITALIO_HAVE_INPUT_ONLY (0)
 #endif
 
+#ifndef CIRCUITPY_PARALLELDISPLAYBUS_HAVE_SEND_ASYNC
+#define CIRCUITPY_PARALLELDISPLAYBUS_HAVE_SEND_ASYNC (0)
+#endif
+
 #ifndef CIRCUITPY_DIGITALIO_HAVE_INVALID_PULL
 #define CIRCUITPY_DIGITALIO_HAVE_INVALID_PULL (0)
 #endif
@@ -168,7 +168,20 @@ static void gc_mark_subtree(size_t block);
 #endif
 static void gc_deal_with_stack_overflow(void);
 static void gc_sweep_run_finalisers(void);
+// CIRCUITPY-CHANGE: incremental sweep
+#if MICROPY_GC_INCREMENTAL_SWEEP
+#define GC_SWEEP_PENDING() (MP_STATE_MEM(gc_sweep_area) != NULL)
+static void gc_sweep_start(void);
+static void gc_sweep_step(size_t max_blocks);
+static void gc_sweep_finish(void);
+static bool gc_sweep_claim(mp_state_mem_area_t *area, size_t start_block, size_t end_block);
+#else
+#define GC_SWEEP_PENDING() (false)
 static void gc_sweep_free_blocks(void);
+#endif
+#if MICROPY_GC_FREE_RUN_CACHE
+static void gc_free_run_reset(void);
+#endif
 
 // TODO waste less memory; currently requires that all entries in alloc_table have a corresponding block in pool
 static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
@@ -283,6 +296,17 @@ void gc_init(void *start, void *end) {
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
 
+    // CIRCUITPY-CHANGE: no sweep is pending on a fresh heap
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    MP_STATE_MEM(gc_sweep_area) = NULL;
+    MP_STATE_MEM(gc_sweep_lazily) = false;
+    #endif
+
+    // CIRCUITPY-CHANGE: free run cache
+    #if MICROPY_GC_FREE_RUN_CACHE
+    gc_free_run_reset();
+    #endif
+
     GC_MUTEX_INIT();
 }
 
@@ -480,6 +504,89 @@ static inline mp_state_mem_area_t *gc_get_ptr_area(const void *ptr) {
     && ptr < (void *)MP_STATE_MEM(area).gc_pool_end         /* must be below end of pool */ \
     )
 
+// CIRCUITPY-CHANGE: free run cache
+#if MICROPY_GC_FREE_RUN_CACHE
+static void gc_free_run_reset(void) {
+    memset(MP_STATE_MEM(gc_free_run_count), 0, sizeof(MP_STATE_MEM(gc_free_run_count)));
+}
+
+// Remember that the n_blocks blocks starting at block are free.  The cache
+// keeps the first runs it is given, which are the lowest in the heap when it
+// is filled by a sweep.
+static void gc_free_run_add(const mp_state_mem_area_t *area, size_t block, size_t n_blocks) {
+    size_t cls = MIN(n_blocks, MICROPY_GC_FREE_RUN_CLASSES) - 1;
+    size_t count = MP_STATE_MEM(gc_free_run_count)[cls];
+    if (count < MICROPY_GC_FREE_RUN_CACHE) {
+        MP_STATE_MEM(gc_free_runs)[cls][count] = (void *)PTR_FROM_BLOCK(area, block);
+        MP_STATE_MEM(gc_free_run_count)[cls] = count + 1;
+    }
+}
+
+// Called for each block visited by a sweep, after the block has been swept.
+// Returns the start of the free run that the block is part of, or SIZE_MAX.
+static size_t gc_free_run_track(const mp_state_mem_area_t *area, size_t block, size_t run_start) {
+    if (ATB_GET_KIND(area, block) == AT_FREE) {
+        return run_start == SIZE_MAX ? block : run_start;
+    }
+    if (run_start != SIZE_MAX) {
+        gc_free_run_add(area, run_start, block - run_start);
+    }
+    return SIZE_MAX;
+}
+
+// Called when a sweep has finished with an area.  All blocks from end_block
+// to the end of the area are free.
+static void gc_free_run_track_end(const mp_state_mem_area_t *area, size_t end_block, size_t run_start) {
+    size_t max_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+    if (run_start == SIZE_MAX) {
+        run_start = end_block;
+    }
+    if (run_start < max_block) {
+        gc_free_run_add(area, run_start, max_block - run_start);
+    }
+}
+
+// Find n_blocks free blocks using the cache.  Returns the area holding them
+// and sets *block_out to the first block, or returns NULL if no cached run is
+// large enough.
+static mp_state_mem_area_t *gc_free_run_take(size_t n_blocks, size_t *block_out) {
+    for (size_t cls = n_blocks - 1; cls < MICROPY_GC_FREE_RUN_CLASSES; cls++) {
+        while (MP_STATE_MEM(gc_free_run_count)[cls] > 0) {
+            void *ptr = MP_STATE_MEM(gc_free_runs)[cls][--MP_STATE_MEM(gc_free_run_count)[cls]];
+            #if MICROPY_GC_SPLIT_HEAP
+            mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+            if (area == NULL) {
+                continue;
+            }
+            #else
+            if (!VERIFY_PTR(ptr)) {
+                continue;
+            }
+            mp_state_mem_area_t *area = &MP_STATE_MEM(area);
+            #endif
+            // Entries are only hints, so check that the run is still free.
+            // Look a little past the end so any remainder can be cached.
+            size_t block = BLOCK_FROM_PTR(area, ptr);
+            size_t max_block = MIN(area->gc_alloc_table_byte_len * BLOCKS_PER_ATB,
+                block + n_blocks + MICROPY_GC_FREE_RUN_CLASSES);
+            size_t end_block = block;
+            while (end_block < max_block && ATB_GET_KIND(area, end_block) == AT_FREE) {
+                end_block++;
+            }
+            if (end_block - block < n_blocks) {
+                continue;
+            }
+            if (end_block - block > n_blocks) {
+                gc_free_run_add(area, block + n_blocks, end_block - block - n_blocks);
+            }
+            *block_out = block;
+            return area;
+        }
+    }
+    return NULL;
+}
+#endif
+
 #ifndef TRACE_MARK
 #if DEBUG_PRINT
 #define TRACE_MARK(block, ptr) DEBUG_printf("gc_mark(%p)\n", ptr)
@@ -514,6 +621,11 @@ static void gc_collect_start_common(void) {
     assert((MP_STATE_THREAD(gc_lock_depth) & GC_COLLECT_FLAG) == 0);
     MP_STATE_THREAD(gc_lock_depth) |= GC_COLLECT_FLAG;
     MP_STATE_MEM(gc_stack_overflow) = 0;
+    // CIRCUITPY-CHANGE: marking relies on every live head being AT_HEAD, so
+    // any sweep left over from the previous collection must be completed.
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
 }
 
 void gc_collect_root(void **ptrs, size_t len) {
@@ -645,7 +757,17 @@ void gc_sweep_all(void) {
 void gc_collect_end(void) {
     gc_deal_with_stack_overflow();
     gc_sweep_run_finalisers();
+    // CIRCUITPY-CHANGE: collections triggered by gc_alloc only start the
+    // sweep, and leave the rest of it to subsequent allocations.
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_start();
+    if (!MP_STATE_MEM(gc_sweep_lazily)) {
+        gc_sweep_finish();
+    }
+    MP_STATE_MEM(gc_sweep_lazily) = false;
+    #else
     gc_sweep_free_blocks();
+    #endif
     #if MICROPY_GC_SPLIT_HEAP
     MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
     #endif
@@ -719,11 +841,16 @@ static void gc_sweep_run_finalisers(void) {
     #endif // MICROPY_ENABLE_FINALISER
 }
 
+#if !MICROPY_GC_INCREMENTAL_SWEEP
 // Free unmarked heads and their tails
 static void gc_sweep_free_blocks(void) {
     #if MICROPY_PY_GC_COLLECT_RETVAL
     MP_STATE_MEM(gc_collected) = 0;
     #endif
+    // CIRCUITPY-CHANGE: free run cache
+    #if MICROPY_GC_FREE_RUN_CACHE
+    gc_free_run_reset();
+    #endif
     int free_tail = 0;
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     mp_state_mem_area_t *prev_area = NULL;
@@ -732,6 +859,10 @@ static void gc_sweep_free_blocks(void) {
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         size_t last_used_block = 0;
         assert(area->gc_last_used_block <= area->gc_alloc_table_byte_len * BLOCKS_PER_ATB);
+        // CIRCUITPY-CHANGE: free run cache
+        #if MICROPY_GC_FREE_RUN_CACHE
+        size_t run_start = SIZE_MAX;
+        #endif
 
         for (size_t block = 0; block <= area->gc_last_used_block; block++) {
             MICROPY_GC_HOOK_LOOP(block);
@@ -762,8 +893,17 @@ static void gc_sweep_free_blocks(void) {
                     last_used_block = block;
                     break;
             }
+            // CIRCUITPY-CHANGE: free run cache
+            #if MICROPY_GC_FREE_RUN_CACHE
+            run_start = gc_free_run_track(area, block, run_start);
+            #endif
         }
 
+        // CIRCUITPY-CHANGE: free run cache
+        #if MICROPY_GC_FREE_RUN_CACHE
+        gc_free_run_track_end(area, area->gc_last_used_block + 1, run_start);
+        #endif
+
         area->gc_last_used_block = last_used_block;
 
         #if MICROPY_GC_SPLIT_HEAP_AUTO
@@ -778,6 +918,200 @@ static void gc_sweep_free_blocks(void) {
         #endif
     }
 }
+#endif
+
+// CIRCUITPY-CHANGE: incremental sweep
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// Begin sweeping the heap from its first block.  Until the sweep completes,
+// blocks at or after the sweep position still carry the marks of the last
+// collection: AT_MARK heads are live and AT_HEAD heads are garbage.
+static void gc_sweep_start(void) {
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    MP_STATE_MEM(gc_collected) = 0;
+    #endif
+    MP_STATE_MEM(gc_sweep_area) = &MP_STATE_MEM(area);
+    MP_STATE_MEM(gc_sweep_block) = 0;
+    MP_STATE_MEM(gc_sweep_last_used_block) = 0;
+    MP_STATE_MEM(gc_sweep_free_tail) = false;
+    #if MICROPY_GC_SPLIT_HEAP_AUTO
+    MP_STATE_MEM(gc_sweep_prev_area) = NULL;
+    #endif
+    // CIRCUITPY-CHANGE: free run cache
+    #if MICROPY_GC_FREE_RUN_CACHE
+    gc_free_run_reset();
+    #endif
+}
+
+// Free unmarked heads and their tails, looking at no more than max_blocks
+// blocks before returning.
+static void gc_sweep_step(size_t max_blocks) {
+    mp_state_mem_area_t *area = MP_STATE_MEM(gc_sweep_area);
+    size_t block = MP_STATE_MEM(gc_sweep_block);
+    size_t last_used_block = MP_STATE_MEM(gc_sweep_last_used_block);
+    bool free_tail = MP_STATE_MEM(gc_sweep_free_tail);
+
+    while (area != NULL && max_blocks > 0) {
+        assert(area->gc_last_used_block <= area->gc_alloc_table_byte_len * BLOCKS_PER_ATB);
+        size_t end_block = area->gc_last_used_block + 1;
+        if (end_block - block > max_blocks) {
+            end_block = block + max_blocks;
+        }
+        max_blocks -= end_block - block;
+
+        size_t first_freed = SIZE_MAX;
+        // CIRCUITPY-CHANGE: free run cache
+        #if MICROPY_GC_FREE_RUN_CACHE
+        size_t run_start = SIZE_MAX;
+        #endif
+        for (; block < end_block; block++) {
+            MICROPY_GC_HOOK_LOOP(block);
+            switch (ATB_GET_KIND(area, block)) {
+                case AT_HEAD:
+                    free_tail = true;
+                    DEBUG_printf("gc_sweep_step(%p)\n", (void *)PTR_FROM_BLOCK(area, block));
+                    #if MICROPY_PY_GC_COLLECT_RETVAL
+                    MP_STATE_MEM(gc_collected)++;
+                    #endif
+                    if (first_freed == SIZE_MAX) {
+                        first_freed = block;
+                    }
+                    // fall through to free the head
+                    MP_FALLTHROUGH
+
+                case AT_TAIL:
+                    if (free_tail) {
+                        ATB_ANY_TO_FREE(area, block);
+                        #if CLEAR_ON_SWEEP
+                        memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
+                        #endif
+                    } else {
+                        last_used_block = block;
+                    }
+                    break;
+
+                case AT_MARK:
+                    ATB_MARK_TO_HEAD(area, block);
+                    free_tail = false;
+                    last_used_block = block;
+                    break;
+            }
+            // CIRCUITPY-CHANGE: free run cache
+            #if MICROPY_GC_FREE_RUN_CACHE
+            run_start = gc_free_run_track(area, block, run_start);
+            #endif
+        }
+
+        if (first_freed != SIZE_MAX) {
+            // gc_alloc may have moved past this point while it was unswept.
+            if (first_freed / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
+                area->gc_last_free_atb_index = first_freed / BLOCKS_PER_ATB;
+            }
+            #if MICROPY_GC_SPLIT_HEAP
+            MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            #endif
+        }
+
+        if (block <= area->gc_last_used_block) {
+            // Out of budget part way through this area.
+            // CIRCUITPY-CHANGE: free run cache
+            #if MICROPY_GC_FREE_RUN_CACHE
+            if (run_start != SIZE_MAX) {
+                gc_free_run_add(area, run_start, block - run_start);
+            }
+            #endif
+            break;
+        }
+
+        // CIRCUITPY-CHANGE: free run cache
+        #if MICROPY_GC_FREE_RUN_CACHE
+        gc_free_run_track_end(area, block, run_start);
+        #endif
+
+        area->gc_last_used_block = last_used_block;
+        mp_state_mem_area_t *next_area = NEXT_AREA(area);
+
+        #if MICROPY_GC_SPLIT_HEAP_AUTO
+        // Free any empty area, aside from the first one
+        if (last_used_block == 0 && MP_STATE_MEM(gc_sweep_prev_area) != NULL) {
+            DEBUG_printf("gc_sweep_step free empty area %p\n", area);
+            NEXT_AREA(MP_STATE_MEM(gc_sweep_prev_area)) = next_area;
+            if (MP_STATE_MEM(gc_last_free_area) == area) {
+                MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            }
+            MP_PLAT_FREE_HEAP(area);
+        } else {
+            MP_STATE_MEM(gc_sweep_prev_area) = area;
+        }
+        #endif
+
+        area = next_area;
+        block = 0;
+        last_used_block = 0;
+        free_tail = false;
+    }
+
+    MP_STATE_MEM(gc_sweep_area) = area;
+    MP_STATE_MEM(gc_sweep_block) = block;
+    MP_STATE_MEM(gc_sweep_last_used_block) = last_used_block;
+    MP_STATE_MEM(gc_sweep_free_tail) = free_tail;
+}
+
+// Complete any pending sweep.
+static void gc_sweep_finish(void) {
+    if (GC_SWEEP_PENDING()) {
+        gc_sweep_step(SIZE_MAX);
+    }
+}
+
+// Called when blocks start_block..end_block (inclusive) of the given area have
+// just been put to use while a sweep may be pending.  Returns true if the
+// head is in the part of the heap not yet swept, in which case it must be
+// marked so that the sweep keeps it.
+static bool gc_sweep_claim(mp_state_mem_area_t *area, size_t start_block, size_t end_block) {
+    mp_state_mem_area_t *sweep_area = MP_STATE_MEM(gc_sweep_area);
+    if (sweep_area == NULL) {
+        return false;
+    }
+    if (area == sweep_area) {
+        if (end_block > MP_STATE_MEM(gc_sweep_last_used_block)) {
+            MP_STATE_MEM(gc_sweep_last_used_block) = end_block;
+        }
+        if (start_block >= MP_STATE_MEM(gc_sweep_block)) {
+            return true;
+        }
+        if (end_block + 1 == MP_STATE_MEM(gc_sweep_block) && MP_STATE_MEM(gc_sweep_free_tail)) {
+            // The sweep stopped part way through a garbage chunk whose head
+            // is now in use again.  Free the rest of its tail now, or it
+            // would look like part of the new chunk.
+            size_t max_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+            size_t block = end_block + 1;
+            for (; block < max_block && ATB_GET_KIND(area, block) == AT_TAIL; block++) {
+                ATB_ANY_TO_FREE(area, block);
+                #if CLEAR_ON_SWEEP
+                memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
+                #endif
+            }
+            MP_STATE_MEM(gc_sweep_block) = block;
+            MP_STATE_MEM(gc_sweep_free_tail) = false;
+        }
+        if (end_block >= MP_STATE_MEM(gc_sweep_block)) {
+            // The head has been swept but its tail runs past the sweep
+            // position.  Those blocks were free before, so there is nothing
+            // to sweep in them: move the sweep position beyond the tail.
+            MP_STATE_MEM(gc_sweep_block) = end_block + 1;
+            MP_STATE_MEM(gc_sweep_free_tail) = false;
+        }
+        return false;
+    }
+    // Areas after the one being swept have not been swept at all.
+    for (mp_state_mem_area_t *a = NEXT_AREA(sweep_area); a != NULL; a = NEXT_AREA(a)) {
+        if (a == area) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
 
 // CIRCUITPY-CHANGE: add function
 void gc_collect_ptr(void *ptr) {
@@ -803,6 +1137,10 @@ static void *MP_NO_INSTRUMENT PLACE_IN_ITCM(gc_get_ptr)(void **ptrs, int i) {
 
 void gc_info(gc_info_t *info) {
     GC_ENTER();
+    // CIRCUITPY-CHANGE: report the heap as it will be once swept
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
     info->total = 0;
     info->used = 0;
     info->free = 0;
@@ -810,6 +1148,10 @@ void gc_info(gc_info_t *info) {
     info->num_1block = 0;
     info->num_2block = 0;
     info->max_block = 0;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_FREE_RUN_CACHE
+    memset(info->num_free_runs, 0, sizeof(info->num_free_runs));
+    #endif
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         bool finish = false;
         info->total += area->gc_pool_end - area->gc_pool_start;
@@ -858,6 +1200,12 @@ void gc_info(gc_info_t *info) {
                     if (len_free > info->max_free) {
                         info->max_free = len_free;
                     }
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_GC_FREE_RUN_CACHE
+                    if (len_free > 0) {
+                        info->num_free_runs[MIN(len_free, MICROPY_GC_FREE_RUN_CLASSES) - 1] += 1;
+                    }
+                    #endif
                     len_free = 0;
                 }
             }
@@ -907,18 +1255,47 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     bool added = false;
     #endif
+    // CIRCUITPY-CHANGE: incremental sweep
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    size_t sweep_budget = MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS;
+    #endif
+    // CIRCUITPY-CHANGE: free run cache
+    bool from_cache = false;
 
     #if MICROPY_GC_ALLOC_THRESHOLD
     if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
         GC_EXIT();
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        MP_STATE_MEM(gc_sweep_lazily) = true;
+        #endif
         gc_collect();
         collected = 1;
         GC_ENTER();
     }
     #endif
 
+    // CIRCUITPY-CHANGE: each allocation pays for a slice of any pending sweep
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    if (GC_SWEEP_PENDING()) {
+        gc_sweep_step(MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS);
+    }
+    #endif
+
     for (;;) {
 
+        // CIRCUITPY-CHANGE: try the free run cache before scanning the ATB
+        #if MICROPY_GC_FREE_RUN_CACHE
+        if (n_blocks <= MICROPY_GC_FREE_RUN_CLASSES) {
+            area = gc_free_run_take(n_blocks, &start_block);
+            if (area != NULL) {
+                n_free = n_blocks;
+                i = start_block + n_blocks - 1;
+                from_cache = true;
+                goto found;
+            }
+        }
+        #endif
+
         #if MICROPY_GC_SPLIT_HEAP
         area = MP_STATE_MEM(gc_last_free_area);
         #else
@@ -954,6 +1331,17 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             #endif
         }
 
+        // CIRCUITPY-CHANGE: reclaim more of the heap from a pending sweep
+        // before resorting to another collection.  The slice size doubles on
+        // each attempt to bound the number of rescans.
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        if (GC_SWEEP_PENDING()) {
+            gc_sweep_step(sweep_budget);
+            sweep_budget *= 2;
+            continue;
+        }
+        #endif
+
         GC_EXIT();
         // nothing found!
         if (collected) {
@@ -971,6 +1359,10 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             return NULL;
         }
         DEBUG_printf("gc_alloc(" UINT_FMT "): no free mem, triggering GC\n", n_bytes);
+        // CIRCUITPY-CHANGE
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        MP_STATE_MEM(gc_sweep_lazily) = true;
+        #endif
         gc_collect();
         collected = 1;
         GC_ENTER();
@@ -987,7 +1379,9 @@ found:
     // for a single free block, which guarantees that there are no free blocks
     // before this one.  Also, whenever we free or shink a block we must check
     // if this index needs adjusting (see gc_realloc and gc_free).
-    if (n_free == 1) {
+    // CIRCUITPY-CHANGE: a run from the free run cache may have free blocks
+    // before it.
+    if (n_free == 1 && !from_cache) {
         #if MICROPY_GC_SPLIT_HEAP
         MP_STATE_MEM(gc_last_free_area) = area;
         #endif
@@ -1004,6 +1398,14 @@ found:
     // mark first block as used head
     ATB_FREE_TO_HEAD(area, start_block);
 
+    // CIRCUITPY-CHANGE: a block allocated ahead of a pending sweep must be
+    // marked or the sweep would free it.
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    if (gc_sweep_claim(area, start_block, end_block)) {
+        ATB_HEAD_TO_MARK(area, start_block);
+    }
+    #endif
+
     // mark rest of blocks as used tail
     // TODO for a run of many blocks can make this more efficient
     for (size_t bl = start_block + 1; bl <= end_block; bl++) {
@@ -1112,7 +1514,8 @@ void gc_free(void *ptr) {
 
     size_t block = BLOCK_FROM_PTR(area, ptr);
     assert(ATB_GET_KIND(area, block) == AT_HEAD
-        || (ATB_GET_KIND(area, block) == AT_MARK && (MP_STATE_THREAD(gc_lock_depth) & GC_COLLECT_FLAG)));
+        || (ATB_GET_KIND(area, block) == AT_MARK && (MP_STATE_THREAD(gc_lock_depth) & GC_COLLECT_FLAG))
+        || (ATB_GET_KIND(area, block) == AT_MARK && GC_SWEEP_PENDING()));
 
     #if MICROPY_ENABLE_FINALISER
     FTB_CLEAR(area, block);
@@ -1149,6 +1552,11 @@ void gc_free(void *ptr) {
         block += 1;
     } while (ATB_GET_KIND(area, block) == AT_TAIL);
 
+    // CIRCUITPY-CHANGE: free run cache
+    #if MICROPY_GC_FREE_RUN_CACHE
+    gc_free_run_add(area, BLOCK_FROM_PTR(area, ptr), block - BLOCK_FROM_PTR(area, ptr));
+    #endif
+
     GC_EXIT();
 
     #if EXTENSIVE_HEAP_PROFILING
@@ -1172,7 +1580,9 @@ size_t gc_nbytes(const void *ptr) {
 
     if (area) {
         size_t block = BLOCK_FROM_PTR(area, ptr);
-        if (ATB_GET_KIND(area, block) == AT_HEAD) {
+        // CIRCUITPY-CHANGE: live blocks not yet swept are still marked
+        if (ATB_GET_KIND(area, block) == AT_HEAD
+            || (ATB_GET_KIND(area, block) == AT_MARK && GC_SWEEP_PENDING())) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
@@ -1219,7 +1629,8 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     area = &MP_STATE_MEM(area);
     #endif
     size_t block = BLOCK_FROM_PTR(area, ptr);
-    assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    assert(ATB_GET_KIND(area, block) == AT_HEAD
+        || (ATB_GET_KIND(area, block) == AT_MARK && GC_SWEEP_PENDING()));
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -1235,7 +1646,9 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     size_t max_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
     for (size_t bl = block + n_blocks; bl < max_block; bl++) {
         byte block_type = ATB_GET_KIND(area, bl);
-        if (block_type == AT_TAIL) {
+        // CIRCUITPY-CHANGE: a tail after free blocks belongs to a garbage
+        // chunk that a pending sweep has only partly freed.
+        if (block_type == AT_TAIL && n_free == 0) {
             n_blocks++;
             continue;
         }
@@ -1263,6 +1676,11 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
             ATB_ANY_TO_FREE(area, bl);
         }
 
+        // CIRCUITPY-CHANGE: free run cache
+        #if MICROPY_GC_FREE_RUN_CACHE
+        gc_free_run_add(area, block + new_blocks, n_blocks - new_blocks);
+        #endif
+
         #if MICROPY_GC_SPLIT_HEAP
         if (MP_STATE_MEM(gc_last_free_area) != area) {
             // See comment in gc_free.
@@ -1304,6 +1722,11 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
 
         area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
 
+        // CIRCUITPY-CHANGE: keep a pending sweep from freeing the new tail
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        gc_sweep_claim(area, block, end_block - 1);
+        #endif
+
         GC_EXIT();
 
         #if MICROPY_GC_CONSERVATIVE_CLEAR
@@ -1377,6 +1800,15 @@ void gc_dump_info(const mp_print_t *print) {
     #endif
     mp_printf(print, "\n No. of 1-blocks: %u, 2-blocks: %u, max blk sz: %u, max free sz: %u\n",
         (uint)info.num_1block, (uint)info.num_2block, (uint)info.max_block, (uint)info.max_free);
+    // CIRCUITPY-CHANGE: fragmentation of the free space
+    #if MICROPY_GC_FREE_RUN_CACHE
+    mp_printf(print, " Free runs by size:");
+    for (size_t i = 0; i < MICROPY_GC_FREE_RUN_CLASSES; i++) {
+        mp_printf(print, "%s %u%s: %u", i == 0 ? "" : ",",
+            (uint)i + 1, i + 1 == MICROPY_GC_FREE_RUN_CLASSES ? "+" : "", (uint)info.num_free_runs[i]);
+    }
+    mp_printf(print, "\n");
+    #endif
 }
 
 void gc_dump_alloc_table(const mp_print_t *print) {
@@ -100,6 +100,11 @@ typedef struct _gc_info_t {
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     size_t max_new_split;
     #endif
+    // CIRCUITPY-CHANGE: number of free runs of each length, with the last
+    // entry counting all runs of MICROPY_GC_FREE_RUN_CLASSES blocks or more
+    #if MICROPY_GC_FREE_RUN_CACHE
+    size_t num_free_runs[MICROPY_GC_FREE_RUN_CLASSES];
+    #endif
 } gc_info_t;
 
 void gc_info(gc_info_t *info);
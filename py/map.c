@@ -89,6 +89,236 @@ static size_t get_hash_alloc_greater_or_equal_to(size_t x) {
 // CIRCUITPY-CHANGE: Helper for allocating tables of elements
 #define malloc_table(num) m_new0(mp_map_elem_t, num)
 
+// CIRCUITPY-CHANGE: get hash of index, with fast path for common case of qstr
+static inline mp_uint_t map_hash(mp_obj_t index) {
+    if (mp_obj_is_qstr(index)) {
+        return qstr_hash(MP_OBJ_QSTR_VALUE(index));
+    }
+    return MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
+}
+
+#if MICROPY_OPT_MAP_ORDERED_INDEX
+// CIRCUITPY-CHANGE: An ordered map that isn't fixed keeps its entries in
+// insertion order.  Once it needs more than MAP_INDEX_MIN_ALLOC entries it
+// also gets a hash index, stored in the same allocation after the entries: a
+// header followed by a power of two sized open addressing table of entry
+// numbers (1-based, 0 means empty), each in the smallest integer type that
+// can hold them.
+//
+// In a map with an index, entries [0, filled) are in use or removed (key is
+// MP_OBJ_SENTINEL) and the rest are free (key is MP_OBJ_NULL).  Removed
+// entries at the end are freed again when they are found there.  Index slots
+// of removed and freed entries stay in place so that the probe sequences of
+// other keys stay intact.  They are cleared when the index is rebuilt, which
+// happens when it gets too full or when enough entries have been removed to
+// squeeze them out.  The entries grow by 4 at a time, as in other ordered
+// maps, and that moves the index up without rebuilding it.
+
+#define MAP_INDEX_MIN_ALLOC (8)
+
+typedef struct _map_index_t {
+    size_t filled; // number of entries that are in use or removed
+    size_t occupied; // number of index slots that aren't empty
+    size_t mask; // number of index slots minus one
+} map_index_t;
+
+static inline map_index_t *map_get_index(const mp_map_t *map) {
+    return (map_index_t *)(map->table + map->alloc);
+}
+
+// An index is kept at most two thirds full, and the map never has more
+// entries than that, so entry numbers always fit in the index slots.
+static inline size_t map_index_capacity(size_t slots) {
+    return slots - slots / 3;
+}
+
+static size_t map_index_slots(size_t n) {
+    size_t slots = 16;
+    while (map_index_capacity(slots) < n) {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+static inline size_t map_index_width(size_t slots) {
+    return slots <= 0x100 ? 1 : slots <= 0x10000 ? 2 : 4;
+}
+
+static size_t map_table_bytes(size_t alloc, size_t slots) {
+    return alloc * sizeof(mp_map_elem_t) + sizeof(map_index_t) + slots * map_index_width(slots);
+}
+
+static inline size_t map_index_get(const map_index_t *idx, size_t slot) {
+    if (idx->mask < 0x100) {
+        return ((const uint8_t *)(idx + 1))[slot];
+    } else if (idx->mask < 0x10000) {
+        return ((const uint16_t *)(idx + 1))[slot];
+    } else {
+        return ((const uint32_t *)(idx + 1))[slot];
+    }
+}
+
+static inline void map_index_set(map_index_t *idx, size_t slot, size_t value) {
+    if (idx->mask < 0x100) {
+        ((uint8_t *)(idx + 1))[slot] = value;
+    } else if (idx->mask < 0x10000) {
+        ((uint16_t *)(idx + 1))[slot] = value;
+    } else {
+        ((uint32_t *)(idx + 1))[slot] = value;
+    }
+}
+
+// Adds entry pos to the index, which always has an empty slot.
+static void map_index_insert(map_index_t *idx, mp_uint_t hash, size_t pos) {
+    size_t slot = hash & idx->mask;
+    while (map_index_get(idx, slot) != 0) {
+        slot = (slot + 1) & idx->mask;
+    }
+    map_index_set(idx, slot, pos + 1);
+    idx->occupied++;
+}
+
+// Squeezes the removed entries out of table[0, filled), clears the rest of
+// the entries and rebuilds the index with the given number of slots, which
+// the allocation must already have room for.  Only hashes the keys; they
+// are already known to be different, so none are compared.
+static void map_index_rebuild(mp_map_t *map, size_t filled, size_t slots) {
+    size_t n = 0;
+    for (size_t i = 0; i < filled; i++) {
+        if (map->table[i].key != MP_OBJ_SENTINEL) {
+            map->table[n++] = map->table[i];
+        }
+    }
+    assert(n == map->used);
+    mp_seq_clear(map->table, n, map->alloc, sizeof(*map->table));
+    map_index_t *idx = map_get_index(map);
+    idx->filled = n;
+    idx->occupied = 0;
+    idx->mask = slots - 1;
+    memset(idx + 1, 0, slots * map_index_width(slots));
+    for (size_t i = 0; i < n; i++) {
+        map_index_insert(idx, map_hash(map->table[i].key), i);
+    }
+}
+
+// Slots for an index rebuilt for new_alloc entries.  This leaves room for
+// used / 4 more index slots to be taken, so that rebuilds stay rare when
+// entries are added and removed over and over.
+static size_t map_index_rebuild_slots(const mp_map_t *map, size_t new_alloc) {
+    return map_index_slots(MAX(new_alloc, map->used + map->used / 4 + 4));
+}
+
+// Turns the table of an ordered map without an index, which is full, into
+// one with room for 4 more entries and an index.
+static void map_index_create(mp_map_t *map) {
+    size_t new_alloc = map->alloc + 4;
+    size_t slots = map_index_rebuild_slots(map, new_alloc);
+    map->table = (mp_map_elem_t *)m_renew(uint8_t, map->table, map->alloc * sizeof(mp_map_elem_t), map_table_bytes(new_alloc, slots));
+    map->alloc = new_alloc;
+    map->has_index = 1;
+    map_index_rebuild(map, map->used, slots);
+}
+
+// Makes sure a map with an index has room for one more entry.
+static void map_index_make_room(mp_map_t *map) {
+    map_index_t *idx = map_get_index(map);
+    size_t filled = idx->filled;
+    size_t slots = idx->mask + 1;
+    size_t old_alloc = map->alloc;
+    size_t new_alloc = old_alloc;
+    bool rebuild = idx->occupied >= map_index_capacity(slots);
+    if (filled == old_alloc) {
+        if (filled - map->used >= map->used / 8 + 4) {
+            // enough entries have been removed to just squeeze them out
+            rebuild = true;
+        } else {
+            new_alloc += 4;
+            rebuild |= new_alloc > map_index_capacity(slots);
+        }
+    }
+    if (!rebuild && new_alloc == old_alloc) {
+        return;
+    }
+    size_t new_slots = rebuild ? map_index_rebuild_slots(map, new_alloc) : slots;
+    if (new_alloc != old_alloc || new_slots != slots) {
+        DEBUG_printf("map_index_make_room(%p): " UINT_FMT " -> " UINT_FMT "\n", map, old_alloc, new_alloc);
+        map->table = (mp_map_elem_t *)m_renew(uint8_t, map->table, map_table_bytes(old_alloc, slots), map_table_bytes(new_alloc, new_slots));
+    }
+    if (rebuild) {
+        map->alloc = new_alloc;
+        map_index_rebuild(map, filled, new_slots);
+    } else {
+        // move the header and the index up past the new entries
+        memmove(map->table + new_alloc, map->table + old_alloc, sizeof(map_index_t) + slots * map_index_width(slots));
+        mp_seq_clear(map->table, old_alloc, new_alloc, sizeof(*map->table));
+        map->alloc = new_alloc;
+    }
+}
+
+// Frees the removed entries at the end of a map with an index.
+static void map_index_trim(mp_map_t *map) {
+    map_index_t *idx = map_get_index(map);
+    while (idx->filled > 0 && map->table[idx->filled - 1].key == MP_OBJ_SENTINEL) {
+        map->table[--idx->filled].key = MP_OBJ_NULL;
+    }
+}
+
+static mp_map_elem_t *map_index_add(mp_map_t *map, mp_obj_t index, mp_uint_t hash) {
+    map_index_make_room(map);
+    map_index_t *idx = map_get_index(map);
+    size_t pos = idx->filled++;
+    map_index_insert(idx, hash, pos);
+    map->used++;
+    mp_map_elem_t *elem = &map->table[pos];
+    elem->key = index;
+    elem->value = MP_OBJ_NULL;
+    if (!mp_obj_is_qstr(index)) {
+        map->all_keys_are_qstrs = 0;
+    }
+    return elem;
+}
+
+// Looks up index in a map with an index; see mp_map_lookup.
+static mp_map_elem_t *map_index_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind, bool compare_only_ptrs) {
+    mp_uint_t hash = map_hash(index);
+    map_index_t *idx = map_get_index(map);
+    for (size_t slot = hash & idx->mask;; slot = (slot + 1) & idx->mask) {
+        size_t pos = map_index_get(idx, slot);
+        if (pos == 0) {
+            // found an empty slot, so index is not in the map
+            break;
+        }
+        mp_map_elem_t *elem = &map->table[pos - 1];
+        if (elem->key == index || (!compare_only_ptrs && mp_map_slot_is_filled(map, pos - 1) && mp_obj_equal(elem->key, index))) {
+            if (lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
+                // mark the entry as removed, and keep elem->value so that
+                // the caller can access it if needed
+                map->used--;
+                elem->key = MP_OBJ_SENTINEL;
+                map_index_trim(map);
+            }
+            MAP_CACHE_SET(index, pos - 1);
+            return elem;
+        }
+    }
+    if (lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
+        return NULL;
+    }
+    return map_index_add(map, index, hash);
+}
+
+static void map_free_table(mp_map_t *map) {
+    if (map->has_index) {
+        m_del(uint8_t, map->table, map_table_bytes(map->alloc, map_get_index(map)->mask + 1));
+        map->has_index = 0;
+    } else {
+        m_del(mp_map_elem_t, map->table, map->alloc);
+    }
+}
+#else
+#define map_free_table(map) m_del(mp_map_elem_t, (map)->table, (map)->alloc)
+#endif
+
 void mp_map_init(mp_map_t *map, size_t n) {
     if (n == 0) {
         map->alloc = 0;
@@ -102,6 +332,10 @@ void mp_map_init(mp_map_t *map, size_t n) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
     map->is_ordered = 0;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_MAP_ORDERED_INDEX
+    map->has_index = 0;
+    #endif
 }
 
 void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
@@ -110,20 +344,48 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 1;
     map->is_ordered = 1;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_MAP_ORDERED_INDEX
+    map->has_index = 0;
+    #endif
     map->table = (mp_map_elem_t *)table;
 }
 
+// CIRCUITPY-CHANGE: copies the entries of src, and its index if it has one,
+// into a new table
+void mp_map_init_copy(mp_map_t *map, const mp_map_t *src) {
+    mp_map_init(map, 0);
+    map->alloc = src->alloc;
+    map->used = src->used;
+    map->all_keys_are_qstrs = src->all_keys_are_qstrs;
+    map->is_ordered = src->is_ordered;
+    if (src->alloc == 0) {
+        return;
+    }
+    size_t bytes = src->alloc * sizeof(mp_map_elem_t);
+    #if MICROPY_OPT_MAP_ORDERED_INDEX
+    if (src->has_index) {
+        bytes = map_table_bytes(src->alloc, map_get_index(src)->mask + 1);
+        map->has_index = 1;
+    }
+    #endif
+    map->table = (mp_map_elem_t *)m_new(uint8_t, bytes);
+    memcpy(map->table, src->table, bytes);
+}
+
 // Differentiate from mp_map_clear() - semantics is different
 void mp_map_deinit(mp_map_t *map) {
     if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
+        // CIRCUITPY-CHANGE
+        map_free_table(map);
     }
     map->used = map->alloc = 0;
 }
 
 void mp_map_clear(mp_map_t *map) {
     if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
+        // CIRCUITPY-CHANGE
+        map_free_table(map);
     }
     map->alloc = 0;
     map->used = 0;
@@ -146,7 +408,17 @@ static void mp_map_rehash(mp_map_t *map) {
     map->table = new_table;
     for (size_t i = 0; i < old_alloc; i++) {
         if (old_table[i].key != MP_OBJ_NULL && old_table[i].key != MP_OBJ_SENTINEL) {
-            mp_map_lookup(map, old_table[i].key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = old_table[i].value;
+            // CIRCUITPY-CHANGE: the keys are all different, so each one goes in
+            // the first free slot of its probe sequence without being compared
+            size_t pos = map_hash(old_table[i].key) % new_alloc;
+            while (new_table[pos].key != MP_OBJ_NULL) {
+                pos = (pos + 1) % new_alloc;
+            }
+            new_table[pos] = old_table[i];
+            map->used++;
+            if (!mp_obj_is_qstr(old_table[i].key)) {
+                map->all_keys_are_qstrs = 0;
+            }
         }
     }
     m_del(mp_map_elem_t, old_table, old_alloc);
@@ -195,6 +467,12 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
 
     // if the map is an ordered array then we must do a brute force linear search
     if (map->is_ordered) {
+        // CIRCUITPY-CHANGE: unless it has an index
+        #if MICROPY_OPT_MAP_ORDERED_INDEX
+        if (map->has_index) {
+            return map_index_lookup(map, index, lookup_kind, compare_only_ptrs);
+        }
+        #endif
         for (mp_map_elem_t *elem = &map->table[0], *top = &map->table[map->used]; elem < top; elem++) {
             if (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index))) {
                 #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
@@ -219,6 +497,13 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
             return NULL;
         }
         if (map->used == map->alloc) {
+            // CIRCUITPY-CHANGE: give a map that is getting large an index
+            #if MICROPY_OPT_MAP_ORDERED_INDEX
+            if (map->alloc + 4 > MAP_INDEX_MIN_ALLOC) {
+                map_index_create(map);
+                return map_index_add(map, index, map_hash(index));
+            }
+            #endif
             // TODO: Alloc policy
             map->alloc += 4;
             map->table = m_renew(mp_map_elem_t, map->table, map->used, map->alloc);
@@ -246,13 +531,8 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
         }
     }
 
-    // get hash of index, with fast path for common case of qstr
-    mp_uint_t hash;
-    if (mp_obj_is_qstr(index)) {
-        hash = qstr_hash(MP_OBJ_QSTR_VALUE(index));
-    } else {
-        hash = MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
-    }
+    // CIRCUITPY-CHANGE: get hash of index
+    mp_uint_t hash = map_hash(index);
 
     size_t pos = hash % map->alloc;
     size_t start_pos = pos;
@@ -326,6 +606,75 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
     }
 }
 
+// CIRCUITPY-CHANGE: returns the last entry of an ordered map that isn't empty
+mp_map_elem_t *mp_map_ordered_last(mp_map_t *map) {
+    assert(map->is_ordered && map->used > 0);
+    #if MICROPY_OPT_MAP_ORDERED_INDEX
+    if (map->has_index) {
+        map_index_trim(map);
+        return &map->table[map_get_index(map)->filled - 1];
+    }
+    #endif
+    return &map->table[map->used - 1];
+}
+
+// CIRCUITPY-CHANGE: moves elem, an entry of an ordered map, to the end of the
+// map if last is true, otherwise to the start
+void mp_map_ordered_move_to_end(mp_map_t *map, mp_map_elem_t *elem, bool last) {
+    assert(map->is_ordered && !map->is_fixed);
+    #if MICROPY_OPT_MAP_ORDERED_INDEX
+    if (map->has_index) {
+        map_index_t *idx = map_get_index(map);
+        if (!last) {
+            mp_map_elem_t tmp = *elem;
+            memmove(map->table + 1, map->table, (elem - map->table) * sizeof(*elem));
+            map->table[0] = tmp;
+            map_index_rebuild(map, idx->filled, idx->mask + 1);
+            return;
+        }
+        map_index_trim(map);
+        if (elem == &map->table[idx->filled - 1]) {
+            return;
+        }
+        // Make room first, which may move the entries, so that the map is
+        // unchanged if that raises MemoryError.  Then find the index slot
+        // that leads to the entry, and point it at the entry's new position.
+        mp_obj_t key = elem->key;
+        map_index_make_room(map);
+        idx = map_get_index(map);
+        size_t slot = map_hash(key) & idx->mask;
+        while (map->table[map_index_get(idx, slot) - 1].key != key) {
+            slot = (slot + 1) & idx->mask;
+        }
+        elem = &map->table[map_index_get(idx, slot) - 1];
+        map->table[idx->filled] = *elem;
+        elem->key = MP_OBJ_SENTINEL;
+        elem->value = MP_OBJ_NULL;
+        map_index_set(idx, slot, ++idx->filled);
+        return;
+    }
+    #endif
+    mp_map_elem_t tmp = *elem;
+    mp_map_elem_t *table = map->table;
+    mp_map_elem_t *dest, *move_begin, *move_dest;
+    size_t move_count;
+
+    if (last) {
+        mp_map_elem_t *top = &table[map->used];
+        dest = top - 1;
+        move_begin = elem + 1;
+        move_dest = elem;
+        move_count = top - move_begin;
+    } else {
+        dest = &table[0];
+        move_begin = table;
+        move_dest = table + 1;
+        move_count = elem - table;
+    }
+    memmove(move_dest, move_begin, move_count * sizeof(*elem));
+    *dest = tmp;
+}
+
 /******************************************************************************/
 /* set                                                                        */
 
@@ -206,6 +206,33 @@
 #define MICROPY_GC_CONSERVATIVE_CLEAR (MICROPY_ENABLE_GC)
 #endif
 
+// Whether to sweep the heap incrementally after an automatic collection.
+// The mark phase still runs to completion, but freeing of unreachable blocks
+// is spread over subsequent allocations so that the pause caused by a
+// collection no longer grows with the total size of the heap.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP
+#define MICROPY_GC_INCREMENTAL_SWEEP (0)
+#endif
+
+// Number of blocks swept on each allocation while an incremental sweep is
+// pending.  Larger values finish the sweep sooner but lengthen each pause.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS
+#define MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS (1024)
+#endif
+
+// Number of free runs remembered per size class so that small allocations
+// can usually be satisfied without scanning the allocation table.  Set to 0
+// to disable the cache.
+#ifndef MICROPY_GC_FREE_RUN_CACHE
+#define MICROPY_GC_FREE_RUN_CACHE (0)
+#endif
+
+// Number of size classes used by the free run cache.  Runs are classed by
+// their length in blocks, with the last class holding all longer runs.
+#ifndef MICROPY_GC_FREE_RUN_CLASSES
+#define MICROPY_GC_FREE_RUN_CLASSES (4)
+#endif
+
 // Support automatic GC when reaching allocation threshold,
 // configurable by gc.threshold().
 #ifndef MICROPY_GC_ALLOC_THRESHOLD
@@ -342,6 +369,14 @@
 #define MICROPY_PERSISTENT_CODE_LOAD (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether persistent code from memory that stays valid until soft reset, such
+// as a ROMFS or a file in memory-mapped flash, references its bytecode, strings
+// and qstr data in place instead of copying them to the heap
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+#define MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE (MICROPY_VFS_ROM)
+#endif
+
 // Whether to support saving of persistent code, i.e. for mpy-cross to
 // generate .mpy files. Enabling this enables additional metadata on raw code
 // objects which is also required for sys.settrace.
@@ -587,6 +622,20 @@
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Remember, for each LOAD_METHOD site in the bytecode, the method that was
+// found in the class of an instance, so that calls through that site with
+// another instance of the same class don't have to search the class and its
+// bases again. Uses 4 words of RAM per entry in each thread's state.
+#ifndef MICROPY_OPT_LOAD_METHOD_CACHE
+#define MICROPY_OPT_LOAD_METHOD_CACHE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Number of entries in the LOAD_METHOD cache; should be a power of 2.
+#ifndef MICROPY_OPT_LOAD_METHOD_CACHE_SIZE
+#define MICROPY_OPT_LOAD_METHOD_CACHE_SIZE (32)
+#endif
+
 // Use extra RAM to cache map lookups by remembering the likely location of
 // the index. Avoids the hash computation on unordered maps, and avoids the
 // linear search on ordered (especially in-ROM) maps. Can provide a +10-15%
@@ -601,6 +650,15 @@
 #define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether an ordered map (an OrderedDict) with more than a few entries gets a
+// hash index after its entries, so that it is no longer searched linearly.
+// Costs one to four bytes per index slot, with the index at most two thirds
+// full, in those maps only.
+#ifndef MICROPY_OPT_MAP_ORDERED_INDEX
+#define MICROPY_OPT_MAP_ORDERED_INDEX (0)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
@@ -1085,6 +1143,13 @@ typedef double mp_float_t;
 #define MICROPY_VFS_ROM (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether import looks paths up in cached directory listings instead of
+// stat'ing each one
+#ifndef MICROPY_VFS_IMPORT_CACHE
+#define MICROPY_VFS_IMPORT_CACHE (0)
+#endif
+
 /*****************************************************************************/
 /* Fine control over Python builtins, classes, modules, etc                  */
 
@@ -1763,6 +1828,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_JSON_SEPARATORS (1)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to provide json.iterload, to parse a top-level array an element at a time
+#ifndef MICROPY_PY_JSON_ITERLOAD
+#define MICROPY_PY_JSON_ITERLOAD (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 #ifndef MICROPY_PY_OS
 #define MICROPY_PY_OS (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -1791,6 +1862,19 @@ typedef double mp_float_t;
 #define MICROPY_PY_RE_SUB (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to provide re.finditer
+#ifndef MICROPY_PY_RE_FINDITER
+#define MICROPY_PY_RE_FINDITER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// CIRCUITPY-CHANGE
+// Number of compiled patterns kept for re functions that are passed a string
+// pattern, or 0 to compile the pattern on every call
+#ifndef MICROPY_PY_RE_COMPILE_CACHE
+#define MICROPY_PY_RE_COMPILE_CACHE (0)
+#endif
+
 #ifndef MICROPY_PY_HEAPQ
 #define MICROPY_PY_HEAPQ (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -88,6 +88,18 @@ typedef struct _mp_sched_item_t {
     mp_obj_t arg;
 } mp_sched_item_t;
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_LOAD_METHOD_CACHE
+// An entry of the cache used by the MP_BC_LOAD_METHOD opcode, see vm.c.  The
+// entry is valid while epoch matches load_method_cache_epoch.
+typedef struct _mp_load_method_cache_entry_t {
+    const mp_obj_type_t *type;
+    mp_obj_t method;
+    qstr attr;
+    size_t epoch;
+} mp_load_method_cache_entry_t;
+#endif
+
 // gc_lock_depth field is a combination of the GC_COLLECT_FLAG
 // bit and a lock depth shifted GC_LOCK_DEPTH_SHIFT bits left.
 #if MICROPY_ENABLE_FINALISER
@@ -158,6 +170,28 @@ typedef struct _mp_state_mem_t {
     size_t gc_collected;
     #endif
 
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // State of a pending incremental sweep.  gc_sweep_area is NULL when the
+    // heap has been completely swept.
+    mp_state_mem_area_t *gc_sweep_area;
+    size_t gc_sweep_block;
+    size_t gc_sweep_last_used_block;
+    bool gc_sweep_free_tail;
+    // Set by gc_alloc so that the collection it triggers leaves sweeping to
+    // later allocations.
+    bool gc_sweep_lazily;
+    #if MICROPY_GC_SPLIT_HEAP_AUTO
+    mp_state_mem_area_t *gc_sweep_prev_area;
+    #endif
+    #endif
+
+    #if MICROPY_GC_FREE_RUN_CACHE
+    // Starts of free runs found by the sweep or by gc_free, by size class.
+    // Entries are hints and are checked against the ATB before use.
+    void *gc_free_runs[MICROPY_GC_FREE_RUN_CLASSES][MICROPY_GC_FREE_RUN_CACHE];
+    size_t gc_free_run_count[MICROPY_GC_FREE_RUN_CLASSES];
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make the GC thread-safe.
     mp_thread_recursive_mutex_t gc_mutex;
@@ -282,6 +316,13 @@ typedef struct _mp_state_vm_t {
     // See mp_map_lookup.
     uint8_t map_lookup_cache[MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE];
     #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_LOAD_METHOD_CACHE
+    // Incremented whenever the dict of a class changes, which invalidates
+    // all entries of every thread's load_method_cache.
+    size_t load_method_cache_epoch;
+    #endif
 } mp_state_vm_t;
 
 // This structure holds state that is specific to a given thread. Everything
@@ -339,6 +380,13 @@ typedef struct _mp_state_thread_t {
     struct _mp_obj_ssl_context_t *tls_ssl_context;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_LOAD_METHOD_CACHE
+    // Indexed by the address of the LOAD_METHOD opcode.  Kept per thread so
+    // that entries are never read while another thread is writing them.
+    mp_load_method_cache_entry_t load_method_cache[MICROPY_OPT_LOAD_METHOD_CACHE_SIZE];
+    #endif
+
     // CIRCUITPY-CHANGE
     #if CIRCUITPY_WARNINGS
     warnings_action_t warnings_action;
@@ -496,7 +496,13 @@ typedef struct _mp_map_t {
     size_t all_keys_are_qstrs : 1;
     size_t is_fixed : 1;    // if set, table is fixed/read-only and can't be modified
     size_t is_ordered : 1;  // if set, table is an ordered array, not a hash map
+    // CIRCUITPY-CHANGE: if set, an ordered table is followed by a hash index
+    #if MICROPY_OPT_MAP_ORDERED_INDEX
+    size_t has_index : 1;
+    size_t used : (8 * sizeof(size_t) - 4);
+    #else
     size_t used : (8 * sizeof(size_t) - 3);
+    #endif
     size_t alloc;
     mp_map_elem_t *table;
 } mp_map_t;
@@ -522,6 +528,10 @@ void mp_map_free(mp_map_t *map);
 mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind);
 void mp_map_clear(mp_map_t *map);
 void mp_map_dump(mp_map_t *map);
+// CIRCUITPY-CHANGE: the layout of an ordered table is private to map.c
+void mp_map_init_copy(mp_map_t *map, const mp_map_t *src);
+mp_map_elem_t *mp_map_ordered_last(mp_map_t *map);
+void mp_map_ordered_move_to_end(mp_map_t *map, mp_map_elem_t *elem, bool last);
 
 // Underlying set implementation (not set object)
 
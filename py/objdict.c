@@ -301,15 +301,12 @@ mp_obj_t mp_obj_dict_copy(mp_obj_t self_in) {
     mp_check_self(mp_obj_is_dict_or_ordereddict(self_in));
     // CIRCUITPY-CHANGE
     mp_obj_dict_t *self = native_dict(self_in);
-    mp_obj_t other_out = mp_obj_new_dict(self->map.alloc);
+    mp_obj_t other_out = mp_obj_new_dict(0);
     // CIRCUITPY-CHANGE
     mp_obj_dict_t *other = native_dict(other_out);
     other->base.type = self->base.type;
-    other->map.used = self->map.used;
-    other->map.all_keys_are_qstrs = self->map.all_keys_are_qstrs;
-    other->map.is_fixed = 0;
-    other->map.is_ordered = self->map.is_ordered;
-    memcpy(other->map.table, self->map.table, self->map.alloc * sizeof(mp_map_elem_t));
+    // CIRCUITPY-CHANGE: the layout of the table is private to map.c
+    mp_map_init_copy(&other->map, &self->map);
     return other_out;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(dict_copy_obj, mp_obj_dict_copy);
@@ -407,7 +404,8 @@ static mp_obj_t dict_popitem(mp_obj_t self_in) {
     size_t cur = 0;
     #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
     if (self->map.is_ordered) {
-        cur = self->map.used - 1;
+        // CIRCUITPY-CHANGE: the last entry needn't be at used - 1
+        cur = mp_map_ordered_last(&self->map) - self->map.table;
     }
     #endif
     mp_map_elem_t *next = dict_iter_next(self, &cur);
@@ -496,25 +494,8 @@ static mp_obj_t dict_move_to_end(size_t n_args, const mp_obj_t *pos_args, mp_map
         mp_raise_type_arg(&mp_type_KeyError, key);
     }
 
-    mp_map_elem_t tmp = *elem;
-    mp_map_elem_t *table = self->map.table;
-    mp_map_elem_t *dest, *move_begin, *move_dest;
-    size_t move_count;
-
-    if (last) {
-        mp_map_elem_t *top = &table[self->map.used];
-        dest = top - 1;
-        move_begin = elem + 1;
-        move_dest = elem;
-        move_count = top - move_begin;
-    } else {
-        dest = &table[0];
-        move_begin = table;
-        move_dest = table + 1;
-        move_count = elem - table;
-    }
-    memmove(move_dest, move_begin, move_count * sizeof(*elem));
-    *dest = tmp;
+    // CIRCUITPY-CHANGE: the layout of the table is private to map.c
+    mp_map_ordered_move_to_end(&self->map, elem, last);
 
     return mp_const_none;
 }
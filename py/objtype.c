@@ -83,6 +83,14 @@ static int instance_count_native_bases(const mp_obj_type_t *type, const mp_obj_t
     }
 }
 
+// CIRCUITPY-CHANGE: addition
+#if MICROPY_OPT_LOAD_METHOD_CACHE
+bool mp_obj_instance_type_has_native_base(const mp_obj_type_t *type) {
+    const mp_obj_type_t *native_base;
+    return instance_count_native_bases(type, &native_base) != 0;
+}
+#endif
+
 // CIRCUITPY-CHANGE: support superclass constructors that take kw args
 // This wrapper function allows a subclass of a native type to call the
 // __init__() method (corresponding to type->make_new) of the native type.
@@ -1113,6 +1121,11 @@ static void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     } else {
         // delete/store attribute
 
+        // CIRCUITPY-CHANGE: methods cached by the VM may no longer be valid
+        #if MICROPY_OPT_LOAD_METHOD_CACHE
+        MP_STATE_VM(load_method_cache_epoch) += 1;
+        #endif
+
         if (MP_OBJ_TYPE_HAS_SLOT(self, locals_dict)) {
             assert(mp_obj_is_dict_or_ordereddict(MP_OBJ_FROM_PTR(MP_OBJ_TYPE_GET_SLOT(self, locals_dict)))); // MicroPython restriction, for now
             mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(self, locals_dict)->map;
@@ -1169,6 +1182,11 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
     }
 
     // TODO might need to make a copy of locals_dict; at least that's how CPython does it
+    // CIRCUITPY-CHANGE: methods cached by the VM are only invalidated by type_attr, so
+    // the class can't share its dict with the caller of type() or the class body's locals().
+    #if MICROPY_OPT_LOAD_METHOD_CACHE
+    locals_dict = mp_obj_dict_copy(locals_dict);
+    #endif
 
     // Basic validation of base classes
     uint16_t base_flags = MP_TYPE_FLAG_EQ_NOT_REFLEXIVE
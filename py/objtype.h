@@ -55,4 +55,8 @@ mp_obj_t mp_obj_instance_getiter(mp_obj_t self_in, mp_obj_iter_buf_t *iter_buf);
 // CIRCUITPY-CHANGE: addition
 void mp_obj_assert_native_inited(mp_obj_t native_object);
 
+// CIRCUITPY-CHANGE: addition
+// Whether the given class has a native type among its bases.
+bool mp_obj_instance_type_has_native_base(const mp_obj_type_t *type);
+
 #endif // MICROPY_INCLUDED_PY_OBJTYPE_H
@@ -189,7 +189,8 @@ static qstr load_qstr(mp_reader_t *reader) {
     }
     len >>= 1;
 
-    #if MICROPY_VFS_ROM
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
     // If possible, create the qstr from the memory-mapped string data.
     const uint8_t *memmap = mp_reader_try_read_rom(reader, len + 1);
     if (memmap != NULL) {
@@ -205,7 +206,8 @@ static qstr load_qstr(mp_reader_t *reader) {
     return qst;
 }
 
-#if MICROPY_VFS_ROM
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
 // Create a str/bytes object that can forever reference the given data.
 static mp_obj_t mp_obj_new_str_static(const mp_obj_type_t *type, const byte *data, size_t len) {
     if (type == &mp_type_str) {
@@ -256,7 +258,8 @@ static mp_obj_t load_obj(mp_reader_t *reader) {
         // Read in the object's data, either from ROM or into RAM.
         const uint8_t *memmap = NULL;
         vstr_t vstr;
-        #if MICROPY_VFS_ROM
+        // CIRCUITPY-CHANGE
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
         memmap = mp_reader_try_read_rom(reader, len);
         vstr.buf = (void *)memmap;
         vstr.len = len;
@@ -270,7 +273,8 @@ static mp_obj_t load_obj(mp_reader_t *reader) {
         // Create and return the object.
         if (obj_type == MP_PERSISTENT_OBJ_STR || obj_type == MP_PERSISTENT_OBJ_BYTES) {
             read_byte(reader); // skip null terminator (it needs to be there for ROM str objects)
-            #if MICROPY_VFS_ROM
+            // CIRCUITPY-CHANGE
+            #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
             if (memmap != NULL) {
                 // Create a str/bytes that references the memory-mapped data.
                 const mp_obj_type_t *t = obj_type == MP_PERSISTENT_OBJ_STR ? &mp_type_str : &mp_type_bytes;
@@ -313,7 +317,8 @@ static mp_raw_code_t *load_raw_code(mp_reader_t *reader, mp_module_context_t *co
     #endif
 
     if (kind == MP_CODE_BYTECODE) {
-        #if MICROPY_VFS_ROM
+        // CIRCUITPY-CHANGE
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
         // Try to reference memory-mapped data for the bytecode.
         fun_data = (uint8_t *)mp_reader_try_read_rom(reader, fun_data_len);
         #endif
@@ -526,7 +531,12 @@ void mp_raw_code_load_mem(const byte *buf, size_t len, mp_compiled_module_t *con
 
 void mp_raw_code_load_file(qstr filename, mp_compiled_module_t *context) {
     mp_reader_t reader;
+    // CIRCUITPY-CHANGE: only .mpy files, not source files, are read in place.
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE && MICROPY_READER_VFS
+    mp_reader_new_file_in_place(&reader, filename);
+    #else
     mp_reader_new_file(&reader, filename);
+    #endif
     mp_raw_code_load(&reader, context);
 }
 
@@ -413,7 +413,8 @@ qstr qstr_from_strn(const char *str, size_t len) {
     return qstr_from_strn_helper(str, len, false);
 }
 
-#if MICROPY_VFS_ROM
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
 // Create a new qstr that can forever reference the given string data.
 qstr qstr_from_strn_static(const char *str, size_t len) {
     return qstr_from_strn_helper(str, len, true);
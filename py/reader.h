@@ -47,6 +47,14 @@ void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t
 void mp_reader_new_file(mp_reader_t *reader, qstr filename);
 void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE && MICROPY_READER_VFS
+// Like mp_reader_new_file, but also reads the file in place if its filesystem
+// can map it. For .mpy files only, because mapping a FAT file locks the block
+// device until the VM ends.
+void mp_reader_new_file_in_place(mp_reader_t *reader, qstr filename);
+#endif
+
 // Try to efficiently read the given number of bytes from a ROM-based reader.
 // Returns a valid, non-NULL pointer to the requested data if the reader points to ROM.
 // Returns NULL if the reader does not point to ROM.
@@ -93,6 +93,11 @@ void mp_init(void) {
     MP_STATE_VM(sched_len) = 0;
     #endif
 
+    // CIRCUITPY-CHANGE: classes cached by a previous session no longer exist
+    #if MICROPY_OPT_LOAD_METHOD_CACHE
+    memset(MP_STATE_THREAD(load_method_cache), 0, sizeof(MP_STATE_THREAD(load_method_cache)));
+    #endif
+
     #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
     mp_init_emergency_exception_buf();
     #endif
@@ -151,6 +156,16 @@ void mp_init(void) {
     MP_STATE_VM(vfs_mount_table) = NULL;
     #endif
 
+    // CIRCUITPY-CHANGE: the last VM's heap is gone
+    #if MICROPY_VFS_IMPORT_CACHE
+    MP_STATE_VM(vfs_import_cache) = MP_OBJ_NULL;
+    #endif
+
+    // CIRCUITPY-CHANGE: as are the patterns compiled by re
+    #if MICROPY_PY_RE && MICROPY_PY_RE_COMPILE_CACHE
+    memset(MP_STATE_VM(re_compile_cache), 0, sizeof(MP_STATE_VM(re_compile_cache)));
+    #endif
+
     #if MICROPY_PY_SYS_PATH_ARGV_DEFAULTS
     #if MICROPY_PY_SYS_PATH
     mp_sys_path = mp_obj_new_list(0, NULL);
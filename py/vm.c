@@ -444,6 +444,43 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_LOAD_METHOD_CACHE
+                    // CIRCUITPY-CHANGE
+                    // For an instance of a Python class, use the method that this
+                    // opcode last found in the same class, unless the class dicts
+                    // have changed since.  The instance's own members still take
+                    // precedence so they are always checked.
+                    mp_obj_t top = TOP();
+                    const mp_obj_type_t *type = mp_obj_get_type(top);
+                    if (mp_obj_is_instance_type(type)) {
+                        mp_load_method_cache_entry_t *entry =
+                            &MP_STATE_THREAD(load_method_cache)[(uintptr_t)ip % MICROPY_OPT_LOAD_METHOD_CACHE_SIZE];
+                        if (entry->type == type && entry->attr == qst
+                            && entry->epoch == MP_STATE_VM(load_method_cache_epoch)
+                            && mp_map_lookup(&((mp_obj_instance_t *)MP_OBJ_TO_PTR(top))->members,
+                                MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP) == NULL) {
+                            sp[0] = entry->method;
+                            sp[1] = top;
+                            sp += 1;
+                            DISPATCH();
+                        }
+                        mp_load_method(top, qst, sp);
+                        // Only remember plain functions found in the class, which is
+                        // when they are bound to the instance.
+                        if (sp[1] == top && mp_obj_is_obj(sp[0])) {
+                            const mp_obj_type_t *m_type = mp_obj_get_type(sp[0]);
+                            if ((m_type->flags & (MP_TYPE_FLAG_BINDS_SELF | MP_TYPE_FLAG_BUILTIN_FUN)) == MP_TYPE_FLAG_BINDS_SELF
+                                && !mp_obj_instance_type_has_native_base(type)) {
+                                entry->type = type;
+                                entry->method = sp[0];
+                                entry->attr = qst;
+                                entry->epoch = MP_STATE_VM(load_method_cache_epoch);
+                            }
+                        }
+                        sp += 1;
+                        DISPATCH();
+                    }
+                    #endif
                     mp_load_method(*sp, qst, sp);
                     sp += 1;
                     DISPATCH();
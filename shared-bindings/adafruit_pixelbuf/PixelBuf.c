@@ -19,6 +19,10 @@
 #include "shared-bindings/adafruit_pixelbuf/PixelBuf.h"
 #include "shared-module/adafruit_pixelbuf/PixelBuf.h"
 #include "shared-bindings/digitalio/DigitalInOut.h"
+#if CIRCUITPY_DISPLAYIO
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/Palette.h"
+#endif
 
 #if CIRCUITPY_ULAB
 #include "extmod/ulab/code/ndarray.h"
@@ -39,6 +43,7 @@ static void parse_byteorder(mp_obj_t byteorder_obj, pixelbuf_byteorder_details_t
 //|         *,
 //|         byteorder: str = "BGR",
 //|         brightness: float = 0,
+//|         gamma: float = 1.0,
 //|         auto_write: bool = False,
 //|         header: ReadableBuffer = b"",
 //|         trailer: ReadableBuffer = b"",
@@ -56,6 +61,7 @@ static void parse_byteorder(mp_obj_t byteorder_obj, pixelbuf_byteorder_details_t
 //|         :param int size: Number of pixels
 //|         :param str byteorder: Byte order string (such as "RGB", "RGBW" or "PBGR")
 //|         :param float brightness: Brightness (0 to 1.0, default 1.0)
+//|         :param float gamma: Gamma correction applied to each color value before brightness (default 1.0, none)
 //|         :param bool auto_write: Whether to automatically write pixels (Default False)
 //|         :param ~circuitpython_typing.ReadableBuffer header: Sequence of bytes to always send before pixel values.
 //|         :param ~circuitpython_typing.ReadableBuffer trailer: Sequence of bytes to always send after pixel values.
@@ -63,11 +69,12 @@ static void parse_byteorder(mp_obj_t byteorder_obj, pixelbuf_byteorder_details_t
 //|         ...
 //|
 static mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_size, ARG_byteorder, ARG_brightness, ARG_auto_write, ARG_header, ARG_trailer };
+    enum { ARG_size, ARG_byteorder, ARG_brightness, ARG_gamma, ARG_auto_write, ARG_header, ARG_trailer };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_size, MP_ARG_REQUIRED | MP_ARG_INT },
         { MP_QSTR_byteorder, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = MP_OBJ_NEW_QSTR(MP_QSTR_BGR) } },
         { MP_QSTR_brightness, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_gamma, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
         { MP_QSTR_auto_write, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_header, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
         { MP_QSTR_trailer, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
@@ -100,10 +107,15 @@ static mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
         }
     }
 
+    mp_float_t gamma = 1;
+    if (args[ARG_gamma].u_obj != mp_const_none) {
+        gamma = mp_arg_validate_obj_float_non_negative(args[ARG_gamma].u_obj, 1, MP_QSTR_gamma);
+    }
+
     // Validation complete, allocate and populate object.
     pixelbuf_pixelbuf_obj_t *self = mp_obj_malloc(pixelbuf_pixelbuf_obj_t, &pixelbuf_pixelbuf_type);
     common_hal_adafruit_pixelbuf_pixelbuf_construct(self, args[ARG_size].u_int,
-        &byteorder_details, brightness, args[ARG_auto_write].u_bool, header_bufinfo.buf,
+        &byteorder_details, brightness, gamma, args[ARG_auto_write].u_bool, header_bufinfo.buf,
         header_bufinfo.len, trailer_bufinfo.buf, trailer_bufinfo.len);
 
     return MP_OBJ_FROM_PTR(self);
@@ -182,6 +194,28 @@ MP_PROPERTY_GETSET(pixelbuf_pixelbuf_brightness_obj,
     (mp_obj_t)&pixelbuf_pixelbuf_get_brightness_obj,
     (mp_obj_t)&pixelbuf_pixelbuf_set_brightness_obj);
 
+//|     gamma: float
+//|     """Gamma correction applied to each color value before brightness. 1.0 leaves values as they are,
+//|     and about 2.5 makes steps in color values look even on typical LEDs.
+//|
+//|     Brightness and gamma are applied with a table of 256 values that is only recomputed when
+//|     they change. Either one other than 1.0 uses the second buffer."""
+static mp_obj_t pixelbuf_pixelbuf_obj_get_gamma(mp_obj_t self_in) {
+    return mp_obj_new_float(common_hal_adafruit_pixelbuf_pixelbuf_get_gamma(self_in));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_get_gamma_obj, pixelbuf_pixelbuf_obj_get_gamma);
+
+static mp_obj_t pixelbuf_pixelbuf_obj_set_gamma(mp_obj_t self_in, mp_obj_t value) {
+    mp_float_t gamma = mp_arg_validate_obj_float_non_negative(value, 1, MP_QSTR_gamma);
+    common_hal_adafruit_pixelbuf_pixelbuf_set_gamma(self_in, gamma);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_set_gamma_obj, pixelbuf_pixelbuf_obj_set_gamma);
+
+MP_PROPERTY_GETSET(pixelbuf_pixelbuf_gamma_obj,
+    (mp_obj_t)&pixelbuf_pixelbuf_get_gamma_obj,
+    (mp_obj_t)&pixelbuf_pixelbuf_set_gamma_obj);
+
 //|     auto_write: bool
 //|     """Whether to automatically write the pixels after each update."""
 static mp_obj_t pixelbuf_pixelbuf_obj_get_auto_write(mp_obj_t self_in) {
@@ -246,6 +280,42 @@ static mp_obj_t pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t value) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_fill_obj, pixelbuf_pixelbuf_fill);
 
+#if CIRCUITPY_DISPLAYIO
+//|     def blit(self, bitmap: displayio.Bitmap, palette: Optional[displayio.Palette] = None, *, start: int = 0) -> None:
+//|         """Sets pixels from the values in *bitmap*, read a row at a time from the top left, starting
+//|         at pixel *start*. This stops at the end of the bitmap or of the pixels, whichever is first.
+//|
+//|         :param displayio.Bitmap bitmap: The source bitmap
+//|         :param displayio.Palette palette: Colors for the values in *bitmap*. Pixels with a
+//|           transparent color are left as they are. When not given, each value is a 0xRRGGBB color.
+//|         :param int start: The first pixel to set
+//|         """
+//|         ...
+//|
+static mp_obj_t pixelbuf_pixelbuf_blit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bitmap, ARG_palette, ARG_start };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bitmap, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_palette, MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_start, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 0 } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *bitmap = mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
+    displayio_palette_t *palette = NULL;
+    if (mp_arg_validate_type_or_none(args[ARG_palette].u_obj, &displayio_palette_type, MP_QSTR_palette) != mp_const_none) {
+        palette = MP_OBJ_TO_PTR(args[ARG_palette].u_obj);
+    }
+    size_t length = common_hal_adafruit_pixelbuf_pixelbuf_get_len(pos_args[0]);
+    size_t start = mp_arg_validate_int_range(args[ARG_start].u_int, 0, length, MP_QSTR_start);
+
+    common_hal_adafruit_pixelbuf_pixelbuf_blit(pos_args[0], bitmap, palette, start);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_blit_obj, 1, pixelbuf_pixelbuf_blit);
+#endif
+
 //|     @overload
 //|     def __getitem__(self, index: slice) -> PixelReturnSequence:
 //|         """Returns the pixel value at the given index as a tuple of (Red, Green, Blue[, White]) values
@@ -261,7 +331,11 @@ static MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_fill_obj, pixelbuf_pixelbuf_f
 //|         ...
 //|
 //|     @overload
-//|     def __setitem__(self, index: slice, value: PixelSequence) -> None: ...
+//|     def __setitem__(self, index: slice, value: Union[PixelSequence, ReadableBuffer]) -> None:
+//|         """Sets the pixels in the slice. A `bytes`, `bytearray` or byte `array.array` with
+//|         (Red, Green, Blue[, White]) values for each pixel, or an `array.array` of 32 bit ints with
+//|         one 0xRRGGBB color per pixel, is copied in a single pass without making a tuple per pixel."""
+//|         ...
 //|
 //|     @overload
 //|     def __setitem__(self, index: int, value: PixelType) -> None:
@@ -318,6 +392,31 @@ static mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
         } else { // Set
             #if MICROPY_PY_ARRAY_SLICE_ASSIGN
 
+            // Buffers of color values don't need an object per value.
+            mp_buffer_info_t bufinfo;
+            if (!mp_obj_is_str(value) && mp_get_buffer(value, &bufinfo, MP_BUFFER_READ)) {
+                size_t item_size = 0;
+                switch (bufinfo.typecode) {
+                    case 'B':
+                    case BYTEARRAY_TYPECODE:
+                        item_size = 1;
+                        break;
+                    case 'I':
+                    case 'L':
+                    case 'i':
+                    case 'l':
+                        item_size = mp_binary_get_size('@', bufinfo.typecode, NULL);
+                        break;
+                }
+                size_t bpp = common_hal_adafruit_pixelbuf_pixelbuf_get_bpp(self_in);
+                if ((item_size == 1 && bufinfo.len == slice_len * bpp) ||
+                    (item_size == 4 && bufinfo.len == slice_len * 4)) {
+                    common_hal_adafruit_pixelbuf_pixelbuf_set_pixels_from_buffer(self_in, slice.start, slice.step, slice_len,
+                        bufinfo.buf, item_size);
+                    return mp_const_none;
+                }
+            }
+
             size_t num_items = mp_obj_get_int(mp_obj_len(value));
 
             if (num_items != slice_len && num_items != (slice_len * common_hal_adafruit_pixelbuf_pixelbuf_get_bpp(self_in))) {
@@ -348,9 +447,13 @@ static const mp_rom_map_elem_t pixelbuf_pixelbuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_auto_write), MP_ROM_PTR(&pixelbuf_pixelbuf_auto_write_obj)},
     { MP_ROM_QSTR(MP_QSTR_bpp), MP_ROM_PTR(&pixelbuf_pixelbuf_bpp_obj)},
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&pixelbuf_pixelbuf_brightness_obj)},
+    { MP_ROM_QSTR(MP_QSTR_gamma), MP_ROM_PTR(&pixelbuf_pixelbuf_gamma_obj)},
     { MP_ROM_QSTR(MP_QSTR_byteorder), MP_ROM_PTR(&pixelbuf_pixelbuf_byteorder_str)},
     { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&pixelbuf_pixelbuf_show_obj)},
     { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_obj)},
+    #if CIRCUITPY_DISPLAYIO
+    { MP_ROM_QSTR(MP_QSTR_blit), MP_ROM_PTR(&pixelbuf_pixelbuf_blit_obj)},
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(pixelbuf_pixelbuf_locals_dict, pixelbuf_pixelbuf_locals_dict_table);
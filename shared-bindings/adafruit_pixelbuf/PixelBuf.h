@@ -8,6 +8,10 @@
 
 #include "py/objtuple.h"
 #include "shared-module/adafruit_pixelbuf/PixelBuf.h"
+#if CIRCUITPY_DISPLAYIO
+#include "shared-module/displayio/Bitmap.h"
+#include "shared-module/displayio/Palette.h"
+#endif
 
 extern const mp_obj_type_t pixelbuf_pixelbuf_type;
 
@@ -19,13 +23,15 @@ typedef union {
 } color_u;
 
 void common_hal_adafruit_pixelbuf_pixelbuf_construct(pixelbuf_pixelbuf_obj_t *self, size_t n,
-    pixelbuf_byteorder_details_t *byteorder, mp_float_t brightness, bool auto_write, uint8_t *header,
+    pixelbuf_byteorder_details_t *byteorder, mp_float_t brightness, mp_float_t gamma, bool auto_write, uint8_t *header,
     size_t header_len, uint8_t *trailer, size_t trailer_len);
 
 // These take mp_obj_t because they are called on subclasses of PixelBuf.
 uint8_t common_hal_adafruit_pixelbuf_pixelbuf_get_bpp(mp_obj_t self);
 mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_brightness(mp_obj_t self);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(mp_obj_t self, mp_float_t brightness);
+mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_gamma(mp_obj_t self);
+void common_hal_adafruit_pixelbuf_pixelbuf_set_gamma(mp_obj_t self, mp_float_t gamma);
 bool common_hal_adafruit_pixelbuf_pixelbuf_get_auto_write(mp_obj_t self);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_auto_write(mp_obj_t self, bool auto_write);
 size_t common_hal_adafruit_pixelbuf_pixelbuf_get_len(mp_obj_t self_in);
@@ -35,5 +41,11 @@ void common_hal_adafruit_pixelbuf_pixelbuf_show(mp_obj_t self);
 mp_obj_t common_hal_adafruit_pixelbuf_pixelbuf_get_pixel(mp_obj_t self, size_t index);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel(mp_obj_t self, size_t index, mp_obj_t item);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len, mp_obj_t *values, mp_obj_tuple_t *flatten_to);
+// item_size is 1 for bpp color values per pixel, or 4 for a 0xRRGGBB int per pixel.
+void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels_from_buffer(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len,
+    const uint8_t *data, size_t item_size);
+#if CIRCUITPY_DISPLAYIO
+void common_hal_adafruit_pixelbuf_pixelbuf_blit(mp_obj_t self_in, displayio_bitmap_t *bitmap, displayio_palette_t *palette, size_t start);
+#endif
 void common_hal_adafruit_pixelbuf_pixelbuf_parse_color(mp_obj_t self, mp_obj_t color, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t *w);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(mp_obj_t self, size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
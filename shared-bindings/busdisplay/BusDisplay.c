@@ -138,10 +138,10 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
            ARG_auto_refresh, ARG_native_frames_per_second, ARG_backlight_on_high,
            ARG_SH1107_addressing, ARG_backlight_pwm_frequency };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_display_bus, MP_ARG_REQUIRED | MP_ARG_OBJ },
-        { MP_QSTR_init_sequence, MP_ARG_REQUIRED | MP_ARG_OBJ },
-        { MP_QSTR_width, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, },
-        { MP_QSTR_height, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, },
+        { MP_QSTR_display_bus, MP_ARG_REQUIRED | MP_ARG_OBJ, {} },
+        { MP_QSTR_init_sequence, MP_ARG_REQUIRED | MP_ARG_OBJ, {} },
+        { MP_QSTR_width, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, {} },
+        { MP_QSTR_height, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, {} },
         { MP_QSTR_colstart, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
         { MP_QSTR_rowstart, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
         { MP_QSTR_rotation, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
@@ -393,6 +393,19 @@ MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_bus_obj, busdisplay_busdispl
 MP_PROPERTY_GETTER(busdisplay_busdisplay_bus_obj,
     (mp_obj_t)&busdisplay_busdisplay_get_bus_obj);
 
+//|     refresh_stats: Tuple[int, int, int]
+//|     """Totals of the work done by refreshes since the display was created, as a tuple of the
+//|     number of areas refreshed, the pixels rendered from the root group and the pixels sent to
+//|     the display. Compare two readings to see what the refreshes between them cost. (read only)"""
+static mp_obj_t busdisplay_busdisplay_obj_get_refresh_stats(mp_obj_t self_in) {
+    busdisplay_busdisplay_obj_t *self = native_display(self_in);
+    return common_hal_busdisplay_busdisplay_get_refresh_stats(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_refresh_stats_obj, busdisplay_busdisplay_obj_get_refresh_stats);
+
+MP_PROPERTY_GETTER(busdisplay_busdisplay_refresh_stats_obj,
+    (mp_obj_t)&busdisplay_busdisplay_get_refresh_stats_obj);
+
 //|     root_group: displayio.Group
 //|     """The root group on the display.
 //|     If the root group is set to `displayio.CIRCUITPYTHON_TERMINAL`, the default CircuitPython terminal will be shown.
@@ -495,6 +508,7 @@ static const mp_rom_map_elem_t busdisplay_busdisplay_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&busdisplay_busdisplay_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_rotation), MP_ROM_PTR(&busdisplay_busdisplay_rotation_obj) },
     { MP_ROM_QSTR(MP_QSTR_bus), MP_ROM_PTR(&busdisplay_busdisplay_bus_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&busdisplay_busdisplay_refresh_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&busdisplay_busdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(busdisplay_busdisplay_locals_dict, busdisplay_busdisplay_locals_dict_table);
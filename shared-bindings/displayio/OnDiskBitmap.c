@@ -18,6 +18,12 @@
 //|     much slower pixel load times. These load times may result in frame tearing where only part of
 //|     the image is visible.
 //|
+//|     On boards with full builds, whole rows of the image are kept in RAM so that drawing reads
+//|     the file a block of rows at a time rather than a pixel at a time. As many rows as fit in
+//|     4kB are kept, but always at least one, so a single row wider than 4kB is still cached.
+//|     Smaller builds have no row cache, and neither does a bitmap whose rows could not be
+//|     allocated; those read each pixel from the file on its own.
+//|
 //|     It's easiest to use on a board with a built in display such as the `Hallowing M0 Express
 //|     <https://www.adafruit.com/product/3900>`_.
 //|
@@ -244,6 +244,20 @@ MP_DEFINE_CONST_FUN_OBJ_1(framebufferio_framebufferdisplay_get_framebuffer_obj,
 MP_PROPERTY_GETTER(framebufferio_framebufferframebuffer_obj,
     (mp_obj_t)&framebufferio_framebufferdisplay_get_framebuffer_obj);
 
+//|     refresh_stats: Tuple[int, int, int]
+//|     """Totals of the work done by refreshes since the display was created, as a tuple of the
+//|     number of areas refreshed, the pixels rendered from the root group and the pixels sent to
+//|     the framebuffer. Compare two readings to see what the refreshes between them cost. (read only)"""
+//|
+static mp_obj_t framebufferio_framebufferdisplay_obj_get_refresh_stats(mp_obj_t self_in) {
+    framebufferio_framebufferdisplay_obj_t *self = native_display(self_in);
+    return common_hal_framebufferio_framebufferdisplay_get_refresh_stats(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(framebufferio_framebufferdisplay_get_refresh_stats_obj, framebufferio_framebufferdisplay_obj_get_refresh_stats);
+
+MP_PROPERTY_GETTER(framebufferio_framebufferdisplay_refresh_stats_obj,
+    (mp_obj_t)&framebufferio_framebufferdisplay_get_refresh_stats_obj);
+
 
 //|     def fill_row(self, y: int, buffer: WriteableBuffer) -> WriteableBuffer:
 //|         """Extract the pixels from a single row
@@ -352,6 +366,7 @@ static const mp_rom_map_elem_t framebufferio_framebufferdisplay_locals_dict_tabl
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&framebufferio_framebufferdisplay_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_rotation), MP_ROM_PTR(&framebufferio_framebufferdisplay_rotation_obj) },
     { MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&framebufferio_framebufferframebuffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&framebufferio_framebufferdisplay_refresh_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&framebufferio_framebufferdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(framebufferio_framebufferdisplay_locals_dict, framebufferio_framebufferdisplay_locals_dict_table);
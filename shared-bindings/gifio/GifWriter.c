@@ -22,20 +22,24 @@
 //|         colorspace: displayio.Colorspace,
 //|         loop: bool = True,
 //|         dither: bool = False,
+//|         delta: bool = False,
 //|     ) -> None:
 //|         """Construct a GifWriter object
 //|
+//|         Besides a 2kB output buffer, the first frame allocates the compression dictionary. It takes 20kB for images of 2048 pixels or more, and less for smaller ones.
+//|
 //|         :param file: Either a file open in bytes mode, or the name of a file to open in bytes mode.
 //|         :param width: The width of the image.  All frames must have the same width.
 //|         :param height: The height of the image.  All frames must have the same height.
 //|         :param colorspace: The colorspace of the image.  All frames must have the same colorspace.  The supported colorspaces are ``RGB565``, ``BGR565``, ``RGB565_SWAPPED``, ``BGR565_SWAPPED``, and ``L8`` (greyscale)
 //|         :param loop: If True, the GIF is marked for looping playback
 //|         :param dither: If True, and the image is in color, a simple ordered dither is applied.
+//|         :param delta: If True, each frame after the first only stores the rectangle that changed since the previous frame, with unchanged pixels in it transparent. This makes files of mostly static content, such as screen captures, much smaller. It uses an extra byte of RAM per pixel.
 //|         """
 //|         ...
 //|
 static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_file, ARG_width, ARG_height, ARG_colorspace, ARG_loop, ARG_dither };
+    enum { ARG_file, ARG_width, ARG_height, ARG_colorspace, ARG_loop, ARG_dither, ARG_delta };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_file, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = NULL} },
         { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
@@ -43,6 +47,7 @@ static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_arg
         { MP_QSTR_colorspace, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = NULL} },
         { MP_QSTR_loop, MP_ARG_BOOL, { .u_bool = true } },
         { MP_QSTR_dither, MP_ARG_BOOL, { .u_bool = false } },
+        { MP_QSTR_delta, MP_ARG_BOOL, { .u_bool = false } },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -63,6 +68,7 @@ static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_arg
         (displayio_colorspace_t)cp_enum_value(&displayio_colorspace_type, args[ARG_colorspace].u_obj, MP_QSTR_colorspace),
         args[ARG_loop].u_bool,
         args[ARG_dither].u_bool,
+        args[ARG_delta].u_bool,
         own_file);
 
     return self;
@@ -88,7 +94,8 @@ static mp_obj_t gifio_gifwriter___exit__(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gifio_gifwriter___exit___obj, 4, 4, gifio_gifwriter___exit__);
 
 //|     def deinit(self) -> None:
-//|         """Close the underlying file."""
+//|         """Finish the GIF and close the underlying file. Until then, the end of the
+//|         GIF may not have been written to the file yet."""
 //|         ...
 //|
 static mp_obj_t gifio_gifwriter_deinit(mp_obj_t self_in) {
@@ -105,7 +105,7 @@
 static mp_obj_t gifio_ondiskgif_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
     enum { ARG_filename, ARG_use_palette, NUM_ARGS };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_filename, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_filename, MP_ARG_REQUIRED | MP_ARG_OBJ, {} },
         { MP_QSTR_use_palette, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
     };
     MP_STATIC_ASSERT(MP_ARRAY_SIZE(allowed_args) == NUM_ARGS);
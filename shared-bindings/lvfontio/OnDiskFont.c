@@ -23,11 +23,18 @@
 //|
 //|        The format is documented here: https://github.com/lvgl/lv_font_conv/tree/master/doc"""
 //|
-//|     def __init__(self, file_path: str, max_glyphs: int = 100) -> None:
+//|     def __init__(self, file_path: str, max_glyphs: int = 100, cache_size: int = 4096) -> None:
 //|         """Create a OnDiskFont by loading an LVGL font file from the filesystem.
 //|
+//|         The file stays open. The tables that find a glyph in it are read into memory when
+//|         they fit, and the most recently used glyphs are kept in memory with what is left, so
+//|         that showing text again doesn't read the file. Fonts with many glyphs, such as CJK
+//|         fonts, have tables too large for the default *cache_size*, and then all of it holds
+//|         glyphs.
+//|
 //|         :param str file_path: The path to the font file
 //|         :param int max_glyphs: Maximum number of glyphs to cache at once
+//|         :param int cache_size: Bytes of memory for the tables and glyphs read from the file. 0 reads them all from the file as they are needed.
 //|         """
 //|         ...
 //|
@@ -48,7 +55,6 @@ MP_PROPERTY_GETTER(lvfontio_ondiskfont_bitmap_obj,
 //|         """Returns the maximum bounds of all glyphs in the font in a tuple of two values: width, height."""
 //|         ...
 //|
-//|
 static mp_obj_t lvfontio_ondiskfont_obj_get_bounding_box(mp_obj_t self_in) {
     lvfontio_ondiskfont_t *self = MP_OBJ_TO_PTR(self_in);
 
@@ -56,17 +62,38 @@ static mp_obj_t lvfontio_ondiskfont_obj_get_bounding_box(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(lvfontio_ondiskfont_get_bounding_box_obj, lvfontio_ondiskfont_obj_get_bounding_box);
 
+//|     def prefetch(self, text: str) -> int:
+//|         """Read the glyphs for the characters in *text* from the file now, so that showing the
+//|         text later doesn't. Returns how many characters the font has glyphs for, even if
+//|         *cache_size* is too small to keep any. Glyphs beyond what *cache_size* holds replace
+//|         the earlier ones."""
+//|         ...
+//|
+//|
+static mp_obj_t lvfontio_ondiskfont_obj_prefetch(mp_obj_t self_in, mp_obj_t text_in) {
+    lvfontio_ondiskfont_t *self = MP_OBJ_TO_PTR(self_in);
+    if (common_hal_lvfontio_ondiskfont_deinited(self)) {
+        raise_deinited_error();
+    }
+    size_t len;
+    const char *text = mp_obj_str_get_data(text_in, &len);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_lvfontio_ondiskfont_prefetch(self, text, len));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(lvfontio_ondiskfont_prefetch_obj, lvfontio_ondiskfont_obj_prefetch);
+
 static const mp_rom_map_elem_t lvfontio_ondiskfont_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_bitmap), MP_ROM_PTR(&lvfontio_ondiskfont_bitmap_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_bounding_box), MP_ROM_PTR(&lvfontio_ondiskfont_get_bounding_box_obj) },
+    { MP_ROM_QSTR(MP_QSTR_prefetch), MP_ROM_PTR(&lvfontio_ondiskfont_prefetch_obj) },
 };
 static MP_DEFINE_CONST_DICT(lvfontio_ondiskfont_locals_dict, lvfontio_ondiskfont_locals_dict_table);
 
 static mp_obj_t lvfontio_ondiskfont_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_file_path, ARG_max_glyphs };
+    enum { ARG_file_path, ARG_max_glyphs, ARG_cache_size };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_file_path, MP_ARG_OBJ | MP_ARG_REQUIRED },
         { MP_QSTR_max_glyphs, MP_ARG_INT, {.u_int = 100} },
+        { MP_QSTR_cache_size, MP_ARG_INT, {.u_int = LVFONTIO_DEFAULT_CACHE_SIZE} },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -79,12 +106,13 @@ static mp_obj_t lvfontio_ondiskfont_make_new(const mp_obj_type_t *type, size_t n
     // Extract arguments
     mp_obj_t file_path_obj = args[ARG_file_path].u_obj;
     mp_uint_t max_glyphs = args[ARG_max_glyphs].u_int;
+    size_t cache_size = mp_arg_validate_int_min(args[ARG_cache_size].u_int, 0, MP_QSTR_cache_size);
 
     // Get the C string from the Python string
     const char *file_path = mp_obj_str_get_str(file_path_obj);
 
     // Always use GC allocator for Python-created objects
-    common_hal_lvfontio_ondiskfont_construct(self, file_path, max_glyphs, true);
+    common_hal_lvfontio_ondiskfont_construct(self, file_path, max_glyphs, cache_size, true);
 
     return MP_OBJ_FROM_PTR(self);
 }
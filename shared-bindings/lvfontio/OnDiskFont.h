@@ -15,8 +15,9 @@ mp_obj_t common_hal_lvfontio_ondiskfont_get_bounding_box(const lvfontio_ondiskfo
 void common_hal_lvfontio_ondiskfont_get_dimensions(const lvfontio_ondiskfont_t *self, uint16_t *width, uint16_t *height);
 
 // Function prototypes
-void common_hal_lvfontio_ondiskfont_construct(lvfontio_ondiskfont_t *self, const char *file_path, uint16_t max_glyphs, bool use_gc_allocator);
+void common_hal_lvfontio_ondiskfont_construct(lvfontio_ondiskfont_t *self, const char *file_path, uint16_t max_glyphs, size_t cache_size, bool use_gc_allocator);
 void common_hal_lvfontio_ondiskfont_deinit(lvfontio_ondiskfont_t *self);
 bool common_hal_lvfontio_ondiskfont_deinited(lvfontio_ondiskfont_t *self);
 int16_t common_hal_lvfontio_ondiskfont_cache_glyph(lvfontio_ondiskfont_t *self, uint32_t codepoint, bool *is_full_width);
 void common_hal_lvfontio_ondiskfont_release_glyph(lvfontio_ondiskfont_t *self, uint32_t slot);
+size_t common_hal_lvfontio_ondiskfont_prefetch(lvfontio_ondiskfont_t *self, const char *text, size_t len);
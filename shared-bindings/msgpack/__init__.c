@@ -104,6 +104,51 @@ static mp_obj_t mod_msgpack_pack(size_t n_args, const mp_obj_t *pos_args, mp_map
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_pack_obj, 0, mod_msgpack_pack);
 
+//| def pack_into(
+//|     obj: object,
+//|     buffer: circuitpython_typing.WriteableBuffer,
+//|     offset: int = 0,
+//|     *,
+//|     default: Union[Callable[[object], None], None] = None,
+//| ) -> int:
+//|     """Output object to a buffer in msgpack format, starting at offset.
+//|
+//|     :param object obj: Object to convert to msgpack format.
+//|     :param ~circuitpython_typing.WriteableBuffer buffer: buffer to write to
+//|     :param int offset: where in buffer to start
+//|     :param Optional[~circuitpython_typing.Callable[[object], None]] default:
+//|           function called for python objects that do not have
+//|           a representation in msgpack format.
+//|
+//|     :return int: the number of bytes written.
+//|
+//|     Raises `ValueError` if the packed object does not fit, in which case
+//|     the contents of the buffer after offset are undefined.
+//|     """
+//|     ...
+//|
+//|
+static mp_obj_t mod_msgpack_pack_into(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_obj, ARG_buffer, ARG_offset, ARG_default };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_obj, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_offset, MP_ARG_INT, { .u_int = 0 } },
+        { MP_QSTR_default, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t handler = args[ARG_default].u_obj;
+    if (handler != mp_const_none && !mp_obj_is_fun(handler) && !MP_OBJ_IS_METH(handler)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("default is not a function"));
+    }
+
+    size_t written = common_hal_msgpack_pack_into(args[ARG_obj].u_obj, args[ARG_buffer].u_obj, args[ARG_offset].u_int, handler);
+    return MP_OBJ_NEW_SMALL_INT(written);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_pack_into_obj, 0, mod_msgpack_pack_into);
+
 
 //| def unpack(
 //|     stream: circuitpython_typing.ByteStream,
@@ -142,12 +187,62 @@ static mp_obj_t mod_msgpack_unpack(size_t n_args, const mp_obj_t *pos_args, mp_m
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_unpack_obj, 0, mod_msgpack_unpack);
 
+//| def unpack_from(
+//|     buffer: circuitpython_typing.ReadableBuffer,
+//|     offset: int = 0,
+//|     *,
+//|     ext_hook: Union[Callable[[int, bytes], object], None] = None,
+//|     use_list: bool = True,
+//| ) -> Tuple[object, int]:
+//|     """Unpack one object from buffer, starting at offset.
+//|
+//|     The object is parsed where it is in the buffer, without copying it to a stream first.
+//|     The offset just after it is returned too, so several objects in a row can be unpacked
+//|     by passing it back in.
+//|
+//|     :param ~circuitpython_typing.ReadableBuffer buffer: buffer to read from
+//|     :param int offset: where in buffer the object starts
+//|     :param Optional[~circuitpython_typing.Callable[[int, bytes], object]] ext_hook: function called for objects in
+//|            msgpack ext format.
+//|     :param Optional[bool] use_list: return array as list or tuple (use_list=False).
+//|
+//|     :return Tuple[object, int]: object read from buffer, and the offset where it ends.
+//|     """
+//|     ...
+//|
+//|
+static mp_obj_t mod_msgpack_unpack_from(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_offset, ARG_ext_hook, ARG_use_list };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ, },
+        { MP_QSTR_offset, MP_ARG_INT, { .u_int = 0 } },
+        { MP_QSTR_ext_hook, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_use_list, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = true } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t hook = args[ARG_ext_hook].u_obj;
+    if (hook != mp_const_none && !mp_obj_is_fun(hook) && !MP_OBJ_IS_METH(hook)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ext_hook is not a function"));
+    }
+
+    size_t end_offset;
+    mp_obj_t items[2];
+    items[0] = common_hal_msgpack_unpack_from(args[ARG_buffer].u_obj, args[ARG_offset].u_int, hook, args[ARG_use_list].u_bool, &end_offset);
+    items[1] = MP_OBJ_NEW_SMALL_INT(end_offset);
+    return mp_obj_new_tuple(2, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_unpack_from_obj, 0, mod_msgpack_unpack_from);
+
 
 static const mp_rom_map_elem_t msgpack_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_msgpack) },
     { MP_ROM_QSTR(MP_QSTR_ExtType), MP_ROM_PTR(&mod_msgpack_exttype_type) },
     { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&mod_msgpack_pack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&mod_msgpack_pack_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&mod_msgpack_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_from), MP_ROM_PTR(&mod_msgpack_unpack_from_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(msgpack_module_globals, msgpack_module_globals_table);
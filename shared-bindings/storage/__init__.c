@@ -100,7 +100,8 @@ MP_DEFINE_CONST_FUN_OBJ_1(storage_umount_obj, storage_umount);
 //|     This can always be done from boot.py. After boot, it can only be done when the host computer
 //|     doesn't have write access and CircuitPython isn't currently writing to the filesystem. An
 //|     exception will be raised if this is the case. Some host OSes allow you to eject a drive which
-//|     will allow for remounting.
+//|     will allow for remounting. It also can't be done after boot.py once a ``.mpy`` file has been
+//|     imported in place from the filesystem: `OSError` ``EBUSY`` is raised until the next reload.
 //|
 //|     Remounting after USB is active may take a little time because it "ejects" the drive for one
 //|     query from the host. These queries happen every second or so.
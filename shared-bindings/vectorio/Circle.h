@@ -17,6 +17,7 @@ void common_hal_vectorio_circle_construct(vectorio_circle_t *self, uint16_t radi
 void common_hal_vectorio_circle_set_on_dirty(vectorio_circle_t *self, vectorio_event_t notification);
 
 uint32_t common_hal_vectorio_circle_get_pixel(void *circle, int16_t x, int16_t y);
+uint16_t common_hal_vectorio_circle_get_spans(void *circle, int16_t y, vectorio_span_t *spans, uint16_t max_spans, uint32_t *out_pixel);
 
 void common_hal_vectorio_circle_get_area(void *circle, displayio_area_t *out_area);
 
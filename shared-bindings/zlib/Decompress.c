@@ -0,0 +1,157 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Scott Shawcroft for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/zlib/Decompress.h"
+
+//| class Decompress:
+//|     """Decompresses a stream a piece at a time.
+//|
+//|     Neither the whole compressed input nor the whole output needs to be in
+//|     memory at once. Besides the output, the memory used is the history
+//|     window, 256 bytes to 32kB depending on *wbits*, and about 3kB more."""
+//|
+//|     def __init__(self, wbits: int = 0) -> None:
+//|         """Create a decompressor. Also available as ``zlib.decompressobj(wbits)``.
+//|
+//|         :param int wbits: the format and window size, as for `zlib.decompress`.
+//|           A zlib stream uses the window size from its header, unless *wbits* is smaller.
+//|           A *wbits* of 16 means a gzip stream with a 32kB window.
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_decompress_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_wbits };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_wbits, MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    zlib_decompress_obj_t *self = mp_obj_malloc(zlib_decompress_obj_t, &zlib_decompress_type);
+    common_hal_zlib_decompress_construct(self, args[ARG_wbits].u_int);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def decompress(self, data: ReadableBuffer, max_length: int = 0) -> bytes:
+//|         """Decompress *data* and return as much output as it makes available.
+//|
+//|         Input that ends part way through a block is kept until the next call.
+//|
+//|         :param ~circuitpython_typing.ReadableBuffer data: the next part of the compressed stream
+//|         :param int max_length: if not zero, return at most this many bytes. Input that was not
+//|           needed to produce them is left in `unconsumed_tail`, and should be passed to the next call.
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_decompress_decompress(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_data, ARG_max_length };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_data, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_max_length, MP_ARG_INT, {.u_int = 0} },
+    };
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_data].u_obj, &bufinfo, MP_BUFFER_READ);
+    mp_int_t max_length = mp_arg_validate_int_min(args[ARG_max_length].u_int, 0, MP_QSTR_max_length);
+
+    return common_hal_zlib_decompress_decompress(self, bufinfo.buf, bufinfo.len, max_length);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(zlib_decompress_decompress_obj, 1, zlib_decompress_decompress);
+
+//|     def decompress_into(self, data: ReadableBuffer, buf: WriteableBuffer) -> int:
+//|         """Decompress *data* into *buf* and return the number of bytes written.
+//|
+//|         This is like `decompress` with *max_length* set to the size of *buf*,
+//|         but doesn't allocate the output. Input that was not needed to fill *buf*
+//|         is left in `unconsumed_tail`.
+//|
+//|         :param ~circuitpython_typing.ReadableBuffer data: the next part of the compressed stream
+//|         :param ~circuitpython_typing.WriteableBuffer buf: where to put the output
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_decompress_decompress_into(mp_obj_t self_in, mp_obj_t data_in, mp_obj_t buf_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t data;
+    mp_get_buffer_raise(data_in, &data, MP_BUFFER_READ);
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_WRITE);
+
+    size_t written = common_hal_zlib_decompress_decompress_into(self, data.buf, data.len, buf.buf, buf.len);
+    return MP_OBJ_NEW_SMALL_INT(written);
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(zlib_decompress_decompress_into_obj, zlib_decompress_decompress_into);
+
+//|     def flush(self) -> bytes:
+//|         """Decompress `unconsumed_tail` and return all of the output that it makes available."""
+//|         ...
+//|
+static mp_obj_t zlib_decompress_flush(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_zlib_decompress_flush(self);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_flush_obj, zlib_decompress_flush);
+
+//|     eof: bool
+//|     """True once the end of the compressed stream has been reached."""
+//|
+static mp_obj_t zlib_decompress_get_eof(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_zlib_decompress_get_eof(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_get_eof_obj, zlib_decompress_get_eof);
+
+MP_PROPERTY_GETTER(zlib_decompress_eof_obj,
+    (mp_obj_t)&zlib_decompress_get_eof_obj);
+
+//|     unconsumed_tail: bytes
+//|     """Input from the last call that was not used because the output was full."""
+//|
+static mp_obj_t zlib_decompress_get_unconsumed_tail(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_zlib_decompress_get_unconsumed_tail(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_get_unconsumed_tail_obj, zlib_decompress_get_unconsumed_tail);
+
+MP_PROPERTY_GETTER(zlib_decompress_unconsumed_tail_obj,
+    (mp_obj_t)&zlib_decompress_get_unconsumed_tail_obj);
+
+//|     unused_data: bytes
+//|     """Input found after the end of the compressed stream."""
+//|
+//|
+static mp_obj_t zlib_decompress_get_unused_data(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_zlib_decompress_get_unused_data(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_get_unused_data_obj, zlib_decompress_get_unused_data);
+
+MP_PROPERTY_GETTER(zlib_decompress_unused_data_obj,
+    (mp_obj_t)&zlib_decompress_get_unused_data_obj);
+
+static const mp_rom_map_elem_t zlib_decompress_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&zlib_decompress_decompress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decompress_into), MP_ROM_PTR(&zlib_decompress_decompress_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&zlib_decompress_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_eof), MP_ROM_PTR(&zlib_decompress_eof_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unconsumed_tail), MP_ROM_PTR(&zlib_decompress_unconsumed_tail_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unused_data), MP_ROM_PTR(&zlib_decompress_unused_data_obj) },
+};
+static MP_DEFINE_CONST_DICT(zlib_decompress_locals_dict, zlib_decompress_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    zlib_decompress_type,
+    MP_QSTR_Decompress,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, zlib_decompress_make_new,
+    locals_dict, &zlib_decompress_locals_dict
+    );
@@ -18,12 +18,16 @@
 #include "py/parsenum.h"
 
 #include "shared-bindings/zlib/__init__.h"
+#include "shared-bindings/zlib/Decompress.h"
 
 //| """zlib decompression functionality
 //|
 //| The `zlib` module allows limited functionality similar to the CPython zlib library.
 //| This module allows to decompress binary data compressed with DEFLATE algorithm
-//| (commonly used in zlib library and gzip archiver). Compression is not yet implemented."""
+//| (commonly used in zlib library and gzip archiver). Compression is not yet implemented.
+//|
+//| `decompressobj` returns a `Decompress` object that decompresses a stream a piece at a time,
+//| for data that is too big to hold in memory all at once."""
 //|
 //|
 
@@ -60,9 +64,33 @@ static mp_obj_t zlib_decompress(size_t n_args, const mp_obj_t *args) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_decompress_obj, 1, 3, zlib_decompress);
 
+//| def decompressobj(wbits: int = 0) -> Decompress:
+//|     """Return a `Decompress` object, for decompressing a stream a piece at a time.
+//|
+//|     :param int wbits: the format and window size, as for `decompress`.
+//|     """
+//|     ...
+//|
+//|
+static mp_obj_t zlib_decompressobj(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_wbits };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_wbits, MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    zlib_decompress_obj_t *self = mp_obj_malloc(zlib_decompress_obj_t, &zlib_decompress_type);
+    common_hal_zlib_decompress_construct(self, args[ARG_wbits].u_int);
+    return MP_OBJ_FROM_PTR(self);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(zlib_decompressobj_obj, 0, zlib_decompressobj);
+
 static const mp_rom_map_elem_t zlib_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_zlib) },
     { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&zlib_decompress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decompressobj), MP_ROM_PTR(&zlib_decompressobj_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Decompress), MP_ROM_PTR(&zlib_decompress_type) },
 };
 
 static MP_DEFINE_CONST_DICT(zlib_globals, zlib_globals_table);
@@ -13,6 +13,11 @@
 #include <string.h>
 #include <math.h>
 
+#if CIRCUITPY_DISPLAYIO
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/Palette.h"
+#endif
+
 // Helper to ensure we have the native super class instead of a subclass.
 static pixelbuf_pixelbuf_obj_t *native_pixelbuf(mp_obj_t pixelbuf_obj) {
     mp_obj_t native_pixelbuf = mp_obj_cast_to_native_base(pixelbuf_obj, &pixelbuf_pixelbuf_type);
@@ -21,7 +26,7 @@ static pixelbuf_pixelbuf_obj_t *native_pixelbuf(mp_obj_t pixelbuf_obj) {
 }
 
 void common_hal_adafruit_pixelbuf_pixelbuf_construct(pixelbuf_pixelbuf_obj_t *self, size_t n,
-    pixelbuf_byteorder_details_t *byteorder, mp_float_t brightness, bool auto_write,
+    pixelbuf_byteorder_details_t *byteorder, mp_float_t brightness, mp_float_t gamma, bool auto_write,
     uint8_t *header, size_t header_len, uint8_t *trailer, size_t trailer_len) {
 
     self->pixel_count = n;
@@ -45,10 +50,14 @@ void common_hal_adafruit_pixelbuf_pixelbuf_construct(pixelbuf_pixelbuf_obj_t *se
             self->post_brightness_buffer[i] = DOTSTAR_LED_START_FULL_BRIGHT;
         }
     }
-    // Call set_brightness so that it can allocate a second buffer if needed.
+    // Call set_brightness and set_gamma so that they can allocate a second buffer if needed.
+    self->pre_brightness_buffer = NULL;
+    self->scale_lut = NULL;
     self->brightness = 1.0;
     self->scaled_brightness = 0x100;
+    self->gamma = 1;
     common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(MP_OBJ_FROM_PTR(self), brightness);
+    common_hal_adafruit_pixelbuf_pixelbuf_set_gamma(MP_OBJ_FROM_PTR(self), gamma);
 
     // Turn on auto_write. We don't want to do it with the above brightness call.
     self->auto_write = auto_write;
@@ -84,6 +93,37 @@ mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_brightness(mp_obj_t self_in
     return self->brightness;
 }
 
+// Rebuilds the lookup table from brightness and gamma, and rescales the whole buffer with it.
+// Returns false when there is nothing to scale.
+static bool pixelbuf_rescale(pixelbuf_pixelbuf_obj_t *self) {
+    size_t pixel_len = self->pixel_count * self->bytes_per_pixel;
+    if (self->scaled_brightness == 0x100 && self->gamma == 1 && !self->pre_brightness_buffer) {
+        return false;
+    }
+    if (self->pre_brightness_buffer == NULL) {
+        self->pre_brightness_buffer = m_malloc_without_collect(pixel_len);
+        memcpy(self->pre_brightness_buffer, self->post_brightness_buffer, pixel_len);
+    }
+    if (self->scale_lut == NULL) {
+        self->scale_lut = m_malloc_without_collect(256);
+    }
+    for (uint16_t value = 0; value < 256; value++) {
+        uint16_t corrected = value;
+        if (self->gamma != 1) {
+            corrected = (uint16_t)(MICROPY_FLOAT_C_FUN(pow)(value / MICROPY_FLOAT_CONST(255.0), self->gamma) * 255 + MICROPY_FLOAT_CONST(0.5));
+        }
+        self->scale_lut[value] = (corrected * self->scaled_brightness) / 256;
+    }
+    for (size_t i = 0; i < pixel_len; i++) {
+        // Don't adjust per-pixel luminance bytes in dotstar mode
+        if (self->byteorder.is_dotstar && i % 4 == 0) {
+            continue;
+        }
+        self->post_brightness_buffer[i] = self->scale_lut[self->pre_brightness_buffer[i]];
+    }
+    return true;
+}
+
 void common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_float_t brightness) {
     pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
     // Skip out if the brightness is already set. The default of self->brightness is 1.0. So, this
@@ -95,25 +135,24 @@ void common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_f
         return;
     }
     self->scaled_brightness = new_scaled_brightness;
-    size_t pixel_len = self->pixel_count * self->bytes_per_pixel;
-    if (self->scaled_brightness == 0x100 && !self->pre_brightness_buffer) {
-        return;
-    } else {
-        if (self->pre_brightness_buffer == NULL) {
-            self->pre_brightness_buffer = m_malloc_without_collect(pixel_len);
-            memcpy(self->pre_brightness_buffer, self->post_brightness_buffer, pixel_len);
-        }
-        for (size_t i = 0; i < pixel_len; i++) {
-            // Don't adjust per-pixel luminance bytes in dotstar mode
-            if (self->byteorder.is_dotstar && i % 4 == 0) {
-                continue;
-            }
-            self->post_brightness_buffer[i] = (self->pre_brightness_buffer[i] * self->scaled_brightness) / 256;
-        }
+    if (pixelbuf_rescale(self) && self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+    }
+}
 
-        if (self->auto_write) {
-            common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
-        }
+mp_float_t common_hal_adafruit_pixelbuf_pixelbuf_get_gamma(mp_obj_t self_in) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    return self->gamma;
+}
+
+void common_hal_adafruit_pixelbuf_pixelbuf_set_gamma(mp_obj_t self_in, mp_float_t gamma) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    if (gamma == self->gamma) {
+        return;
+    }
+    self->gamma = gamma;
+    if (pixelbuf_rescale(self) && self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
     }
 }
 
@@ -131,6 +170,26 @@ static uint8_t _pixelbuf_get_as_uint8(mp_obj_t obj) {
         MP_ERROR_TEXT("can't convert %q to %q"), mp_obj_get_type_qstr(obj), MP_QSTR_int);
 }
 
+// Int colors can't set white directly so convert to white when all components are equal.
+// Also handles RGBW values assigned an RGB tuple.
+static void pixelbuf_rgb_to_white(pixelbuf_byteorder_details_t *byteorder, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t *w) {
+    if (!byteorder->is_dotstar && byteorder->bpp == 4 && byteorder->has_white && *r == *g && *r == *b) {
+        *w = *r;
+        *r = 0;
+        *g = 0;
+        *b = 0;
+    }
+}
+
+// Splits a 0xRRGGBB color the way an int assigned to a pixel is.
+static void pixelbuf_split_color(pixelbuf_pixelbuf_obj_t *self, uint32_t color, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t *w) {
+    *r = color >> 16 & 0xff;
+    *g = (color >> 8) & 0xff;
+    *b = color & 0xff;
+    *w = self->byteorder.is_dotstar ? 255 : 0;
+    pixelbuf_rgb_to_white(&self->byteorder, r, g, b, w);
+}
+
 static void pixelbuf_parse_color(pixelbuf_pixelbuf_obj_t *self, mp_obj_t color, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t *w) {
     pixelbuf_byteorder_details_t *byteorder = &self->byteorder;
     // w is shared between white in NeoPixels and brightness in dotstars (so that DotStars can have
@@ -143,9 +202,8 @@ static void pixelbuf_parse_color(pixelbuf_pixelbuf_obj_t *self, mp_obj_t color,
 
     if (mp_obj_is_int(color) || mp_obj_is_float(color)) {
         mp_int_t value = mp_obj_is_int(color) ? mp_obj_get_int_truncated(color) : (mp_int_t)mp_obj_get_float(color);
-        *r = value >> 16 & 0xff;
-        *g = (value >> 8) & 0xff;
-        *b = value & 0xff;
+        pixelbuf_split_color(self, value, r, g, b, w);
+        return;
     } else {
         mp_obj_t *items;
         size_t len;
@@ -164,14 +222,7 @@ static void pixelbuf_parse_color(pixelbuf_pixelbuf_obj_t *self, mp_obj_t color,
             return;
         }
     }
-    // Int colors can't set white directly so convert to white when all components are equal.
-    // Also handles RGBW values assigned an RGB tuple.
-    if (!byteorder->is_dotstar && byteorder->bpp == 4 && byteorder->has_white && *r == *g && *r == *b) {
-        *w = *r;
-        *r = 0;
-        *g = 0;
-        *b = 0;
-    }
+    pixelbuf_rgb_to_white(byteorder, r, g, b, w);
 }
 
 void common_hal_adafruit_pixelbuf_pixelbuf_parse_color(mp_obj_t self_in, mp_obj_t color, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t *w) {
@@ -205,15 +256,16 @@ static void pixelbuf_set_pixel_color(pixelbuf_pixelbuf_obj_t *self, size_t index
     unscaled_buffer[rgbw_order->b] = b;
 
     if (scaled_buffer) {
+        const uint8_t *lut = self->scale_lut;
         if (self->bytes_per_pixel == 4) {
             if (!self->byteorder.is_dotstar) {
-                w = (w * self->scaled_brightness) / 256;
+                w = lut[w];
             }
             scaled_buffer[rgbw_order->w] = w;
         }
-        scaled_buffer[rgbw_order->r] = (r * self->scaled_brightness) / 256;
-        scaled_buffer[rgbw_order->g] = (g * self->scaled_brightness) / 256;
-        scaled_buffer[rgbw_order->b] = (b * self->scaled_brightness) / 256;
+        scaled_buffer[rgbw_order->r] = lut[r];
+        scaled_buffer[rgbw_order->g] = lut[g];
+        scaled_buffer[rgbw_order->b] = lut[b];
     }
 }
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(mp_obj_t self_in, size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
@@ -260,6 +312,60 @@ void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t s
 
 
 
+void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels_from_buffer(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len,
+    const uint8_t *data, size_t item_size) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    uint8_t bpp = self->byteorder.bpp;
+    for (size_t i = 0; i < slice_len; i++) {
+        uint8_t r, g, b, w;
+        if (item_size == 4) {
+            uint32_t color;
+            memcpy(&color, data + i * 4, sizeof(color));
+            pixelbuf_split_color(self, color, &r, &g, &b, &w);
+        } else {
+            // Values in (Red, Green, Blue[, White]) order, as in a tuple.
+            const uint8_t *values = data + i * bpp;
+            r = values[PIXEL_R];
+            g = values[PIXEL_G];
+            b = values[PIXEL_B];
+            if (bpp == 4) {
+                w = values[PIXEL_W];
+            } else {
+                w = self->byteorder.is_dotstar ? 255 : 0;
+            }
+        }
+        pixelbuf_set_pixel_color(self, start, r, g, b, w);
+        start += step;
+    }
+    if (self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+    }
+}
+
+#if CIRCUITPY_DISPLAYIO
+void common_hal_adafruit_pixelbuf_pixelbuf_blit(mp_obj_t self_in, displayio_bitmap_t *bitmap, displayio_palette_t *palette, size_t start) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    size_t index = start;
+    for (uint16_t y = 0; y < bitmap->height && index < self->pixel_count; y++) {
+        for (uint16_t x = 0; x < bitmap->width && index < self->pixel_count; x++, index++) {
+            uint32_t color = common_hal_displayio_bitmap_get_pixel(bitmap, x, y);
+            if (palette != NULL) {
+                if (color >= palette->color_count || common_hal_displayio_palette_is_transparent(palette, color)) {
+                    continue;
+                }
+                color = common_hal_displayio_palette_get_color(palette, color);
+            }
+            uint8_t r, g, b, w;
+            pixelbuf_split_color(self, color, &r, &g, &b, &w);
+            pixelbuf_set_pixel_color(self, index, r, g, b, w);
+        }
+    }
+    if (self->auto_write) {
+        common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+    }
+}
+#endif
+
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel(mp_obj_t self_in, size_t index, mp_obj_t value) {
     pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
     _pixelbuf_set_pixel(self, index, value);
@@ -312,8 +418,17 @@ void common_hal_adafruit_pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t fill_
     uint8_t w;
     common_hal_adafruit_pixelbuf_pixelbuf_parse_color(self, fill_color, &r, &g, &b, &w);
 
-    for (size_t i = 0; i < self->pixel_count; i++) {
-        common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(self, i, r, g, b, w);
+    // Set the first pixel and copy its bytes to the rest.
+    if (self->pixel_count > 0) {
+        pixelbuf_set_pixel_color(self, 0, r, g, b, w);
+    }
+    size_t bpp = self->bytes_per_pixel;
+    size_t pixel_len = self->pixel_count * bpp;
+    for (size_t i = bpp; i < pixel_len; i += bpp) {
+        memcpy(self->post_brightness_buffer + i, self->post_brightness_buffer, bpp);
+        if (self->pre_brightness_buffer != NULL) {
+            memcpy(self->pre_brightness_buffer + i, self->pre_brightness_buffer, bpp);
+        }
     }
     if (self->auto_write) {
         common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
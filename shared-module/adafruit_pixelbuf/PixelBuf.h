@@ -31,11 +31,15 @@ typedef struct {
     uint16_t scaled_brightness;
     pixelbuf_byteorder_details_t byteorder;
     mp_float_t brightness;
+    mp_float_t gamma;
     mp_obj_t transmit_buffer_obj;
     // The post_brightness_buffer is offset into the buffer allocated in transmit_buffer_obj to
     // account for any header.
     uint8_t *post_brightness_buffer;
     uint8_t *pre_brightness_buffer;
+    // Maps each color value to its output value after gamma and brightness. Allocated along with
+    // pre_brightness_buffer and rebuilt only when brightness or gamma change.
+    uint8_t *scale_lut;
     bool auto_write;
 } pixelbuf_pixelbuf_obj_t;
 
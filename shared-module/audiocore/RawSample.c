@@ -29,6 +29,7 @@ void common_hal_audioio_rawsample_construct(audioio_rawsample_obj_t *self,
     self->base.channel_count = channel_count;
     self->base.sample_rate = sample_rate;
     self->base.single_buffer = single_buffer;
+    self->base.buffer_flags = AUDIOSAMPLE_BUFFER_STABLE;
     self->buffer_index = 0;
 }
 
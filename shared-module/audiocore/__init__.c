@@ -29,6 +29,14 @@ audioio_get_buffer_result_t audiosample_get_buffer(mp_obj_t sample_obj,
     return proto->get_buffer(MP_OBJ_TO_PTR(sample_obj), single_channel_output, channel, buffer, buffer_length);
 }
 
+uint8_t *audiosample_unshare_buffer(uint8_t *output, uint8_t flags, uint8_t *own, uint32_t done) {
+    if (output == own || (flags & AUDIOSAMPLE_BUFFER_WRITABLE)) {
+        return output;
+    }
+    memcpy(own, output, done);
+    return own;
+}
+
 void audiosample_convert_u8m_s16s(int16_t *buffer_out, const uint8_t *buffer_in, size_t nframes) {
     for (; nframes--;) {
         int16_t sample = (*buffer_in++ - 0x80) << 8;
@@ -18,6 +18,18 @@ typedef enum {
     GET_BUFFER_ERROR,           // Error while reading data.
 } audioio_get_buffer_result_t;
 
+// Flags in audiosample_base_t.buffer_flags. A sample sets them when it returns a
+// buffer from get_buffer, so they describe the buffer returned most recently.
+// They let an effect work in its upstream buffer instead of copying it.
+enum {
+    // Every buffer returned has the same length and stays unchanged until
+    // get_buffer has been called twice more, so it may be handed on as it is.
+    AUDIOSAMPLE_BUFFER_STABLE = 1,
+    // Nothing reads the buffer after it has been returned, so the caller may
+    // overwrite it.
+    AUDIOSAMPLE_BUFFER_WRITABLE = 2,
+};
+
 typedef struct audiosample_base {
     mp_obj_base_t self;
     uint32_t sample_rate;
@@ -26,6 +38,7 @@ typedef struct audiosample_base {
     uint8_t channel_count;
     uint8_t samples_signed;
     bool single_buffer;
+    uint8_t buffer_flags;
 } audiosample_base_t;
 
 typedef void (*audiosample_reset_buffer_fun)(mp_obj_t,
@@ -56,6 +69,32 @@ static inline uint8_t audiosample_get_channel_count(audiosample_base_t *self) {
     return self->channel_count;
 }
 
+static inline uint8_t audiosample_get_buffer_flags(mp_obj_t sample_obj) {
+    return ((audiosample_base_t *)MP_OBJ_TO_PTR(sample_obj))->buffer_flags;
+}
+
+// An effect may produce a whole block of block_length samples in the buffer of
+// its upstream sample, which has available samples left, if this returns true.
+// required is AUDIOSAMPLE_BUFFER_STABLE for effects that can pass samples
+// through unchanged, and also AUDIOSAMPLE_BUFFER_WRITABLE for those that always
+// process them.
+static inline bool audiosample_can_share_buffer(uint8_t flags, uint8_t required,
+    uint32_t available, uint32_t block_length) {
+    return (flags & required) == required && available >= block_length;
+}
+
+// Returns the buffer an effect continues its block in before it writes samples
+// that differ from its input. That is output itself, unless output is a shared
+// upstream buffer which may not be written: then the done bytes produced so far
+// are copied to own, and own is returned.
+uint8_t *audiosample_unshare_buffer(uint8_t *output, uint8_t flags, uint8_t *own, uint32_t done);
+
+// The flags of a block an effect produced in output, which is either its own
+// double buffer or shared with an upstream sample that returned upstream_flags.
+static inline uint8_t audiosample_effect_buffer_flags(uint8_t *output, uint8_t *own, uint8_t upstream_flags) {
+    return output == own ? AUDIOSAMPLE_BUFFER_STABLE | AUDIOSAMPLE_BUFFER_WRITABLE : upstream_flags;
+}
+
 void audiosample_reset_buffer(mp_obj_t sample_obj, bool single_channel_output, uint8_t audio_channel);
 audioio_get_buffer_result_t audiosample_get_buffer(mp_obj_t sample_obj,
     bool single_channel_output,
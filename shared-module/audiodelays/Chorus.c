@@ -21,6 +21,7 @@ void common_hal_audiodelays_chorus_construct(audiodelays_chorus_obj_t *self, uin
     self->base.channel_count = channel_count; // Channels can be 1 for mono or 2 for stereo
     self->base.sample_rate = sample_rate; // Sample rate for the effect, this generally needs to match all audio objects
     self->base.single_buffer = false;
+    self->base.buffer_flags = AUDIOSAMPLE_BUFFER_STABLE | AUDIOSAMPLE_BUFFER_WRITABLE;
     self->base.max_buffer_length = buffer_size;
 
     // To smooth things out as CircuitPython is doing other tasks most audio objects have a buffer
@@ -176,6 +177,7 @@ void common_hal_audiodelays_chorus_play(audiodelays_chorus_obj_t *self, mp_obj_t
 
     // Track remaining sample length in terms of bytes per sample
     self->sample_buffer_length /= (self->base.bits_per_sample / 8);
+    self->sample_buffer_flags = audiosample_get_buffer_flags(self->sample);
     // Store if we have more data in the sample to retrieve
     self->more_data = result == GET_BUFFER_MORE_DATA;
 
@@ -196,9 +198,12 @@ audioio_get_buffer_result_t audiodelays_chorus_get_buffer(audiodelays_chorus_obj
     self->last_buf_idx = !self->last_buf_idx;
 
     // If we are using 16 bit samples we need a 16 bit pointer, 8 bit needs an 8 bit pointer
-    int16_t *word_buffer = (int16_t *)self->buffer[self->last_buf_idx];
-    int8_t *hword_buffer = self->buffer[self->last_buf_idx];
-    uint32_t length = self->buffer_len / (self->base.bits_per_sample / 8);
+    uint8_t *own_buffer = (uint8_t *)self->buffer[self->last_buf_idx];
+    uint8_t *output_buffer = own_buffer;
+    int16_t *word_buffer = (int16_t *)output_buffer;
+    int8_t *hword_buffer = (int8_t *)output_buffer;
+    uint32_t block_length = self->buffer_len / (self->base.bits_per_sample / 8);
+    uint32_t length = block_length;
 
     // The chorus buffer is always stored as a 16-bit value internally
     int16_t *chorus_buffer = (int16_t *)self->chorus_buffer;
@@ -221,10 +226,20 @@ audioio_get_buffer_result_t audiodelays_chorus_get_buffer(audiodelays_chorus_obj
                 audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0, (uint8_t **)&self->sample_remaining_buffer, &self->sample_buffer_length);
                 // Track length in terms of words.
                 self->sample_buffer_length /= (self->base.bits_per_sample / 8);
+                self->sample_buffer_flags = audiosample_get_buffer_flags(self->sample);
                 self->more_data = result == GET_BUFFER_MORE_DATA;
             }
         }
 
+        // Process the whole block in place if the upstream buffer allows it
+        if (length == block_length && self->sample != NULL &&
+            audiosample_can_share_buffer(self->sample_buffer_flags, AUDIOSAMPLE_BUFFER_STABLE | AUDIOSAMPLE_BUFFER_WRITABLE,
+                self->sample_buffer_length, length)) {
+            output_buffer = (uint8_t *)self->sample_remaining_buffer;
+            word_buffer = (int16_t *)output_buffer;
+            hword_buffer = (int8_t *)output_buffer;
+        }
+
         // Determine how many bytes we can process to our buffer, the less of the sample we have left and our buffer remaining
         uint32_t n;
         if (self->sample == NULL) {
@@ -333,8 +348,9 @@ audioio_get_buffer_result_t audiodelays_chorus_get_buffer(audiodelays_chorus_obj
     }
 
     // Finally pass our buffer and length to the calling audio function
-    *buffer = (uint8_t *)self->buffer[self->last_buf_idx];
+    *buffer = output_buffer;
     *buffer_length = self->buffer_len;
+    self->base.buffer_flags = audiosample_effect_buffer_flags(output_buffer, own_buffer, self->sample_buffer_flags);
 
     // Chorus always returns more data but some effects may return GET_BUFFER_DONE or GET_BUFFER_ERROR (see audiocore/__init__.h)
     return GET_BUFFER_MORE_DATA;
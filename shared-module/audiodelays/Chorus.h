@@ -27,6 +27,7 @@ typedef struct {
 
     uint8_t *sample_remaining_buffer;
     uint32_t sample_buffer_length;
+    uint8_t sample_buffer_flags;
 
     bool loop;
     bool more_data;
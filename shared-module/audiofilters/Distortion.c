@@ -31,6 +31,7 @@ void common_hal_audiofilters_distortion_construct(audiofilters_distortion_obj_t
     self->base.channel_count = channel_count; // Channels can be 1 for mono or 2 for stereo
     self->base.sample_rate = sample_rate; // Sample rate for the effect, this generally needs to match all audio objects
     self->base.single_buffer = false;
+    self->base.buffer_flags = AUDIOSAMPLE_BUFFER_STABLE | AUDIOSAMPLE_BUFFER_WRITABLE;
     self->base.max_buffer_length = buffer_size;
 
     // To smooth things out as CircuitPython is doing other tasks most audio objects have a buffer
@@ -151,6 +152,7 @@ void common_hal_audiofilters_distortion_play(audiofilters_distortion_obj_t *self
 
     // Track remaining sample length in terms of bytes per sample
     self->sample_buffer_length /= (self->base.bits_per_sample / 8);
+    self->sample_buffer_flags = audiosample_get_buffer_flags(self->sample);
     // Store if we have more data in the sample to retrieve
     self->more_data = result == GET_BUFFER_MORE_DATA;
 
@@ -174,9 +176,12 @@ audioio_get_buffer_result_t audiofilters_distortion_get_buffer(audiofilters_dist
     self->last_buf_idx = !self->last_buf_idx;
 
     // If we are using 16 bit samples we need a 16 bit pointer, 8 bit needs an 8 bit pointer
-    int16_t *word_buffer = (int16_t *)self->buffer[self->last_buf_idx];
-    int8_t *hword_buffer = self->buffer[self->last_buf_idx];
-    uint32_t length = self->buffer_len / (self->base.bits_per_sample / 8);
+    uint8_t *own_buffer = (uint8_t *)self->buffer[self->last_buf_idx];
+    uint8_t *output_buffer = own_buffer;
+    int16_t *word_buffer = (int16_t *)output_buffer;
+    int8_t *hword_buffer = (int8_t *)output_buffer;
+    uint32_t block_length = self->buffer_len / (self->base.bits_per_sample / 8);
+    uint32_t length = block_length;
 
     // Loop over the entire length of our buffer to fill it, this may require several calls to get data from the sample
     while (length != 0) {
@@ -194,10 +199,21 @@ audioio_get_buffer_result_t audiofilters_distortion_get_buffer(audiofilters_dist
                 audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0, (uint8_t **)&self->sample_remaining_buffer, &self->sample_buffer_length);
                 // Track length in terms of words.
                 self->sample_buffer_length /= (self->base.bits_per_sample / 8);
+                self->sample_buffer_flags = audiosample_get_buffer_flags(self->sample);
                 self->more_data = result == GET_BUFFER_MORE_DATA;
             }
         }
 
+        // Produce the whole block in the upstream buffer if it can be handed on,
+        // which avoids copying samples that pass through unchanged
+        if (length == block_length && self->sample != NULL &&
+            audiosample_can_share_buffer(self->sample_buffer_flags, AUDIOSAMPLE_BUFFER_STABLE,
+                self->sample_buffer_length, length)) {
+            output_buffer = (uint8_t *)self->sample_remaining_buffer;
+            word_buffer = (int16_t *)output_buffer;
+            hword_buffer = (int8_t *)output_buffer;
+        }
+
         if (self->sample == NULL) {
             if (self->base.samples_signed) {
                 memset(word_buffer, 0, length * (self->base.bits_per_sample / 8));
@@ -244,14 +260,21 @@ audioio_get_buffer_result_t audiofilters_distortion_get_buffer(audiofilters_dist
             }
 
             if (mix <= MICROPY_FLOAT_CONST(0.01)) { // if mix is zero pure sample only
-                for (uint32_t i = 0; i < n; i++) {
-                    if (MP_LIKELY(self->base.bits_per_sample == 16)) {
-                        word_buffer[i] = sample_src[i];
-                    } else {
-                        hword_buffer[i] = sample_hsrc[i];
+                // A shared upstream buffer already holds these samples
+                if (output_buffer == own_buffer) {
+                    for (uint32_t i = 0; i < n; i++) {
+                        if (MP_LIKELY(self->base.bits_per_sample == 16)) {
+                            word_buffer[i] = sample_src[i];
+                        } else {
+                            hword_buffer[i] = sample_hsrc[i];
+                        }
                     }
                 }
             } else {
+                uint32_t done = block_length - length;
+                output_buffer = audiosample_unshare_buffer(output_buffer, self->sample_buffer_flags, own_buffer, done * (self->base.bits_per_sample / 8));
+                word_buffer = (int16_t *)output_buffer + done;
+                hword_buffer = (int8_t *)output_buffer + done;
                 for (uint32_t i = 0; i < n; i++) {
                     int32_t sample_word = 0;
                     if (MP_LIKELY(self->base.bits_per_sample == 16)) {
@@ -348,8 +371,9 @@ audioio_get_buffer_result_t audiofilters_distortion_get_buffer(audiofilters_dist
     }
 
     // Finally pass our buffer and length to the calling audio function
-    *buffer = (uint8_t *)self->buffer[self->last_buf_idx];
+    *buffer = output_buffer;
     *buffer_length = self->buffer_len;
+    self->base.buffer_flags = audiosample_effect_buffer_flags(output_buffer, own_buffer, self->sample_buffer_flags);
 
     // Distortion always returns more data but some effects may return GET_BUFFER_DONE or GET_BUFFER_ERROR (see audiocore/__init__.h)
     return GET_BUFFER_MORE_DATA;
@@ -12,10 +12,7 @@
 #include "py/runtime.h"
 #include "shared-module/audiocore/__init__.h"
 #include "shared-bindings/audiocore/__init__.h"
-
-#if defined(__arm__) && __arm__
-#include "cmsis_compiler.h"
-#endif
+#include "shared-module/audiomixer/kernels.h"
 
 void common_hal_audiomixer_mixer_construct(audiomixer_mixer_obj_t *self,
     uint8_t voice_count,
@@ -43,6 +40,7 @@ void common_hal_audiomixer_mixer_construct(audiomixer_mixer_obj_t *self,
     self->base.channel_count = channel_count;
     self->base.sample_rate = sample_rate;
     self->base.single_buffer = false;
+    self->base.buffer_flags = AUDIOSAMPLE_BUFFER_STABLE | AUDIOSAMPLE_BUFFER_WRITABLE;
     self->voice_count = voice_count;
     self->base.max_buffer_length = buffer_size;
 }
@@ -70,58 +68,6 @@ void audiomixer_mixer_reset_buffer(audiomixer_mixer_obj_t *self,
     }
 }
 
-__attribute__((always_inline))
-static inline uint32_t add16signed(uint32_t a, uint32_t b) {
-    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
-    return __QADD16(a, b);
-    #else
-    uint32_t result = 0;
-    for (int8_t i = 0; i < 2; i++) {
-        int16_t ai = a >> (sizeof(int16_t) * 8 * i);
-        int16_t bi = b >> (sizeof(int16_t) * 8 * i);
-        int32_t intermediate = (int32_t)ai + bi;
-        if (intermediate > SHRT_MAX) {
-            intermediate = SHRT_MAX;
-        } else if (intermediate < SHRT_MIN) {
-            intermediate = SHRT_MIN;
-        }
-        result |= (((uint32_t)intermediate) & 0xffff) << (sizeof(int16_t) * 8 * i);
-    }
-    return result;
-    #endif
-}
-
-__attribute__((always_inline))
-static inline uint32_t mult16signed(uint32_t val, int32_t mul) {
-    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
-    mul <<= 16;
-    int32_t hi, lo;
-    enum { bits = 16 }; // saturate to 16 bits
-    enum { shift = 15 }; // shift is done automatically
-    asm volatile ("smulwb %0, %1, %2" : "=r" (lo) : "r" (mul), "r" (val));
-    asm volatile ("smulwt %0, %1, %2" : "=r" (hi) : "r" (mul), "r" (val));
-    asm volatile ("ssat %0, %1, %2, asr %3" : "=r" (lo) : "I" (bits), "r" (lo), "I" (shift));
-    asm volatile ("ssat %0, %1, %2, asr %3" : "=r" (hi) : "I" (bits), "r" (hi), "I" (shift));
-    asm volatile ("pkhbt %0, %1, %2, lsl #16" : "=r" (val) : "r" (lo), "r" (hi)); // pack
-    return val;
-    #else
-    uint32_t result = 0;
-    float mod_mul = (float)mul / (float)((1 << 15) - 1);
-    for (int8_t i = 0; i < 2; i++) {
-        int16_t ai = (val >> (sizeof(uint16_t) * 8 * i));
-        int32_t intermediate = (int32_t)(ai * mod_mul);
-        if (intermediate > SHRT_MAX) {
-            intermediate = SHRT_MAX;
-        } else if (intermediate < SHRT_MIN) {
-            intermediate = SHRT_MIN;
-        }
-        intermediate &= 0x0000FFFF;
-        result |= (((uint32_t)intermediate)) << (sizeof(int16_t) * 8 * i);
-    }
-    return result;
-    #endif
-}
-
 static inline uint32_t tounsigned8(uint32_t val) {
     #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
     return __UADD8(val, 0x80808080);
@@ -138,14 +84,6 @@ static inline uint32_t tounsigned16(uint32_t val) {
     #endif
 }
 
-static inline uint32_t tosigned16(uint32_t val) {
-    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
-    return __UADD16(val, 0x80008000);
-    #else
-    return val ^ 0x80008000;
-    #endif
-}
-
 static inline uint32_t unpack8(uint16_t val) {
     return ((val & 0xff00) << 16) | ((val & 0x00ff) << 8);
 }
@@ -192,18 +130,7 @@ static void mix_down_one_voice(audiomixer_mixer_obj_t *self,
         // First active voice gets copied over verbatim.
         if (!voices_active) {
             if (MP_LIKELY(self->base.bits_per_sample == 16)) {
-                if (MP_LIKELY(self->base.samples_signed)) {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t v = src[i];
-                        word_buffer[i] = mult16signed(v, level);
-                    }
-                } else {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t v = src[i];
-                        v = tosigned16(v);
-                        word_buffer[i] = mult16signed(v, level);
-                    }
-                }
+                audiomixer_kernel_scale16(word_buffer, src, n, level, self->base.samples_signed);
             } else {
                 uint16_t *hword_buffer = (uint16_t *)word_buffer;
                 uint16_t *hsrc = (uint16_t *)src;
@@ -218,18 +145,7 @@ static void mix_down_one_voice(audiomixer_mixer_obj_t *self,
             }
         } else {
             if (MP_LIKELY(self->base.bits_per_sample == 16)) {
-                if (MP_LIKELY(self->base.samples_signed)) {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t word = src[i];
-                        word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
-                    }
-                } else {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t word = src[i];
-                        word = tosigned16(word);
-                        word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
-                    }
-                }
+                audiomixer_kernel_mix16(word_buffer, src, n, level, self->base.samples_signed);
             } else {
                 uint16_t *hword_buffer = (uint16_t *)word_buffer;
                 uint16_t *hsrc = (uint16_t *)src;
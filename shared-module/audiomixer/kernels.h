@@ -0,0 +1,173 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2018 Scott Shawcroft for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Sample kernels used by the Mixer. Every 32-bit word holds two signed 16-bit
+// samples (a stereo frame, or two consecutive mono samples). Levels are Q15
+// fractions in the range 0 to 1 << 15 inclusive.
+//
+// One implementation is picked at build time:
+//  - cores with the ARM DSP extension use the packed halfword instructions,
+//  - 64-bit hosts scale with one multiply per word and add four samples at once,
+//  - everything else (e.g. Cortex-M0+) uses plain 32-bit integer arithmetic.
+// None of them use floating point, which is emulated on the smaller cores.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__arm__) && __arm__
+#include "cmsis_compiler.h"
+#endif
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define AUDIOMIXER_KERNEL_DSP (1)
+#define AUDIOMIXER_KERNEL_SWAR64 (0)
+#elif UINTPTR_MAX > 0xffffffff
+#define AUDIOMIXER_KERNEL_DSP (0)
+#define AUDIOMIXER_KERNEL_SWAR64 (1)
+#else
+#define AUDIOMIXER_KERNEL_DSP (0)
+#define AUDIOMIXER_KERNEL_SWAR64 (0)
+#endif
+
+#define AUDIOMIXER_LEVEL_UNITY (1 << 15)
+
+#if AUDIOMIXER_KERNEL_SWAR64
+typedef uint64_t audiomixer_lanes_t;
+#else
+typedef uint32_t audiomixer_lanes_t;
+#endif
+
+// Saturating add of each 16-bit lane. Without DSP instructions this is done
+// for all lanes of a register at once: add the low 15 bits of every lane, fix
+// up the sign bits, then replace the lanes that overflowed.
+__attribute__((always_inline))
+static inline audiomixer_lanes_t add16signed_lanes(audiomixer_lanes_t a, audiomixer_lanes_t b) {
+    const audiomixer_lanes_t sign = (audiomixer_lanes_t)0x8000800080008000ULL;
+    audiomixer_lanes_t sum = ((a & ~sign) + (b & ~sign)) ^ ((a ^ b) & sign);
+    // A lane overflowed if both inputs had the same sign and the result does not.
+    audiomixer_lanes_t overflow = ~(a ^ b) & (a ^ sum) & sign;
+    audiomixer_lanes_t mask = (overflow >> 15) * 0xffff;
+    // 0x7fff for lanes where a was positive, 0x8000 where it was negative.
+    audiomixer_lanes_t limit = ~sign + ((a & sign) >> 15);
+    return (sum & ~mask) | (limit & mask);
+}
+
+__attribute__((always_inline))
+static inline uint32_t add16signed(uint32_t a, uint32_t b) {
+    #if AUDIOMIXER_KERNEL_DSP
+    return __QADD16(a, b);
+    #else
+    return (uint32_t)add16signed_lanes(a, b);
+    #endif
+}
+
+// Scale both samples of val by mul / (1 << 15). The result never needs
+// saturating because mul is at most 1 << 15.
+__attribute__((always_inline))
+static inline uint32_t mult16signed(uint32_t val, int32_t mul) {
+    #if AUDIOMIXER_KERNEL_DSP
+    // Shift by 15 rather than 16 so that unity gain still fits in an int32.
+    mul <<= 15;
+    int32_t hi, lo;
+    enum { bits = 16 }; // saturate to 16 bits
+    enum { shift = 14 }; // smulw already dropped 16 bits
+    asm volatile ("smulwb %0, %1, %2" : "=r" (lo) : "r" (mul), "r" (val));
+    asm volatile ("smulwt %0, %1, %2" : "=r" (hi) : "r" (mul), "r" (val));
+    asm volatile ("ssat %0, %1, %2, asr %3" : "=r" (lo) : "I" (bits), "r" (lo), "I" (shift));
+    asm volatile ("ssat %0, %1, %2, asr %3" : "=r" (hi) : "I" (bits), "r" (hi), "I" (shift));
+    asm volatile ("pkhbt %0, %1, %2, lsl #16" : "=r" (val) : "r" (lo), "r" (hi)); // pack
+    return val;
+    #elif AUDIOMIXER_KERNEL_SWAR64
+    // Spread the samples 32 bits apart and bias them to unsigned, so a single
+    // multiply scales both. The bias is mul << 15 in each product and is
+    // removed by adding 0x10000 - mul (mod 1 << 16) to each lane afterwards.
+    uint64_t x = (((uint64_t)(val >> 16) << 32) | (val & 0xffff)) ^ 0x0000800000008000ULL;
+    uint64_t p = ((x * (uint32_t)mul) >> 15) + (uint64_t)(0x10000 - mul) * 0x100000001ULL;
+    return (uint32_t)(p & 0xffff) | ((uint32_t)(p >> 16) & 0xffff0000);
+    #else
+    int32_t lo = (int16_t)val;
+    int32_t hi = (int16_t)(val >> 16);
+    lo = (lo * mul) >> 15;
+    hi = (hi * mul) >> 15;
+    return ((uint32_t)lo & 0xffff) | ((uint32_t)hi << 16);
+    #endif
+}
+
+static inline uint32_t tosigned16(uint32_t val) {
+    #if AUDIOMIXER_KERNEL_DSP
+    return __UADD16(val, 0x80008000);
+    #else
+    return val ^ 0x80008000;
+    #endif
+}
+
+// dst[i] = src[i] * level, for the first voice mixed into a buffer.
+static inline void audiomixer_kernel_scale16(uint32_t *dst, const uint32_t *src,
+    uint32_t n, uint16_t level, bool samples_signed) {
+    const uint32_t bias = samples_signed ? 0 : 0x80008000;
+    if (level == AUDIOMIXER_LEVEL_UNITY) {
+        if (samples_signed) {
+            memcpy(dst, src, n * sizeof(uint32_t));
+        } else {
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i] = src[i] ^ bias;
+            }
+        }
+        return;
+    }
+    uint32_t i = 0;
+    #if AUDIOMIXER_KERNEL_DSP
+    for (; i + 2 <= n; i += 2) {
+        uint32_t a = src[i], b = src[i + 1];
+        dst[i] = mult16signed(a ^ bias, level);
+        dst[i + 1] = mult16signed(b ^ bias, level);
+    }
+    #endif
+    for (; i < n; i++) {
+        dst[i] = mult16signed(src[i] ^ bias, level);
+    }
+}
+
+// dst[i] = saturate(dst[i] + src[i] * level), for every further voice.
+static inline void audiomixer_kernel_mix16(uint32_t *dst, const uint32_t *src,
+    uint32_t n, uint16_t level, bool samples_signed) {
+    const uint32_t bias = samples_signed ? 0 : 0x80008000;
+    const bool unity = level == AUDIOMIXER_LEVEL_UNITY;
+    uint32_t i = 0;
+    #if AUDIOMIXER_KERNEL_SWAR64
+    for (; i + 2 <= n; i += 2) {
+        uint32_t a = src[i] ^ bias, b = src[i + 1] ^ bias;
+        if (!unity) {
+            a = mult16signed(a, level);
+            b = mult16signed(b, level);
+        }
+        uint64_t acc;
+        memcpy(&acc, dst + i, sizeof(acc));
+        acc = add16signed_lanes(acc, ((uint64_t)b << 32) | a);
+        memcpy(dst + i, &acc, sizeof(acc));
+    }
+    #elif AUDIOMIXER_KERNEL_DSP
+    for (; i + 2 <= n; i += 2) {
+        uint32_t a = src[i] ^ bias, b = src[i + 1] ^ bias;
+        if (!unity) {
+            a = mult16signed(a, level);
+            b = mult16signed(b, level);
+        }
+        dst[i] = add16signed(a, dst[i]);
+        dst[i + 1] = add16signed(b, dst[i + 1]);
+    }
+    #endif
+    for (; i < n; i++) {
+        uint32_t word = src[i] ^ bias;
+        if (!unity) {
+            word = mult16signed(word, level);
+        }
+        dst[i] = add16signed(word, dst[i]);
+    }
+}
@@ -27,6 +27,14 @@
 #include "supervisor/usb.h"
 #endif
 
+#if defined(UNIX)
+#include <stdlib.h>
+#define port_free free
+#define port_malloc(sz, hint) (malloc(sz))
+#else
+#include "supervisor/port_heap.h"
+#endif
+
 #include <stdint.h>
 #include <string.h>
 
@@ -63,6 +71,7 @@ void common_hal_busdisplay_busdisplay_construct(busdisplay_busdisplay_obj_t *sel
 
     self->native_frames_per_second = native_frames_per_second;
     self->native_ms_per_frame = 1000 / native_frames_per_second;
+    self->area_buffers = NULL;
 
     uint32_t i = 0;
     while (i < init_sequence_len) {
@@ -171,7 +180,7 @@ bool common_hal_busdisplay_busdisplay_set_brightness(busdisplay_busdisplay_obj_t
                 self->bus.send(self->bus.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, set_brightness, 2);
             } else {
                 uint8_t command = self->brightness_command;
-                uint8_t hex_brightness = 0xff * brightness;
+                uint8_t hex_brightness = (uint8_t)(0xff * brightness);
                 self->bus.send(self->bus.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &command, 1);
                 self->bus.send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, &hex_brightness, 1);
             }
@@ -189,6 +198,10 @@ mp_obj_t common_hal_busdisplay_busdisplay_get_bus(busdisplay_busdisplay_obj_t *s
     return self->bus.bus;
 }
 
+mp_obj_t common_hal_busdisplay_busdisplay_get_refresh_stats(busdisplay_busdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_stats(&self->core);
+}
+
 mp_obj_t common_hal_busdisplay_busdisplay_get_root_group(busdisplay_busdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
@@ -196,25 +209,74 @@ mp_obj_t common_hal_busdisplay_busdisplay_get_root_group(busdisplay_busdisplay_o
     return self->core.current_group;
 }
 
+// Each area costs a set_region command sequence and a pass over every layer of the group before
+// any pixels are sent. This is roughly what that costs, in pixels sent.
+#define AREA_SETUP_COST (256)
+
 static const displayio_area_t *_get_refresh_areas(busdisplay_busdisplay_obj_t *self) {
     if (self->core.full_refresh) {
         self->core.area.next = NULL;
+        self->core.stats.areas++;
         return &self->core.area;
     } else if (self->core.current_group != NULL) {
-        return displayio_group_get_refresh_areas(self->core.current_group, NULL);
+        const displayio_area_t *areas = displayio_group_get_refresh_areas(self->core.current_group, NULL);
+        return displayio_display_core_coalesce_areas(&self->core, areas, AREA_SETUP_COST);
     }
     return NULL;
 }
 
-static void _send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uint32_t length) {
+static void _send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uint32_t length, bool async) {
     if (!self->bus.data_as_commands) {
         self->bus.send(self->bus.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &self->write_ram_command, 1);
     }
-    self->bus.send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
+    if (async) {
+        self->bus.send_async(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
+    } else {
+        self->bus.send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
+    }
+}
+
+static void _run_background_tasks(void) {
+    // Run background tasks so they can run during an explicit refresh.
+    // Auto-refresh won't run background tasks here because it is a background task itself.
+    RUN_BACKGROUND_TASKS;
+
+    // Run USB background tasks so they can run during an implicit refresh.
+    #if CIRCUITPY_TINYUSB
+    usb_background();
+    #endif
+}
+
+// Areas are rendered into buffers outside the VM heap so that they last as long as the display.
+// They are sized on the first refresh to hold at least one row along the longer side of the
+// display, so an area is never split across its width. When the bus can send in the background, a
+// second buffer is rendered into while the first is sent.
+static bool _allocate_area_buffers(busdisplay_busdisplay_obj_t *self) {
+    if (self->area_buffers != NULL) {
+        return true;
+    }
+    uint32_t row_pixels = MAX(self->core.width, self->core.height);
+    uint32_t row_bytes;
+    if (self->core.colorspace.depth >= 8) {
+        row_bytes = row_pixels * (self->core.colorspace.depth / 8);
+    } else if (self->core.colorspace.pixels_in_byte_share_row) {
+        row_bytes = (row_pixels * self->core.colorspace.depth + 7) / 8;
+    } else {
+        // Each byte holds one column of a byte's worth of rows.
+        row_bytes = row_pixels;
+    }
+    uint32_t length = (MAX(CIRCUITPY_BUSDISPLAY_AREA_BUFFER_SIZE, row_bytes) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    uint8_t count = self->bus.send_async != NULL ? 2 : 1;
+    self->area_buffers = port_malloc(count * length * sizeof(uint32_t), true);
+    if (self->area_buffers == NULL) {
+        return false;
+    }
+    self->area_buffer_length = length;
+    return true;
 }
 
 static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area) {
-    uint16_t buffer_size = 128; // In uint32_ts
+    uint16_t buffer_size = self->area_buffer_length; // In uint32_ts
 
     displayio_area_t clipped;
     // Clip the area to the display by overlapping the areas. If there is no overlap then we're done.
@@ -254,14 +316,18 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
         }
     }
 
-    // Allocated and shared as a uint32_t array so the compiler knows the
-    // alignment everywhere.
-    uint32_t buffer[buffer_size];
+    // When the bus can send in the background, each subrectangle is rendered into one buffer while
+    // the previous one is still being sent from the other.
+    bool ping_pong = self->bus.send_async != NULL && subrectangles > 1;
+
     uint32_t mask_length = (pixels_per_buffer / 32) + 1;
     uint32_t mask[mask_length];
     uint16_t remaining_rows = displayio_area_height(&clipped);
+    // The transaction of the previous subrectangle is still open while its pixels are sent.
+    bool sending = false;
 
     for (uint16_t j = 0; j < subrectangles; j++) {
+        uint32_t *buffer = self->area_buffers + (ping_pong ? j % 2 : 0) * self->area_buffer_length;
         displayio_area_t subrectangle = {
             .x1 = clipped.x1,
             .y1 = clipped.y1 + rows_per_buffer * j,
@@ -273,8 +339,6 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
         }
         remaining_rows -= rows_per_buffer;
 
-        displayio_display_bus_set_region_to_update(&self->bus, &self->core, &subrectangle);
-
         uint16_t subrectangle_size_bytes;
         if (self->core.colorspace.depth >= 8) {
             subrectangle_size_bytes = displayio_area_size(&subrectangle) * (self->core.colorspace.depth / 8);
@@ -287,23 +351,33 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
 
         displayio_display_core_fill_area(&self->core, &subrectangle, mask, buffer);
 
+        if (sending) {
+            displayio_display_bus_end_transaction(&self->bus);
+            sending = false;
+            _run_background_tasks();
+        }
+
+        displayio_display_bus_set_region_to_update(&self->bus, &self->core, &subrectangle);
+
         // Can't acquire display bus; skip the rest of the data.
         if (!displayio_display_bus_is_free(&self->bus)) {
             return false;
         }
 
         displayio_display_bus_begin_transaction(&self->bus);
-        _send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes);
+        _send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes, ping_pong);
+        self->core.stats.pixels_sent += displayio_area_size(&subrectangle);
+        if (ping_pong) {
+            // Finished once the next subrectangle has been rendered.
+            sending = true;
+        } else {
+            displayio_display_bus_end_transaction(&self->bus);
+            _run_background_tasks();
+        }
+    }
+    if (sending) {
         displayio_display_bus_end_transaction(&self->bus);
-
-        // Run background tasks so they can run during an explicit refresh.
-        // Auto-refresh won't run background tasks here because it is a background task itself.
-        RUN_BACKGROUND_TASKS;
-
-        // Run USB background tasks so they can run during an implicit refresh.
-        #if CIRCUITPY_TINYUSB
-        usb_background();
-        #endif
+        _run_background_tasks();
     }
     return true;
 }
@@ -313,6 +387,10 @@ static void _refresh_display(busdisplay_busdisplay_obj_t *self) {
         // A refresh on this bus is already in progress.  Try next display.
         return;
     }
+    if (!_allocate_area_buffers(self)) {
+        // Nothing to render into. Try again later.
+        return;
+    }
     displayio_display_core_start_refresh(&self->core);
     const displayio_area_t *current_area = _get_refresh_areas(self);
     while (current_area != NULL) {
@@ -413,6 +491,8 @@ void release_busdisplay(busdisplay_busdisplay_obj_t *self) {
     #else
     common_hal_digitalio_digitalinout_deinit(&self->backlight_inout);
     #endif
+    port_free(self->area_buffers);
+    self->area_buffers = NULL;
 }
 
 void reset_busdisplay(busdisplay_busdisplay_obj_t *self) {
@@ -27,10 +27,12 @@ typedef struct {
         #endif
     };
     uint64_t last_refresh_call;
+    uint32_t *area_buffers; // One or two buffers of area_buffer_length, allocated on first refresh
     mp_float_t current_brightness;
     uint16_t brightness_command;
     uint16_t native_frames_per_second;
     uint16_t native_ms_per_frame;
+    uint16_t area_buffer_length; // In uint32_ts
     uint8_t write_ram_command;
     bool auto_refresh;
     bool first_manual_refresh;
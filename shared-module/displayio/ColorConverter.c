@@ -11,15 +11,18 @@
 
 #define NO_TRANSPARENT_COLOR (0x1000000)
 
-uint32_t displayio_colorconverter_dither_noise_1(uint32_t n) {
-    n = (n >> 13) ^ n;
-    int nn = (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
-    return (uint32_t)(((float)nn / (1073741824.0f * 2)) * 255);
-}
-
-uint32_t displayio_colorconverter_dither_noise_2(uint32_t x, uint32_t y) {
-    return displayio_colorconverter_dither_noise_1(x + y * 0xFFFF);
-}
+// An 8x8 ordered (Bayer) dither matrix. Each entry is a threshold from 0 to 63
+// that is scaled to the number of bits a channel loses when it's converted.
+static const uint8_t dither_matrix[8][8] = {
+    { 0, 32, 8, 40, 2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44, 4, 36, 14, 46, 6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43, 1, 33, 9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47, 7, 39, 13, 45, 5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
 
 void common_hal_displayio_colorconverter_construct(displayio_colorconverter_t *self, bool dither, displayio_colorspace_t input_colorspace) {
     self->dither = dither;
@@ -53,7 +56,9 @@ uint8_t displayio_colorconverter_compute_luma(uint32_t color_rgb888) {
     uint32_t r8 = (color_rgb888 >> 16);
     uint32_t g8 = (color_rgb888 >> 8) & 0xff;
     uint32_t b8 = color_rgb888 & 0xff;
-    return (r8 * 19 + g8 * 182 + b8 * 54) / 255;
+    // Same as dividing the sum, which is at most 255 * 255, by 255.
+    uint32_t sum = r8 * 19 + g8 * 182 + b8 * 54;
+    return (sum + 1 + (sum >> 8)) >> 8;
 }
 
 uint8_t displayio_colorconverter_compute_chroma(uint32_t color_rgb888) {
@@ -303,23 +308,22 @@ uint32_t displayio_colorconverter_convert_pixel(displayio_colorspace_t colorspac
 void displayio_convert_color(const _displayio_colorspace_t *colorspace, bool dither, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color) {
     uint32_t pixel = input_pixel->pixel;
     if (dither) {
-        uint8_t randr = (displayio_colorconverter_dither_noise_2(input_pixel->tile_x, input_pixel->tile_y));
-        uint8_t randg = (displayio_colorconverter_dither_noise_2(input_pixel->tile_x + 33, input_pixel->tile_y));
-        uint8_t randb = (displayio_colorconverter_dither_noise_2(input_pixel->tile_x, input_pixel->tile_y + 33));
+        uint32_t threshold = dither_matrix[input_pixel->tile_y % 8][input_pixel->tile_x % 8];
 
         uint32_t r8 = (pixel >> 16);
         uint32_t g8 = (pixel >> 8) & 0xff;
         uint32_t b8 = pixel & 0xff;
 
         if (colorspace->depth == 16) {
-            b8 = MIN(255, b8 + (randb & 0x07));
-            r8 = MIN(255, r8 + (randr & 0x07));
-            g8 = MIN(255, g8 + (randg & 0x03));
+            b8 = MIN(255, b8 + (threshold >> 3));
+            r8 = MIN(255, r8 + (threshold >> 3));
+            g8 = MIN(255, g8 + (threshold >> 4));
         } else {
-            int bitmask = 0xFF >> colorspace->depth;
-            b8 = MIN(255, b8 + (randb & bitmask));
-            r8 = MIN(255, r8 + (randr & bitmask));
-            g8 = MIN(255, g8 + (randg & bitmask));
+            uint32_t bitmask = 0xFF >> colorspace->depth;
+            uint32_t offset = (threshold * (bitmask + 1)) >> 6;
+            b8 = MIN(255, b8 + offset);
+            r8 = MIN(255, r8 + offset);
+            g8 = MIN(255, g8 + offset);
         }
         pixel = r8 << 16 | g8 << 8 | b8;
     }
@@ -400,7 +404,89 @@ void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _d
     }
 }
 
+// Converting between the 16-bit RGB colorspaces loses nothing, so it just
+// rearranges bits. Returns false if the conversion isn't one of those.
+static bool rgb565_reorder_for(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, bool *swap_in, bool *bgr) {
+    if (colorspace->depth != 16 || self->dither) {
+        return false;
+    }
+    switch (self->input_colorspace) {
+        case DISPLAYIO_COLORSPACE_RGB565:
+            *swap_in = false;
+            *bgr = false;
+            return true;
+        case DISPLAYIO_COLORSPACE_RGB565_SWAPPED:
+            *swap_in = true;
+            *bgr = false;
+            return true;
+        case DISPLAYIO_COLORSPACE_BGR565:
+            *swap_in = false;
+            *bgr = true;
+            return true;
+        case DISPLAYIO_COLORSPACE_BGR565_SWAPPED:
+            *swap_in = true;
+            *bgr = true;
+            return true;
+        default:
+            return false;
+    }
+}
+
+void displayio_colorconverter_convert_row(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, uint32_t *pixels, size_t count, uint16_t x, uint16_t y) {
+    uint32_t transparent_color = self->transparent_color;
+    bool swap_in = false, bgr = false;
+    bool reorder = rgb565_reorder_for(self, colorspace, &swap_in, &bgr);
+    bool swap_out = colorspace->reverse_bytes_in_word;
 
+    displayio_input_pixel_t input_pixel;
+    input_pixel.x = input_pixel.y = input_pixel.tile = 0;
+    input_pixel.tile_y = y;
+    displayio_output_pixel_t output_pixel;
+    // Neighboring pixels are often the same color, unless they're dithered. The transparent color
+    // is handled first so it can stand for no previous pixel.
+    uint32_t last_input = transparent_color;
+    uint32_t last_output = DISPLAYIO_COLORCONVERTER_TRANSPARENT;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t pixel = pixels[i];
+        if (pixel == transparent_color) {
+            pixels[i] = DISPLAYIO_COLORCONVERTER_TRANSPARENT;
+            continue;
+        }
+        // Values that don't fit in 16 bits take the long way so they convert exactly as before.
+        if (reorder && pixel <= 0xffff) {
+            uint16_t packed = pixel;
+            if (swap_in) {
+                packed = __builtin_bswap16(packed);
+            }
+            if (bgr) {
+                packed = (packed >> 11) | (packed & 0x07e0) | (packed << 11);
+            }
+            if (swap_out) {
+                packed = __builtin_bswap16(packed);
+            }
+            pixels[i] = packed;
+            continue;
+        }
+        if (pixel == last_input) {
+            pixels[i] = last_output;
+            continue;
+        }
+        input_pixel.pixel = displayio_colorconverter_convert_pixel(self->input_colorspace, pixel);
+        input_pixel.tile_x = x + i;
+        output_pixel.pixel = 0;
+        output_pixel.opaque = false;
+        displayio_convert_color(colorspace, self->dither, &input_pixel, &output_pixel);
+        pixels[i] = output_pixel.opaque ? output_pixel.pixel : DISPLAYIO_COLORCONVERTER_TRANSPARENT;
+        if (!self->dither) {
+            last_input = pixel;
+            last_output = pixels[i];
+        }
+    }
+}
+
+bool displayio_colorconverter_is_opaque(displayio_colorconverter_t *self) {
+    return self->transparent_color == NO_TRANSPARENT_COLOR;
+}
 
 // Currently no refresh logic is needed for a ColorConverter.
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self) {
@@ -26,11 +26,18 @@ typedef struct displayio_colorconverter {
 } displayio_colorconverter_t;
 
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self);
+// True when no transparent color is set so every converted pixel is opaque.
+bool displayio_colorconverter_is_opaque(displayio_colorconverter_t *self);
 void displayio_colorconverter_finish_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
 
-uint32_t displayio_colorconverter_dither_noise_1(uint32_t n);
-uint32_t displayio_colorconverter_dither_noise_2(uint32_t x, uint32_t y);
+// Never a valid output color, because outputs have at most 24 bits.
+#define DISPLAYIO_COLORCONVERTER_TRANSPARENT (0xffffffff)
+
+// Converts count pixels of one row in place. x and y are the bitmap coordinates of the first
+// pixel, which place it in the dither pattern. Transparent pixels become
+// DISPLAYIO_COLORCONVERTER_TRANSPARENT.
+void displayio_colorconverter_convert_row(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, uint32_t *pixels, size_t count, uint16_t x, uint16_t y);
 
 // Convert version that doesn't require a colorconverter object.
 void displayio_convert_color(const _displayio_colorspace_t *colorspace, bool dither, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
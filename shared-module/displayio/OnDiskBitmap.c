@@ -158,8 +158,90 @@ void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self,
         self->stride = (bit_stride / 8);
     }
 
+    // Cache as many whole rows as fit in the configured size, but at least one. A size of zero
+    // disables the cache, and then every pixel is read on its own.
+    self->row_cache = NULL;
+    self->cache_rows = 0;
+    self->cache_first_row = -1;
+    if (CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHE_SIZE > 0 && self->stride > 0) {
+        uint32_t cache_rows = MAX(1, MIN(CIRCUITPY_DISPLAYIO_ONDISKBITMAP_CACHE_SIZE / self->stride, self->height));
+        self->row_cache = m_malloc_maybe_without_collect(cache_rows * self->stride);
+        if (self->row_cache != NULL) {
+            self->cache_rows = cache_rows;
+        }
+    }
+}
+
+
+// Returns the offset of the byte that holds pixel x within a row.
+static uint32_t pixel_offset(displayio_ondiskbitmap_t *self, int16_t x) {
+    uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel / 8) : 1;
+    uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
+    if (pixels_per_byte == 0) {
+        return x * bytes_per_pixel;
+    }
+    return x / pixels_per_byte;
+}
+
+// Decodes pixel x from the file data that starts with the byte holding it.
+static uint32_t decode_pixel(displayio_ondiskbitmap_t *self, const uint8_t *data, int16_t x) {
+    uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel / 8) : 1;
+    uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
+    uint32_t pixel_data = 0;
+    for (uint8_t i = 0; i < bytes_per_pixel; i++) {
+        pixel_data |= data[i] << (8 * i);
+    }
+
+    uint32_t tmp = 0;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    if (bytes_per_pixel == 1) {
+        uint8_t offset = (x % pixels_per_byte) * self->bits_per_pixel;
+        uint8_t mask = (1 << self->bits_per_pixel) - 1;
+
+        return (pixel_data >> ((8 - self->bits_per_pixel) - offset)) & mask;
+    } else if (bytes_per_pixel == 2) {
+        if (self->g_bitmask == 0x07e0) { // 565
+            red = ((pixel_data & self->r_bitmask) >> 11);
+            green = ((pixel_data & self->g_bitmask) >> 5);
+            blue = ((pixel_data & self->b_bitmask) >> 0);
+        } else { // 555
+            red = ((pixel_data & self->r_bitmask) >> 10);
+            green = ((pixel_data & self->g_bitmask) >> 4);
+            blue = ((pixel_data & self->b_bitmask) >> 0);
+        }
+        tmp = (red << 19 | green << 10 | blue << 3);
+        return tmp;
+    } else if ((bytes_per_pixel == 4) && (self->bitfield_compressed)) {
+        return pixel_data & 0x00FFFFFF;
+    } else {
+        return pixel_data;
+    }
 }
 
+// Returns the raw data of row y, which must be within the bitmap. The rows are read from the file
+// in aligned blocks so that rendering in either direction reuses them.
+static const uint8_t *get_row(displayio_ondiskbitmap_t *self, int16_t y) {
+    int16_t first = y - y % self->cache_rows;
+    uint16_t rows = MIN(self->cache_rows, self->height - first);
+    if (first != self->cache_first_row) {
+        // Rows are stored bottom up so the last row of the block is first in the file.
+        uint32_t location = self->data_offset + (self->height - first - rows) * self->stride;
+        uint32_t size = rows * self->stride;
+        UINT bytes_read = 0;
+        self->cache_first_row = first;
+        if (f_lseek(&self->file->fp, location) != FR_OK ||
+            f_read(&self->file->fp, self->row_cache, size, &bytes_read) != FR_OK) {
+            // Try again next time.
+            self->cache_first_row = -1;
+            bytes_read = 0;
+        }
+        // Anything that couldn't be read is black, as it was when reading single pixels.
+        memset(self->row_cache + bytes_read, 0, size - bytes_read);
+    }
+    return self->row_cache + (first + rows - 1 - y) * self->stride;
+}
 
 uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *self,
     int16_t x, int16_t y) {
@@ -167,48 +249,37 @@ uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *s
         return 0;
     }
 
-    uint32_t location;
-    uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel / 8) : 1;
-    uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
-    if (pixels_per_byte == 0) {
-        location = self->data_offset + (self->height - y - 1) * self->stride + x * bytes_per_pixel;
-    } else {
-        location = self->data_offset + (self->height - y - 1) * self->stride + x / pixels_per_byte;
+    if (self->row_cache != NULL) {
+        return decode_pixel(self, get_row(self, y) + pixel_offset(self, x), x);
     }
-    // We don't cache here because the underlying FS caches sectors.
+
+    // Without a cache, read just the bytes of the pixel.
+    uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel / 8) : 1;
+    uint32_t location = self->data_offset + (self->height - y - 1) * self->stride + pixel_offset(self, x);
     f_lseek(&self->file->fp, location);
     UINT bytes_read;
-    uint32_t pixel_data = 0;
-    uint32_t result = f_read(&self->file->fp, &pixel_data, bytes_per_pixel, &bytes_read);
-    if (result == FR_OK) {
-        uint32_t tmp = 0;
-        uint8_t red;
-        uint8_t green;
-        uint8_t blue;
-        if (bytes_per_pixel == 1) {
-            uint8_t offset = (x % pixels_per_byte) * self->bits_per_pixel;
-            uint8_t mask = (1 << self->bits_per_pixel) - 1;
-
-            return (pixel_data >> ((8 - self->bits_per_pixel) - offset)) & mask;
-        } else if (bytes_per_pixel == 2) {
-            if (self->g_bitmask == 0x07e0) { // 565
-                red = ((pixel_data & self->r_bitmask) >> 11);
-                green = ((pixel_data & self->g_bitmask) >> 5);
-                blue = ((pixel_data & self->b_bitmask) >> 0);
-            } else { // 555
-                red = ((pixel_data & self->r_bitmask) >> 10);
-                green = ((pixel_data & self->g_bitmask) >> 4);
-                blue = ((pixel_data & self->b_bitmask) >> 0);
-            }
-            tmp = (red << 19 | green << 10 | blue << 3);
-            return tmp;
-        } else if ((bytes_per_pixel == 4) && (self->bitfield_compressed)) {
-            return pixel_data & 0x00FFFFFF;
+    uint8_t pixel_data[4] = {0};
+    if (f_read(&self->file->fp, pixel_data, bytes_per_pixel, &bytes_read) != FR_OK) {
+        return 0;
+    }
+    return decode_pixel(self, pixel_data, x);
+}
+
+void displayio_ondiskbitmap_read_row(displayio_ondiskbitmap_t *self, int16_t x, int16_t y, uint32_t *pixels, size_t count) {
+    if (self->row_cache == NULL || y < 0 || y >= self->height) {
+        for (size_t i = 0; i < count; i++) {
+            pixels[i] = common_hal_displayio_ondiskbitmap_get_pixel(self, x + i, y);
+        }
+        return;
+    }
+    const uint8_t *row = get_row(self, y);
+    for (size_t i = 0; i < count; i++, x++) {
+        if (x < 0 || x >= self->width) {
+            pixels[i] = 0;
         } else {
-            return pixel_data;
+            pixels[i] = decode_pixel(self, row + pixel_offset(self, x), x);
         }
     }
-    return 0;
 }
 
 uint16_t common_hal_displayio_ondiskbitmap_get_height(displayio_ondiskbitmap_t *self) {
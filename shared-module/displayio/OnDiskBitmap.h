@@ -28,6 +28,15 @@ typedef struct {
         struct displayio_palette *palette;
         struct displayio_colorconverter *colorconverter;
     };
+    // Consecutive rows of raw pixel data, starting at cache_first_row. Rows are read from the file
+    // cache_rows at a time so that rendering doesn't seek and read for every pixel.
+    uint8_t *row_cache;
+    int16_t cache_first_row;
+    uint16_t cache_rows;
     bool bitfield_compressed;
     uint8_t bits_per_pixel;
 } displayio_ondiskbitmap_t;
+
+// Reads count pixels of row y starting at column x, decoded the same way as
+// common_hal_displayio_ondiskbitmap_get_pixel.
+void displayio_ondiskbitmap_read_row(displayio_ondiskbitmap_t *self, int16_t x, int16_t y, uint32_t *pixels, size_t count);
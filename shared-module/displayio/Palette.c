@@ -11,6 +11,7 @@
 void common_hal_displayio_palette_construct(displayio_palette_t *self, uint16_t color_count, bool dither) {
     self->color_count = color_count;
     self->colors = (_displayio_color_t *)m_malloc_without_collect(color_count * sizeof(_displayio_color_t));
+    self->transparent_count = 0;
     self->dither = dither;
 }
 
@@ -23,11 +24,17 @@ bool common_hal_displayio_palette_get_dither(displayio_palette_t *self) {
 }
 
 void common_hal_displayio_palette_make_opaque(displayio_palette_t *self, uint32_t palette_index) {
+    if (self->colors[palette_index].transparent) {
+        self->transparent_count--;
+    }
     self->colors[palette_index].transparent = false;
     self->needs_refresh = true;
 }
 
 void common_hal_displayio_palette_make_transparent(displayio_palette_t *self, uint32_t palette_index) {
+    if (!self->colors[palette_index].transparent) {
+        self->transparent_count++;
+    }
     self->colors[palette_index].transparent = true;
     self->needs_refresh = true;
 }
@@ -83,6 +90,10 @@ void displayio_palette_get_color(displayio_palette_t *self, const _displayio_col
     }
 }
 
+bool displayio_palette_is_opaque(displayio_palette_t *self) {
+    return self->transparent_count == 0;
+}
+
 bool displayio_palette_needs_refresh(displayio_palette_t *self) {
     return self->needs_refresh;
 }
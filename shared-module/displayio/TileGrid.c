@@ -425,6 +425,204 @@ void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint
     self->full_change = true;
 }
 
+// Opaque TileGrids draw every pixel they overlap so nothing underneath them is visible.
+static bool _tilegrid_is_opaque(displayio_tilegrid_t *self) {
+    if (self->pixel_shader == mp_const_none) {
+        return true;
+    }
+    if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        return displayio_colorconverter_is_opaque(self->pixel_shader);
+    }
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type) &&
+        mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+        displayio_palette_t *palette = self->pixel_shader;
+        displayio_bitmap_t *bitmap = self->bitmap;
+        // Bitmap values past the end of the palette are transparent.
+        return displayio_palette_is_opaque(palette) &&
+               bitmap->bits_per_value < 32 &&
+               (1u << bitmap->bits_per_value) <= palette->color_count;
+    }
+    return false;
+}
+
+static bool _mask_is_clear(const uint32_t *mask, uint32_t pixel_count) {
+    for (uint32_t i = 0; i < (pixel_count + 31) / 32; i++) {
+        if (mask[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The span renderer handles the most common case of an unscaled, untransposed Bitmap or
+// OnDiskBitmap with an optional Palette or ColorConverter being rendered into a 16-bit buffer.
+// Everything else uses the generic per-pixel loop in displayio_tilegrid_fill_area.
+static bool _can_fill_span_16bit(displayio_tilegrid_t *self, const _displayio_colorspace_t *colorspace) {
+    return colorspace->depth == 16 &&
+           self->absolute_transform->scale == 1 &&
+           self->transpose_xy == self->absolute_transform->transpose_xy &&
+           (mp_obj_is_type(self->bitmap, &displayio_bitmap_type) ||
+               mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type)) &&
+           (self->pixel_shader == mp_const_none ||
+               mp_obj_is_type(self->pixel_shader, &displayio_palette_type) ||
+               mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type));
+}
+
+// Renders the given (already transformed) tile grid coordinates into the buffer. Each row is split
+// into runs that share a single tile so the tile lookup is only done once per run. The mask is
+// read and written a 32-bit word at a time and fully covered words are skipped entirely. When
+// mask_clear is set the mask isn't read, and when occludes is set it isn't written.
+static bool _fill_area_span_16bit(displayio_tilegrid_t *self,
+    const _displayio_colorspace_t *colorspace, void *tiles, int16_t start,
+    int16_t start_x, int16_t end_x, int16_t start_y, int16_t end_y,
+    int16_t x_shift, int16_t y_shift, int16_t y_stride, bool full_coverage,
+    bool occludes, bool mask_clear, uint32_t *mask, uint16_t *buffer) {
+    displayio_bitmap_t *bitmap = NULL;
+    displayio_ondiskbitmap_t *ondisk = NULL;
+    if (mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type)) {
+        ondisk = self->bitmap;
+    } else {
+        bitmap = self->bitmap;
+    }
+    displayio_palette_t *palette = NULL;
+    displayio_colorconverter_t *converter = NULL;
+    if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        converter = self->pixel_shader;
+    } else if (self->pixel_shader != mp_const_none) {
+        palette = self->pixel_shader;
+    }
+    bool wide_tiles = self->tiles_in_bitmap > 255;
+
+    // A ColorConverter converts all of the pixels up to the end of the run or mask word at once.
+    // OnDiskBitmaps are always read that way, which takes one call rather than one per pixel.
+    uint32_t converted[32];
+    int16_t converted_start = 0;
+
+    // Neighboring pixels usually share a palette index so remember the last lookup.
+    uint32_t last_index = 0xffffffff;
+    uint16_t last_color = 0;
+    bool last_opaque = false;
+
+    displayio_input_pixel_t input_pixel;
+    displayio_output_pixel_t output_pixel;
+
+    for (input_pixel.y = start_y; input_pixel.y < end_y; ++input_pixel.y) {
+        int32_t offset = start + (input_pixel.y - start_y + y_shift) * y_stride + x_shift;
+        uint16_t y_tile_index = (input_pixel.y / self->tile_height + self->top_left_y) % self->height_in_tiles;
+        uint16_t tile_row = input_pixel.y % self->tile_height;
+        uint16_t *tile_row_base = ((uint16_t *)tiles) + y_tile_index * self->width_in_tiles;
+        uint8_t *tile_row_base8 = ((uint8_t *)tiles) + y_tile_index * self->width_in_tiles;
+
+        uint32_t mask_index = offset / 32;
+        uint32_t mask_bits = mask_clear ? 0 : mask[mask_index];
+
+        input_pixel.x = start_x;
+        while (input_pixel.x < end_x) {
+            // Skip the rest of a mask word that's already fully set.
+            if (mask_bits == 0xffffffff) {
+                if (!occludes) {
+                    mask[mask_index] = mask_bits;
+                }
+                int16_t skip = 32 - (offset % 32);
+                input_pixel.x += skip;
+                offset += skip;
+                if (input_pixel.x < end_x) {
+                    mask_index = offset / 32;
+                    mask_bits = mask_clear ? 0 : mask[mask_index];
+                }
+                continue;
+            }
+
+            // Resolve the tile once for the run of pixels that share it.
+            uint16_t x_tile_index = (input_pixel.x / self->tile_width + self->top_left_x) % self->width_in_tiles;
+            if (wide_tiles) {
+                input_pixel.tile = tile_row_base[x_tile_index];
+            } else {
+                input_pixel.tile = tile_row_base8[x_tile_index];
+            }
+            int16_t run_end = input_pixel.x + (self->tile_width - input_pixel.x % self->tile_width);
+            if (run_end > end_x) {
+                run_end = end_x;
+            }
+            int32_t tile_x_base = (input_pixel.tile % self->bitmap_width_in_tiles) * self->tile_width + input_pixel.x % self->tile_width - input_pixel.x;
+            input_pixel.tile_y = (input_pixel.tile / self->bitmap_width_in_tiles) * self->tile_height + tile_row;
+
+            if (converter != NULL || ondisk != NULL) {
+                int16_t count = MIN(run_end - input_pixel.x, 32 - offset % 32);
+                if (ondisk != NULL) {
+                    displayio_ondiskbitmap_read_row(ondisk, tile_x_base + input_pixel.x, input_pixel.tile_y, converted, count);
+                } else {
+                    for (int16_t i = 0; i < count; i++) {
+                        converted[i] = common_hal_displayio_bitmap_get_pixel(bitmap, tile_x_base + input_pixel.x + i, input_pixel.tile_y);
+                    }
+                }
+                if (converter != NULL) {
+                    displayio_colorconverter_convert_row(converter, colorspace, converted, count, tile_x_base + input_pixel.x, input_pixel.tile_y);
+                }
+                converted_start = input_pixel.x;
+            }
+
+            while (input_pixel.x < run_end) {
+                uint32_t bit = 1u << (offset % 32);
+                if ((mask_bits & bit) == 0) {
+                    input_pixel.tile_x = tile_x_base + input_pixel.x;
+                    if (converter != NULL) {
+                        output_pixel.pixel = converted[input_pixel.x - converted_start];
+                        output_pixel.opaque = output_pixel.pixel != DISPLAYIO_COLORCONVERTER_TRANSPARENT;
+                    } else {
+                        if (ondisk != NULL) {
+                            input_pixel.pixel = converted[input_pixel.x - converted_start];
+                        } else {
+                            input_pixel.pixel = common_hal_displayio_bitmap_get_pixel(bitmap, input_pixel.tile_x, input_pixel.tile_y);
+                        }
+                        if (palette == NULL) {
+                            output_pixel.pixel = input_pixel.pixel;
+                            output_pixel.opaque = true;
+                        } else if (input_pixel.pixel == last_index) {
+                            output_pixel.pixel = last_color;
+                            output_pixel.opaque = last_opaque;
+                        } else {
+                            output_pixel.opaque = true;
+                            displayio_palette_get_color(palette, colorspace, &input_pixel, &output_pixel);
+                            // Dithered colors depend on the position so they can't be reused.
+                            if (!palette->dither) {
+                                last_index = input_pixel.pixel;
+                                last_color = output_pixel.pixel;
+                                last_opaque = output_pixel.opaque;
+                            }
+                        }
+                    }
+                    if (!output_pixel.opaque) {
+                        // A pixel is transparent so we haven't fully covered the area ourselves.
+                        full_coverage = false;
+                    } else {
+                        mask_bits |= bit;
+                        buffer[offset] = output_pixel.pixel;
+                    }
+                }
+                input_pixel.x++;
+                offset++;
+                if (offset % 32 == 0) {
+                    // Move on to the next mask word and restart the run so that a fully set word
+                    // can be skipped.
+                    if (!occludes) {
+                        mask[mask_index] = mask_bits;
+                    }
+                    if (input_pixel.x < end_x) {
+                        mask_index++;
+                        mask_bits = mask_clear ? 0 : mask[mask_index];
+                    }
+                    break;
+                }
+            }
+        }
+        if (!occludes) {
+            mask[mask_index] = mask_bits;
+        }
+    }
+    return full_coverage;
+}
+
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     const _displayio_colorspace_t *colorspace, const displayio_area_t *area,
     uint32_t *mask, uint32_t *buffer) {
@@ -473,11 +671,11 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     // layers at that point.
     bool full_coverage = displayio_area_equal(area, &overlap);
 
-    // TODO(tannewt): Skip coverage tracking if all pixels outside the overlap have already been
-    // set and our palette is all opaque.
+    // An opaque layer that covers the whole area is the last one drawn into it, so the mask only
+    // needs to be read to avoid overwriting layers above us. If nothing above has drawn yet, we
+    // don't need to look at the mask at all.
+    bool occludes = full_coverage && _tilegrid_is_opaque(self);
 
-    // TODO(tannewt): Check to see if the pixel_shader has any transparency. If it doesn't then we
-    // can either return full coverage or bulk update the mask.
     displayio_area_t transformed;
     displayio_area_transform_within(flip_x != (self->absolute_transform->dx < 0), flip_y != (self->absolute_transform->dy < 0), self->transpose_xy != self->absolute_transform->transpose_xy,
         &overlap,
@@ -512,6 +710,13 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
         y_shift = temp_shift;
     }
 
+    bool mask_clear = occludes && _mask_is_clear(mask, displayio_area_size(area));
+
+    if (x_stride == 1 && _can_fill_span_16bit(self, colorspace)) {
+        return _fill_area_span_16bit(self, colorspace, tiles, start, start_x, end_x, start_y, end_y,
+            x_shift, y_shift, y_stride, full_coverage, occludes, mask_clear, mask, (uint16_t *)buffer);
+    }
+
     displayio_input_pixel_t input_pixel;
     displayio_output_pixel_t output_pixel;
 
@@ -528,7 +733,7 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
             // }
 
             // Check the mask first to see if the pixel has already been set.
-            if ((mask[offset / 32] & (1 << (offset % 32))) != 0) {
+            if (!mask_clear && (mask[offset / 32] & (1 << (offset % 32))) != 0) {
                 continue;
             }
             int16_t local_x = input_pixel.x / self->absolute_transform->scale;
@@ -572,7 +777,9 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
                 // A pixel is transparent so we haven't fully covered the area ourselves.
                 full_coverage = false;
             } else {
-                mask[offset / 32] |= 1 << (offset % 32);
+                if (!occludes) {
+                    mask[offset / 32] |= 1 << (offset % 32);
+                }
                 if (colorspace->depth == 16) {
                     *(((uint16_t *)buffer) + offset) = output_pixel.pixel;
                 } else if (colorspace->depth == 32) {
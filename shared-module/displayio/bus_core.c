@@ -17,6 +17,9 @@
 #if CIRCUITPY_PARALLELDISPLAYBUS
 #include "shared-bindings/paralleldisplaybus/ParallelBus.h"
 #endif
+#ifdef CIRCUITPY_DISPLAYIO_UNIX
+#include "simulated_display_bus.h"
+#endif
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
@@ -48,6 +51,7 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
     self->always_toggle_chip_select = always_toggle_chip_select;
     self->SH1107_addressing = SH1107_addressing;
     self->address_little_endian = address_little_endian;
+    self->send_async = NULL;
 
     #if CIRCUITPY_PARALLELDISPLAYBUS
     if (mp_obj_is_type(bus, &paralleldisplaybus_parallelbus_type)) {
@@ -55,6 +59,9 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
         self->bus_free = common_hal_paralleldisplaybus_parallelbus_bus_free;
         self->begin_transaction = common_hal_paralleldisplaybus_parallelbus_begin_transaction;
         self->send = common_hal_paralleldisplaybus_parallelbus_send;
+        #if CIRCUITPY_PARALLELDISPLAYBUS_HAVE_SEND_ASYNC
+        self->send_async = common_hal_paralleldisplaybus_parallelbus_send_async;
+        #endif
         self->end_transaction = common_hal_paralleldisplaybus_parallelbus_end_transaction;
         self->collect_ptrs = common_hal_paralleldisplaybus_parallelbus_collect_ptrs;
     } else
@@ -79,6 +86,20 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
         self->collect_ptrs = common_hal_i2cdisplaybus_i2cdisplaybus_collect_ptrs;
     } else
     #endif
+    #ifdef CIRCUITPY_DISPLAYIO_UNIX
+    if (mp_obj_is_type(bus, &simulated_display_bus_type)) {
+        simulated_display_bus_obj_t *simulated_bus = MP_OBJ_TO_PTR(bus);
+        self->bus_reset = simulated_display_bus_reset;
+        self->bus_free = simulated_display_bus_bus_free;
+        self->begin_transaction = simulated_display_bus_begin_transaction;
+        self->send = simulated_display_bus_send;
+        if (simulated_bus->asynchronous) {
+            self->send_async = simulated_display_bus_send_async;
+        }
+        self->end_transaction = simulated_display_bus_end_transaction;
+        self->collect_ptrs = simulated_display_bus_collect_ptrs;
+    } else
+    #endif
     {
         mp_raise_ValueError(MP_ERROR_TEXT("Unsupported display bus type"));
     }
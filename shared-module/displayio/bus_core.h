@@ -20,6 +20,10 @@ typedef struct {
     display_bus_bus_free bus_free;
     display_bus_begin_transaction begin_transaction;
     display_bus_send send;
+    // NULL if the bus can only send while the CPU waits. The next area is rendered while a
+    // transaction is open, so buses that may share their pins with other devices (such as an SD
+    // card holding an OnDiskBitmap) shouldn't provide it.
+    display_bus_send_async send_async;
     display_bus_end_transaction end_transaction;
     display_bus_collect_ptrs collect_ptrs;
     uint16_t ram_width;
@@ -33,6 +33,7 @@ void displayio_display_core_construct(displayio_display_core_t *self,
     self->colorspace.dither = false;
     self->current_group = NULL;
     self->last_refresh = 0;
+    memset(&self->stats, 0, sizeof(self->stats));
 
     supervisor_start_terminal(width, height);
 
@@ -169,8 +170,18 @@ void displayio_display_core_collect_ptrs(displayio_display_core_t *self) {
     gc_collect_ptr(self->current_group);
 }
 
+mp_obj_t displayio_display_core_get_refresh_stats(displayio_display_core_t *self) {
+    mp_obj_t items[] = {
+        mp_obj_new_int_from_ull(self->stats.areas),
+        mp_obj_new_int_from_ull(self->stats.pixels_composited),
+        mp_obj_new_int_from_ull(self->stats.pixels_sent),
+    };
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+}
+
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     if (self->current_group != NULL) {
+        self->stats.pixels_composited += displayio_area_size(area);
         return displayio_group_fill_area(self->current_group, &self->colorspace, area, mask, buffer);
     }
     return false;
@@ -203,3 +214,67 @@ bool displayio_display_core_clip_area(displayio_display_core_t *self, const disp
     }
     return true;
 }
+
+// How much cheaper refreshing a and b as one area is than refreshing them separately. Overlapping
+// pixels count twice when they are separate because they are rendered twice.
+static int32_t _merge_savings(const displayio_area_t *a, const displayio_area_t *b, uint32_t setup_cost) {
+    displayio_area_t u;
+    displayio_area_union(a, b, &u);
+    return (int32_t)(displayio_area_size(a) + displayio_area_size(b) + setup_cost) - (int32_t)displayio_area_size(&u);
+}
+
+// Merges the pair of areas that saves the most. Returns false without merging if no pair saves
+// anything, unless force is set.
+static bool _merge_best_pair(displayio_area_t *areas, size_t *count, uint32_t setup_cost, bool force) {
+    size_t best_i = 0, best_j = 0;
+    int32_t best_savings = INT32_MIN;
+    for (size_t i = 0; i < *count; i++) {
+        for (size_t j = i + 1; j < *count; j++) {
+            int32_t savings = _merge_savings(&areas[i], &areas[j], setup_cost);
+            if (savings > best_savings) {
+                best_savings = savings;
+                best_i = i;
+                best_j = j;
+            }
+        }
+    }
+    if (best_i == best_j || (best_savings <= 0 && !force)) {
+        return false;
+    }
+    displayio_area_union(&areas[best_i], &areas[best_j], &areas[best_i]);
+    (*count)--;
+    areas[best_j] = areas[*count];
+    return true;
+}
+
+const displayio_area_t *displayio_display_core_coalesce_areas(displayio_display_core_t *self,
+    const displayio_area_t *areas, uint32_t setup_cost) {
+    displayio_area_t *coalesced = self->refresh_areas;
+    size_t count = 0;
+    for (const displayio_area_t *area = areas; area != NULL; area = area->next) {
+        displayio_area_t clipped;
+        if (!displayio_display_core_clip_area(self, area, &clipped)) {
+            continue;
+        }
+        if (count == CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT) {
+            // Make room by merging, even if it means drawing more.
+            _merge_best_pair(coalesced, &count, setup_cost, count > 1);
+            if (count == CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT) {
+                displayio_area_union(&coalesced[0], &clipped, &coalesced[0]);
+                continue;
+            }
+        }
+        displayio_area_copy(&clipped, &coalesced[count]);
+        count++;
+    }
+    while (_merge_best_pair(coalesced, &count, setup_cost, false)) {
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        coalesced[i].next = i + 1 < count ? &coalesced[i + 1] : NULL;
+    }
+    self->stats.areas += count;
+    DISPLAYIO_CORE_DEBUG("displayiocore %d areas, %d pixels composited, %d sent\n",
+        (int)self->stats.areas, (int)self->stats.pixels_composited, (int)self->stats.pixels_sent);
+    return count > 0 ? coalesced : NULL;
+}
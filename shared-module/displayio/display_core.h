@@ -13,6 +13,14 @@
 
 #define NO_COMMAND 0x100
 
+// Running totals that show how much work refreshes take. They are 64 bits wide so that they don't
+// wrap while a display refreshes continuously.
+typedef struct {
+    uint64_t areas; // Areas refreshed, after coalescing.
+    uint64_t pixels_composited; // Pixels rendered from the group tree.
+    uint64_t pixels_sent; // Pixels sent to the display or copied to the framebuffer.
+} displayio_display_core_stats_t;
+
 typedef struct {
     displayio_group_t *current_group;
     uint64_t last_refresh;
@@ -22,6 +30,8 @@ typedef struct {
     uint16_t height;
     uint16_t rotation;
     _displayio_colorspace_t colorspace;
+    displayio_area_t refresh_areas[CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT];
+    displayio_display_core_stats_t stats;
 
     bool full_refresh; // New group means we need to refresh the whole display.
     bool refresh_in_progress;
@@ -48,6 +58,16 @@ void displayio_display_core_finish_refresh(displayio_display_core_t *self);
 
 void displayio_display_core_collect_ptrs(displayio_display_core_t *self);
 
+// Returns the refresh totals as a tuple of (areas, pixels_composited, pixels_sent).
+mp_obj_t displayio_display_core_get_refresh_stats(displayio_display_core_t *self);
+
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t *area, uint32_t *mask, uint32_t *buffer);
 
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t *area, displayio_area_t *clipped);
+
+// Clips the given list of dirty areas to the display and merges them where refreshing the union
+// costs less than refreshing them separately. setup_cost is what refreshing one more area costs,
+// in pixels. Returns a list of at most CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT areas that is valid
+// until the next call.
+const displayio_area_t *displayio_display_core_coalesce_areas(displayio_display_core_t *self,
+    const displayio_area_t *areas, uint32_t setup_cost);
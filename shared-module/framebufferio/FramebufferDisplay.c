@@ -105,12 +105,18 @@ mp_obj_t common_hal_framebufferio_framebufferdisplay_get_framebuffer(framebuffer
     return self->framebuffer;
 }
 
+// Each area costs a pass over every layer of the group before any pixels are drawn. This is
+// roughly what that costs, in pixels drawn.
+#define AREA_SETUP_COST (64)
+
 static const displayio_area_t *_get_refresh_areas(framebufferio_framebufferdisplay_obj_t *self) {
     if (self->core.full_refresh) {
         self->core.area.next = NULL;
+        self->core.stats.areas++;
         return &self->core.area;
     } else if (self->core.current_group != NULL) {
-        return displayio_group_get_refresh_areas(self->core.current_group, NULL);
+        const displayio_area_t *areas = displayio_group_get_refresh_areas(self->core.current_group, NULL);
+        return displayio_display_core_coalesce_areas(&self->core, areas, AREA_SETUP_COST);
     }
     return NULL;
 }
@@ -200,6 +206,7 @@ static bool _refresh_area(framebufferio_framebufferdisplay_obj_t *self, const di
             dest += rowstride;
             src += rowsize;
         }
+        self->core.stats.pixels_sent += displayio_area_size(&subrectangle);
         // Run background tasks so they can run during an explicit refresh.
         // Auto-refresh won't run background tasks here because it is a background task itself.
         RUN_BACKGROUND_TASKS;
@@ -335,6 +342,10 @@ void framebufferio_framebufferdisplay_reset(framebufferio_framebufferdisplay_obj
     }
 }
 
+mp_obj_t common_hal_framebufferio_framebufferdisplay_get_refresh_stats(framebufferio_framebufferdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_stats(&self->core);
+}
+
 mp_obj_t common_hal_framebufferio_framebufferdisplay_get_root_group(framebufferio_framebufferdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
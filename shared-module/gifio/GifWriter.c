@@ -16,7 +16,10 @@
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/util.h"
 
-#define BLOCK_SIZE (126) // (2^7) - 2 // (DO NOT CHANGE!)
+// Palette index that marks a pixel as unchanged from the previous frame.
+#define TRANSPARENT_INDEX (128)
+
+#define LZW_MAX_CODE (4095)
 
 static void handle_error(gifio_gifwriter_t *self) {
     if (self->error != 0) {
@@ -24,20 +27,36 @@ static void handle_error(gifio_gifwriter_t *self) {
     }
 }
 
+static void write_to_file(gifio_gifwriter_t *self, size_t size) {
+    int error = 0;
+    self->file_proto->write(self->file, self->data, size, &error);
+    if (error != 0) {
+        self->error = error;
+    }
+}
+
 static void flush_data(gifio_gifwriter_t *self) {
     if (self->cur == 0) {
         return;
     }
-    int error = 0;
-    self->file_proto->write(self->file, self->data, self->cur, &error);
+    write_to_file(self, self->cur);
     self->cur = 0;
-    if (error != 0) {
-        self->error = error;
+}
+
+// Writes out whole 512 byte sectors if there isn't room for size more bytes.
+// Must not be called while a data sub-block is open.
+static void make_room(gifio_gifwriter_t *self, size_t size) {
+    if (self->cur + size <= self->size) {
+        return;
     }
+    size_t sectors = self->cur & ~511;
+    write_to_file(self, sectors);
+    self->cur -= sectors;
+    memmove(self->data, self->data + sectors, self->cur);
 }
 
 // These "write" calls _MUST_ have enough buffer space available!  This is
-// ensured by allocating the proper buffer size in construct.
+// ensured by calling make_room first.
 static void write_data(gifio_gifwriter_t *self, const void *data, size_t size) {
     assert(self->cur + size <= self->size);
     memcpy(self->data + self->cur, data, size);
@@ -48,15 +67,33 @@ static void write_byte(gifio_gifwriter_t *self, uint8_t value) {
     write_data(self, &value, sizeof(value));
 }
 
-static void write_long(gifio_gifwriter_t *self, uint32_t value) {
+static void write_word(gifio_gifwriter_t *self, uint16_t value) {
     write_data(self, &value, sizeof(value));
 }
 
-static void write_word(gifio_gifwriter_t *self, uint16_t value) {
-    write_data(self, &value, sizeof(value));
+static void start_block(gifio_gifwriter_t *self) {
+    make_room(self, 256);
+    self->block_start = self->cur++;
+}
+
+static void end_block(gifio_gifwriter_t *self) {
+    size_t length = self->cur - self->block_start - 1;
+    if (length == 0) {
+        self->cur--;
+    } else {
+        self->data[self->block_start] = length;
+    }
+}
+
+static inline void write_block_byte(gifio_gifwriter_t *self, uint8_t value) {
+    if (self->cur == self->block_start + 256) {
+        end_block(self);
+        start_block(self);
+    }
+    self->data[self->cur++] = value;
 }
 
-void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *file, int width, int height, displayio_colorspace_t colorspace, bool loop, bool dither, bool own_file) {
+void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *file, int width, int height, displayio_colorspace_t colorspace, bool loop, bool dither, bool delta, bool own_file) {
     self->file = file;
     self->file_proto = mp_get_stream_raise(file, MP_STREAM_OP_WRITE | MP_STREAM_OP_IOCTL);
     if (self->file_proto->is_text) {
@@ -66,18 +103,26 @@ void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *
     self->height = height;
     self->colorspace = colorspace;
     self->dither = dither;
+    self->delta = delta;
+    self->have_previous = false;
     self->own_file = own_file;
 
-    size_t nblocks = (width * height + 125) / 126;
-    self->size = nblocks * 128 + 4;
+    self->size = GIFWRITER_BUFFER_SIZE;
     self->data = m_malloc_without_collect(self->size);
     self->cur = 0;
+    self->block_start = 0;
     self->error = 0;
+    self->lzw_table = NULL;
+    self->lzw_table_size = 0;
+    self->row = m_malloc_without_collect(width);
+    self->previous = delta ? m_malloc_without_collect(width * height) : NULL;
 
     write_data(self, "GIF89a", 6);
     write_word(self, width);
     write_word(self, height);
-    write_data(self, (uint8_t []) {0xF6, 0x00, 0x00}, 3);
+    // A global color table of 128 entries, or 256 with delta to make room
+    // for the transparent index.
+    write_data(self, (uint8_t []) {delta ? 0xF7 : 0xF6, 0x00, 0x00}, 3);
 
     switch (colorspace) {
         case DISPLAYIO_COLORSPACE_RGB565:
@@ -113,15 +158,17 @@ void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *
             write_data(self, (uint8_t []) {gray, gray, gray}, 3);
         }
     }
+    if (delta) {
+        for (int i = 128; i < 256; i++) {
+            write_data(self, (uint8_t []) {0, 0, 0}, 3);
+        }
+    }
 
     if (loop) {
         write_data(self, (uint8_t []) {'!', 0xFF, 0x0B}, 3);
         write_data(self, "NETSCAPE2.0", 11);
         write_data(self, (uint8_t []) {0x03, 0x01, 0x00, 0x00, 0x00}, 5);
     }
-
-    flush_data(self);
-    handle_error(self);
 }
 
 bool shared_module_gifio_gifwriter_deinited(gifio_gifwriter_t *self) {
@@ -154,101 +201,244 @@ static const uint8_t g_bayer[4][4] = {
     {31, 14, 26, 10}
 };
 
-void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
-    if (delay) {
-        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, 0x04}, 4);
-        write_word(self, delay);
-        write_word(self, 0); // end
+// Converts row y of the frame to palette indices.
+static void convert_row(gifio_gifwriter_t *self, const void *buf, int y, uint8_t *out) {
+    int width = self->width;
+    if (self->colorspace == DISPLAYIO_COLORSPACE_L8) {
+        const uint8_t *pixels = (const uint8_t *)buf + y * width;
+        for (int x = 0; x < width; x++) {
+            out[x] = pixels[x] >> 1;
+        }
+    } else if (!self->dither) {
+        const uint16_t *pixels = (const uint16_t *)buf + y * width;
+        for (int x = 0; x < width; x++) {
+            int pixel = pixels[x];
+            if (self->byteswap) {
+                pixel = __builtin_bswap16(pixel);
+            }
+            int red = (pixel >> (11 + (5 - 2))) & 0x3;
+            int green = (pixel >> (5 + (6 - 3))) & 0x7;
+            int blue = (pixel >> (0 + (5 - 2))) & 0x3;
+            out[x] = (red << 5) | (green << 2) | blue;
+        }
+    } else {
+        const uint16_t *pixels = (const uint16_t *)buf + y * width;
+        for (int x = 0; x < width; x++) {
+            int pixel = pixels[x];
+            if (self->byteswap) {
+                pixel = __builtin_bswap16(pixel);
+            }
+            int red = (pixel >> 8) & 0xf8;
+            int green = (pixel >> 3) & 0xfc;
+            int blue = (pixel << 3) & 0xf8;
+
+            red = MAX(0, red - rb_bayer[x % 4][y % 4]);
+            green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
+            blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
+
+            out[x] = ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+        }
     }
+}
 
-    write_byte(self, 0x2C);
-    write_long(self, 0);
-    write_word(self, self->width);
-    write_word(self, self->height);
-    write_data(self, (uint8_t []) {0x00, 0x07}, 2); // 7-bits
+// GIF's variant of LZW: codes start one bit wider than the palette indices
+// and grow to at most 12 bits, and the dictionary is cleared when it fills.
+typedef struct {
+    gifio_gifwriter_t *writer;
+    uint32_t bit_buffer;
+    int bit_count;
+    int code_bits;
+    int clear_code;
+    int next_code;
+    // The code for the pixels seen so far that are in the dictionary, or -1.
+    int prefix;
+} lzw_encoder_t;
+
+static void lzw_write_code(lzw_encoder_t *lzw, int code) {
+    lzw->bit_buffer |= (uint32_t)code << lzw->bit_count;
+    lzw->bit_count += lzw->code_bits;
+    while (lzw->bit_count >= 8) {
+        write_block_byte(lzw->writer, lzw->bit_buffer);
+        lzw->bit_buffer >>= 8;
+        lzw->bit_count -= 8;
+    }
+    // The decoder adds a dictionary entry after each code but lags one code
+    // behind, so it widens its codes when next_code (as it was before this
+    // code's entry) no longer fits.
+    if (lzw->next_code >= (1 << lzw->code_bits) && lzw->code_bits < 12) {
+        lzw->code_bits++;
+    }
+}
 
-    int pixel_count = self->width * self->height;
-    int blocks = (pixel_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+static void lzw_clear(lzw_encoder_t *lzw) {
+    lzw_write_code(lzw, lzw->clear_code);
+    memset(lzw->writer->lzw_table, 0, lzw->writer->lzw_table_size * sizeof(uint32_t));
+    lzw->next_code = lzw->clear_code + 2;
+    lzw->code_bits = __builtin_ctz(lzw->clear_code) + 1;
+}
 
-    uint8_t *data = self->data + self->cur;
+// Primes that keep the table at most 80% full; the last one holds every code.
+static const uint16_t lzw_table_sizes[] = { 83, 163, 331, 641, 1283, 2557, GIFWRITER_LZW_TABLE_SIZE_MAX };
 
-    if (self->colorspace == DISPLAYIO_COLORSPACE_L8) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(pixel_count - 1), false);
-
-        uint8_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            assert(pixel_count >= 0);
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                *data++ = (*pixels++) >> 1;
-            }
+static void lzw_allocate_table(gifio_gifwriter_t *self) {
+    // A frame of n pixels adds at most n - 1 codes before the table is cleared.
+    int codes = MIN(self->width * self->height, LZW_MAX_CODE);
+    size_t i = 0;
+    while (lzw_table_sizes[i] * 4 < codes * 5 && i < MP_ARRAY_SIZE(lzw_table_sizes) - 1) {
+        i++;
+    }
+    self->lzw_table_size = lzw_table_sizes[i];
+    self->lzw_table = m_malloc_without_collect(self->lzw_table_size * sizeof(uint32_t));
+}
+
+static void lzw_start(lzw_encoder_t *lzw, gifio_gifwriter_t *self, int min_code_size) {
+    if (self->lzw_table == NULL) {
+        lzw_allocate_table(self);
+    }
+    lzw->writer = self;
+    lzw->bit_buffer = 0;
+    lzw->bit_count = 0;
+    lzw->clear_code = 1 << min_code_size;
+    lzw->code_bits = min_code_size + 1;
+    lzw->next_code = lzw->clear_code + 2;
+    lzw->prefix = -1;
+    write_byte(self, min_code_size);
+    start_block(self);
+    lzw_clear(lzw);
+}
+
+static void lzw_encode(lzw_encoder_t *lzw, const uint8_t *pixels, int count) {
+    uint32_t *table = lzw->writer->lzw_table;
+    uint32_t table_size = lzw->writer->lzw_table_size;
+    int i = 0;
+    if (lzw->prefix < 0 && count > 0) {
+        lzw->prefix = pixels[i++];
+    }
+    int prefix = lzw->prefix;
+    for (; i < count; i++) {
+        uint8_t pixel = pixels[i];
+        // Each entry holds the 20 bit key (prefix, pixel) above its 12 bit
+        // code. Codes are never 0, so 0 marks an empty slot.
+        uint32_t key = (prefix << 8) | pixel;
+        uint32_t h = (((key * 2654435761u) >> 16) * table_size) >> 16;
+        uint32_t step = h == 0 ? 1 : table_size - h;
+        uint32_t entry;
+        while ((entry = table[h]) != 0 && (entry >> 12) != key) {
+            h = h >= step ? h - step : h + table_size - step;
         }
-    } else if (!self->dither) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
-                }
-                int red = (pixel >> (11 + (5 - 2))) & 0x3;
-                int green = (pixel >> (5 + (6 - 3))) & 0x7;
-                int blue = (pixel >> (0 + (5 - 2))) & 0x3;
-                *data++ = (red << 5) | (green << 2) | blue;
-            }
+        if (entry != 0) {
+            prefix = entry & 0xfff;
+            continue;
         }
-    } else {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        int x = 0, y = 0;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
-                }
-                int red = (pixel >> 8) & 0xf8;
-                int green = (pixel >> 3) & 0xfc;
-                int blue = (pixel << 3) & 0xf8;
+        lzw_write_code(lzw, prefix);
+        prefix = pixel;
+        if (lzw->next_code >= LZW_MAX_CODE) {
+            lzw_clear(lzw);
+        } else {
+            table[h] = (key << 12) | lzw->next_code++;
+        }
+    }
+    lzw->prefix = prefix;
+}
 
-                red = MAX(0, red - rb_bayer[x % 4][y % 4]);
-                green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
-                blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
-                x++;
-                if (x == self->width) {
-                    x = 0;
-                    y++;
-                }
+static void lzw_finish(lzw_encoder_t *lzw) {
+    if (lzw->prefix >= 0) {
+        lzw_write_code(lzw, lzw->prefix);
+    }
+    lzw_write_code(lzw, lzw->clear_code + 1);
+    if (lzw->bit_count > 0) {
+        write_block_byte(lzw->writer, lzw->bit_buffer);
+    }
+    end_block(lzw->writer);
+    make_room(lzw->writer, 1);
+    write_byte(lzw->writer, 0);
+}
 
-                *data++ = ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
+    int pixel_count = self->width * self->height;
+    int bytes_per_pixel = self->colorspace == DISPLAYIO_COLORSPACE_L8 ? 1 : 2;
+    mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(bytes_per_pixel * pixel_count - 1), false);
+
+    // With delta, only the bounding box of the pixels that changed since the
+    // previous frame is encoded, and unchanged pixels inside it are
+    // transparent.
+    int x0 = 0, y0 = 0, x1 = self->width, y1 = self->height;
+    bool transparent = self->delta && self->have_previous;
+    if (transparent) {
+        x0 = self->width;
+        y0 = self->height;
+        x1 = 0;
+        y1 = 0;
+        for (int y = 0; y < self->height; y++) {
+            convert_row(self, bufinfo->buf, y, self->row);
+            const uint8_t *previous = self->previous + y * self->width;
+            int x = 0;
+            while (x < self->width && self->row[x] == previous[x]) {
+                x++;
+            }
+            if (x == self->width) {
+                continue;
+            }
+            int last = self->width - 1;
+            while (self->row[last] == previous[last]) {
+                last--;
             }
+            x0 = MIN(x0, x);
+            x1 = MAX(x1, last + 1);
+            y0 = MIN(y0, y);
+            y1 = y + 1;
+        }
+        if (y1 == 0) {
+            // Nothing changed. A frame is still needed for its delay.
+            x0 = 0;
+            y0 = 0;
+            x1 = 1;
+            y1 = 1;
         }
     }
 
-    self->cur = data - self->data;
+    make_room(self, 32);
+    if (delay || self->delta) {
+        // Disposal method 1 leaves each frame in place under the next one.
+        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, self->delta ? 0x05 : 0x04}, 4);
+        write_word(self, delay);
+        write_data(self, (uint8_t []) {self->delta ? TRANSPARENT_INDEX : 0, 0x00}, 2); // end
+    }
 
-    write_data(self, (uint8_t []) {0x01, 0x81, 0x00}, 3); // end code
-    flush_data(self);
+    write_byte(self, 0x2C);
+    write_word(self, x0);
+    write_word(self, y0);
+    write_word(self, x1 - x0);
+    write_word(self, y1 - y0);
+    write_byte(self, 0x00);
+
+    lzw_encoder_t lzw;
+    lzw_start(&lzw, self, self->delta ? 8 : 7);
+    for (int y = y0; y < y1; y++) {
+        uint8_t *row = self->row;
+        convert_row(self, bufinfo->buf, y, row);
+        if (self->delta) {
+            uint8_t *previous = self->previous + y * self->width;
+            for (int x = x0; x < x1; x++) {
+                uint8_t index = row[x];
+                if (transparent && index == previous[x]) {
+                    row[x] = TRANSPARENT_INDEX;
+                } else {
+                    previous[x] = index;
+                }
+            }
+        }
+        lzw_encode(&lzw, row + x0, x1 - x0);
+    }
+    self->have_previous = true;
+    lzw_finish(&lzw);
+
+    make_room(self, self->size);
     handle_error(self);
 }
 
 void shared_module_gifio_gifwriter_close(gifio_gifwriter_t *self) {
+    make_room(self, 1);
     write_byte(self, ';');
     flush_data(self);
 
@@ -10,6 +10,16 @@
 #include "py/stream.h"
 #include "shared-bindings/displayio/__init__.h"
 
+// Output is buffered and written to the file in multiples of 512 bytes, so
+// that writes to a filesystem stay sector aligned.
+#define GIFWRITER_BUFFER_SIZE (2048)
+
+// The LZW dictionary is a hash table of 32 bit entries, allocated by the
+// first frame. Its size is a prime a bit larger than the number of codes a
+// frame can add, so probe sequences stay short: about 20kB once frames have
+// 2048 pixels or more, and less for smaller frames.
+#define GIFWRITER_LZW_TABLE_SIZE_MAX (5003)
+
 typedef struct gifio_gifwriter {
     mp_obj_base_t base;
     mp_obj_t *file;
@@ -19,7 +29,17 @@ typedef struct gifio_gifwriter {
     int error;
     uint8_t *data;
     size_t cur, size;
+    // Position of the length byte of the data sub-block being written.
+    size_t block_start;
+    uint32_t *lzw_table;
+    uint16_t lzw_table_size;
+    // Palette indices of the row being encoded.
+    uint8_t *row;
+    // With delta, the palette indices of the whole previous frame.
+    uint8_t *previous;
     bool own_file;
     bool byteswap;
     bool dither;
+    bool delta;
+    bool have_previous;
 } gifio_gifwriter_t;
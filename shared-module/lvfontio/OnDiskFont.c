@@ -38,6 +38,14 @@ static inline void *allocate_memory(lvfontio_ondiskfont_t *self, size_t size) {
     return NULL;
 }
 
+// Like allocate_memory, but for optional data that the font can do without.
+static inline void *try_allocate_memory(lvfontio_ondiskfont_t *self, size_t size) {
+    if (self->use_gc_allocator) {
+        return m_malloc_maybe(size);
+    }
+    return port_malloc(size, false);
+}
+
 static inline void free_memory(lvfontio_ondiskfont_t *self, void *ptr) {
     if (self->use_gc_allocator) {
         m_free(ptr);
@@ -46,11 +54,31 @@ static inline void free_memory(lvfontio_ondiskfont_t *self, void *ptr) {
     }
 }
 
+// Glyph data is read a bit field at a time, either from a glyph record in memory or a byte at a
+// time from the file when data is NULL.
+typedef struct {
+    FIL *file;
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    uint8_t byte_val;
+    uint8_t remaining_bits;
+} bit_reader_t;
+
+static void bit_reader_init(bit_reader_t *reader, FIL *file, const uint8_t *data, size_t len) {
+    reader->file = file;
+    reader->data = data;
+    reader->len = len;
+    reader->pos = 0;
+    reader->byte_val = 0;
+    reader->remaining_bits = 0;
+}
+
 // Forward declarations for helper functions
 static int16_t find_codepoint_slot(lvfontio_ondiskfont_t *self, uint32_t codepoint);
-static uint16_t find_free_slot(lvfontio_ondiskfont_t *self, uint32_t codepoint);
-static FRESULT read_bits(FIL *file, size_t num_bits, uint8_t *byte_val, uint8_t *remaining_bits, uint32_t *result);
-static FRESULT read_glyph_dimensions(FIL *file, lvfontio_ondiskfont_t *self, uint32_t *advance_width, int32_t *bbox_x, int32_t *bbox_y, uint32_t *bbox_w, uint32_t *bbox_h, uint8_t *byte_val, uint8_t *remaining_bits);
+static uint16_t find_free_slot(lvfontio_ondiskfont_t *self, uint32_t codepoint, uint16_t slots_needed);
+static FRESULT read_bits(bit_reader_t *reader, size_t num_bits, uint32_t *result);
+static FRESULT read_glyph_dimensions(bit_reader_t *reader, lvfontio_ondiskfont_t *self, uint32_t *advance_width, int32_t *bbox_x, int32_t *bbox_y, uint32_t *bbox_w, uint32_t *bbox_h);
 
 // Load font header data from file
 static bool load_font_header(lvfontio_ondiskfont_t *self, FIL *file, size_t *max_slots) {
@@ -144,6 +172,8 @@ static bool load_font_header(lvfontio_ondiskfont_t *self, FIL *file, size_t *max
             if (self->cmap_ranges == NULL) {
                 return false;
             }
+            // Ranges that can't be used stay empty so that no codepoint matches them.
+            memset(self->cmap_ranges, 0, sizeof(lvfontio_cmap_range_t) * subtable_count);
 
             // Read each subtable
             for (uint16_t i = 0; i < subtable_count; i++) {
@@ -200,6 +230,7 @@ static bool load_font_header(lvfontio_ondiskfont_t *self, FIL *file, size_t *max
         } else if (memcmp(buffer, "glyf", 4) == 0) {
             // Store start of glyf table
             self->glyf_table_offset = current_position;
+            self->glyf_table_size = section_size;
             size_t advances[2] = {0, 0};
             size_t advance_count[2] = {0, 0};
 
@@ -216,14 +247,14 @@ static bool load_font_header(lvfontio_ondiskfont_t *self, FIL *file, size_t *max
                 int32_t bbox_x, bbox_y;
                 uint32_t bbox_w, bbox_h;
 
-                uint8_t byte_val = 0;
-                uint8_t remaining_bits = 0;
+                bit_reader_t reader;
+                bit_reader_init(&reader, file, NULL, 0);
 
                 // Use the helper function to read glyph dimensions
-                read_glyph_dimensions(file, self, &glyph_advance, &bbox_x, &bbox_y, &bbox_w, &bbox_h, &byte_val, &remaining_bits);
+                read_glyph_dimensions(&reader, self, &glyph_advance, &bbox_x, &bbox_y, &bbox_w, &bbox_h);
 
                 // Throw away the bitmap bits.
-                read_bits(file, self->header.bits_per_pixel * bbox_w * bbox_h, &byte_val, &remaining_bits, NULL);
+                read_bits(&reader, self->header.bits_per_pixel * bbox_w * bbox_h, NULL);
                 if (advances[0] == glyph_advance) {
                     advance_count[0]++;
                 } else if (advances[1] == glyph_advance) {
@@ -281,6 +312,156 @@ static bool load_font_header(lvfontio_ondiskfont_t *self, FIL *file, size_t *max
     return true;
 }
 
+static uint32_t read_le(const uint8_t *buf, size_t len) {
+    uint32_t value = 0;
+    for (size_t i = len; i > 0; i--) {
+        value = (value << 8) | buf[i - 1];
+    }
+    return value;
+}
+
+static bool read_at(lvfontio_ondiskfont_t *self, uint32_t offset, void *buf, size_t len) {
+    UINT bytes_read;
+    return f_lseek(&self->file, offset) == FR_OK &&
+        f_read(&self->file, buf, len, &bytes_read) == FR_OK && bytes_read == len;
+}
+
+// Whether the codepoints of a format 3 range are in increasing order. The converter always sorts
+// them, but only then can they be binary searched, so check rather than give wrong glyphs.
+static bool cmap_range_is_sorted(lvfontio_ondiskfont_t *self, const lvfontio_cmap_range_t *range) {
+    uint8_t buf[64];
+    uint32_t previous = 0;
+    for (size_t i = 0; i < range->entries_count; i += sizeof(buf) / 2) {
+        size_t count = MIN(sizeof(buf) / 2, range->entries_count - i);
+        const uint8_t *entries = buf;
+        if (range->data != NULL) {
+            entries = range->data + 2 * i;
+        } else if (!read_at(self, range->data_offset + 2 * i, buf, 2 * count)) {
+            return false;
+        }
+        for (size_t j = 0; j < count; j++) {
+            uint32_t codepoint_delta = read_le(entries + 2 * j, 2);
+            if (i + j > 0 && codepoint_delta <= previous) {
+                return false;
+            }
+            previous = codepoint_delta;
+        }
+    }
+    return true;
+}
+
+// The size of the largest glyph record, from the loca table in memory or in the file.
+static uint32_t largest_glyph_record(lvfontio_ondiskfont_t *self) {
+    size_t entry_size = self->header.index_to_loc_format == 1 ? 4 : 2;
+    uint8_t buf[64];
+    uint32_t largest = 0;
+    uint32_t previous = 0;
+    for (uint32_t i = 0; i < self->max_cid; i += sizeof(buf) / entry_size) {
+        uint32_t count = MIN(sizeof(buf) / entry_size, self->max_cid - i);
+        const uint8_t *entries = buf;
+        if (self->glyph_offsets != NULL) {
+            entries = self->glyph_offsets + i * entry_size;
+        } else if (!read_at(self, self->loca_table_offset + i * entry_size, buf, count * entry_size)) {
+            return 0;
+        }
+        for (uint32_t j = 0; j < count; j++) {
+            uint32_t offset = read_le(entries + j * entry_size, entry_size);
+            if (i + j > 0 && offset > previous) {
+                largest = MAX(largest, offset - previous);
+            }
+            previous = offset;
+        }
+    }
+    if (self->max_cid > 0 && self->glyf_table_size > previous) {
+        largest = MAX(largest, self->glyf_table_size - previous);
+    }
+    return largest;
+}
+
+// Reads the tables that map codepoints to glyphs and glyphs to file offsets into memory, so that
+// looking up a glyph doesn't need the file. This is optional: tables that don't fit in cache_size
+// are read from the file as they are needed. What is left of cache_size goes to glyph records,
+// whether or not the tables fit.
+static void load_index(lvfontio_ondiskfont_t *self, size_t cache_size) {
+    for (uint16_t i = 0; i < self->cmap_range_count; i++) {
+        lvfontio_cmap_range_t *range = &self->cmap_ranges[i];
+        size_t entry_size;
+        if (range->format_type == 0) {
+            entry_size = 1;
+        } else if (range->format_type == 3) {
+            entry_size = 2;
+        } else {
+            continue;
+        }
+        size_t size = range->entries_count * entry_size;
+        if (size <= cache_size) {
+            uint8_t *data = try_allocate_memory(self, size);
+            if (data != NULL) {
+                if (read_at(self, range->data_offset, data, size)) {
+                    range->data = data;
+                    cache_size -= size;
+                } else {
+                    free_memory(self, data);
+                }
+            }
+        }
+        if (range->format_type == 3) {
+            range->sorted = cmap_range_is_sorted(self, range);
+            if (!range->sorted && range->data != NULL) {
+                // An unsorted list is scanned in the file, so the memory is better used for glyphs.
+                free_memory(self, range->data);
+                range->data = NULL;
+                cache_size += size;
+            }
+        }
+    }
+
+    size_t entry_size = self->header.index_to_loc_format == 1 ? 4 : 2;
+    size_t size = self->max_cid * entry_size;
+    if (size <= cache_size) {
+        uint8_t *glyph_offsets = try_allocate_memory(self, size);
+        if (glyph_offsets != NULL) {
+            if (read_at(self, self->loca_table_offset, glyph_offsets, size)) {
+                self->glyph_offsets = glyph_offsets;
+                cache_size -= size;
+            } else {
+                free_memory(self, glyph_offsets);
+            }
+        }
+    }
+
+    // Every record takes as much room as the largest.
+    uint32_t record_size = largest_glyph_record(self);
+    if (record_size == 0 || record_size > UINT16_MAX) {
+        return;
+    }
+    size_t record_count = MIN(cache_size / (record_size + sizeof(lvfontio_glyph_record_t)), UINT16_MAX);
+    if (record_count == 0) {
+        return;
+    }
+    uint8_t *records = try_allocate_memory(self, record_count * record_size);
+    lvfontio_glyph_record_t *record_info = try_allocate_memory(self, record_count * sizeof(lvfontio_glyph_record_t));
+    if (records == NULL || record_info == NULL) {
+        // Without both there is no cache, so don't hold on to the one that worked.
+        if (records != NULL) {
+            free_memory(self, records);
+        }
+        if (record_info != NULL) {
+            free_memory(self, record_info);
+        }
+        return;
+    }
+    self->glyph_records = records;
+    self->glyph_record_info = record_info;
+    for (size_t i = 0; i < record_count; i++) {
+        record_info[i].glyph_offset = UINT32_MAX;
+        record_info[i].last_used = 0;
+        record_info[i].length = 0;
+    }
+    self->glyph_record_size = record_size;
+    self->glyph_record_count = record_count;
+}
+
 // Get character ID (glyph index) for a codepoint
 static int32_t get_char_id(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
     // Find codepoint in cmap ranges
@@ -292,10 +473,6 @@ static int32_t get_char_id(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
             // Handle according to format type
             switch (self->cmap_ranges[i].format_type) {
                 case 0: { // Sparse mapping - need to look up in a sparse table
-                    if (!self->file_is_open) {
-                        return -1;
-                    }
-
                     // Calculate the relative position within the range
                     uint32_t idx = codepoint - self->cmap_ranges[i].range_start;
 
@@ -303,6 +480,14 @@ static int32_t get_char_id(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
                         return -1;
                     }
 
+                    if (self->cmap_ranges[i].data != NULL) {
+                        return self->cmap_ranges[i].glyph_offset + self->cmap_ranges[i].data[idx];
+                    }
+
+                    if (!self->file_is_open) {
+                        return -1;
+                    }
+
                     // Calculate the absolute data position in the file
                     uint32_t data_pos = self->cmap_ranges[i].data_offset + idx; // 1 byte per entry
                     FRESULT res = f_lseek(&self->file, data_pos);
@@ -329,7 +514,35 @@ static int32_t get_char_id(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
                     return glyph_id;
 
                 case 3: { // Direct mapping - need to look up in the table
-                    if (!self->file_is_open) {
+                    uint16_t codepoint_delta = codepoint - self->cmap_ranges[i].range_start;
+
+                    const uint8_t *data = self->cmap_ranges[i].data;
+                    if (data == NULL && !self->file_is_open) {
+                        return -1;
+                    }
+
+                    if (self->cmap_ranges[i].sorted) {
+                        // Binary search the sorted list, in memory or in the file.
+                        size_t low = 0;
+                        size_t high = self->cmap_ranges[i].entries_count;
+                        while (low < high) {
+                            size_t mid = (low + high) / 2;
+                            uint8_t candidate_buf[2];
+                            const uint8_t *candidate = candidate_buf;
+                            if (data != NULL) {
+                                candidate = data + 2 * mid;
+                            } else if (!read_at(self, self->cmap_ranges[i].data_offset + 2 * mid, candidate_buf, 2)) {
+                                return -1;
+                            }
+                            uint16_t candidate_codepoint_delta = read_le(candidate, 2);
+                            if (candidate_codepoint_delta == codepoint_delta) {
+                                return self->cmap_ranges[i].glyph_offset + mid;
+                            } else if (candidate_codepoint_delta < codepoint_delta) {
+                                low = mid + 1;
+                            } else {
+                                high = mid;
+                            }
+                        }
                         return -1;
                     }
 
@@ -338,17 +551,17 @@ static int32_t get_char_id(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
                     if (res != FR_OK) {
                         return -1;
                     }
-                    uint16_t codepoint_delta = codepoint - self->cmap_ranges[i].range_start;
 
                     for (size_t j = 0; j < self->cmap_ranges[i].entries_count; j++) {
                         // Read code point at the index
-                        uint16_t candidate_codepoint_delta;
-                        res = f_read(&self->file, &candidate_codepoint_delta, 2, NULL);
-                        if (res != FR_OK) {
+                        uint8_t candidate_buf[2];
+                        UINT bytes_read;
+                        res = f_read(&self->file, candidate_buf, 2, &bytes_read);
+                        if (res != FR_OK || bytes_read < 2) {
                             return -1;
                         }
 
-                        if (candidate_codepoint_delta == codepoint_delta) {
+                        if (read_le(candidate_buf, 2) == codepoint_delta) {
                             return self->cmap_ranges[i].glyph_offset + j;
                         }
                     }
@@ -364,22 +577,121 @@ static int32_t get_char_id(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
     return -1; // Not found
 }
 
+// Get a glyph's offset from the start of the glyf table from the location table
+static bool get_glyph_offset(lvfontio_ondiskfont_t *self, uint32_t char_id, uint32_t *glyph_offset) {
+    size_t entry_size = self->header.index_to_loc_format == 1 ? 4 : 2;
+    if (self->glyph_offsets != NULL) {
+        *glyph_offset = read_le(self->glyph_offsets + char_id * entry_size, entry_size);
+        return true;
+    }
+
+    FRESULT res = f_lseek(&self->file, self->loca_table_offset + char_id * entry_size);
+    if (res != FR_OK) {
+        return false;
+    }
+    uint8_t offset_buf[4];
+    UINT bytes_read;
+    res = f_read(&self->file, offset_buf, entry_size, &bytes_read);
+    if (res != FR_OK || bytes_read < entry_size) {
+        return false;
+    }
+    *glyph_offset = read_le(offset_buf, entry_size);
+    return true;
+}
+
+// Returns the glyph's record from the glyph cache, reading it from the file with one read if it
+// isn't there yet. Returns NULL if there is no cache or the record can't be read.
+static const uint8_t *get_glyph_record(lvfontio_ondiskfont_t *self, uint32_t char_id, size_t *len) {
+    if (self->glyph_record_count == 0) {
+        return NULL;
+    }
+    uint32_t start;
+    if (!get_glyph_offset(self, char_id, &start)) {
+        return NULL;
+    }
+    // Records are found by their offset, so a hit doesn't need the record's end from loca.
+    uint16_t oldest = 0;
+    for (uint16_t i = 0; i < self->glyph_record_count; i++) {
+        lvfontio_glyph_record_t *info = &self->glyph_record_info[i];
+        if (info->glyph_offset == start) {
+            info->last_used = ++self->use_count;
+            *len = info->length;
+            return self->glyph_records + i * self->glyph_record_size;
+        }
+        if (info->last_used < self->glyph_record_info[oldest].last_used) {
+            oldest = i;
+        }
+    }
+
+    uint32_t end = self->glyf_table_size;
+    if (char_id + 1 < self->max_cid && !get_glyph_offset(self, char_id + 1, &end)) {
+        return NULL;
+    }
+    if (end <= start || end - start > self->glyph_record_size) {
+        return NULL;
+    }
+
+    // Replace the least recently used record.
+    lvfontio_glyph_record_t *info = &self->glyph_record_info[oldest];
+    uint8_t *record = self->glyph_records + oldest * self->glyph_record_size;
+    info->glyph_offset = UINT32_MAX;
+    info->last_used = 0;
+    if (!read_at(self, self->glyf_table_offset + start, record, end - start)) {
+        return NULL;
+    }
+    info->glyph_offset = start;
+    info->length = end - start;
+    info->last_used = ++self->use_count;
+    *len = info->length;
+    return record;
+}
+
+// Get ready to read a glyph, from the glyph cache if there is one and from the file otherwise.
+static bool open_glyph(lvfontio_ondiskfont_t *self, uint32_t char_id, bit_reader_t *reader) {
+    size_t len;
+    const uint8_t *record = get_glyph_record(self, char_id, &len);
+    if (record != NULL) {
+        bit_reader_init(reader, &self->file, record, len);
+        return true;
+    }
+
+    uint32_t glyph_offset;
+    if (!get_glyph_offset(self, char_id, &glyph_offset)) {
+        return false;
+    }
+    // Seek to glyph data
+    if (f_lseek(&self->file, self->glyf_table_offset + glyph_offset) != FR_OK) {
+        return false;
+    }
+    bit_reader_init(reader, &self->file, NULL, 0);
+    return true;
+}
+
 // Load glyph bitmap data into a slot
-// This function assumes the file is already open and positioned after reading the glyph dimensions
-static bool load_glyph_bitmap(FIL *file, lvfontio_ondiskfont_t *self, uint32_t codepoint, uint16_t slot,
-    uint32_t glyph_advance, int32_t bbox_x, int32_t bbox_y, uint32_t bbox_w, uint32_t bbox_h,
-    uint8_t *byte_val, uint8_t *remaining_bits) {
-    // Store codepoint at slot
-    self->codepoints[slot] = codepoint;
-    self->reference_counts[slot] = 1;
+// This function assumes the reader is positioned after reading the glyph dimensions
+static bool load_glyph_bitmap(bit_reader_t *reader, lvfontio_ondiskfont_t *self, uint16_t slot, uint16_t slots_needed,
+    int32_t bbox_x, int32_t bbox_y, uint32_t bbox_w, uint32_t bbox_h) {
+    // Clear whatever glyph used the slot before.
+    uint16_t x_offset = slot * self->header.default_advance_width;
+    displayio_area_t slot_area = {
+        .x1 = x_offset,
+        .y1 = 0,
+        .x2 = x_offset + slots_needed * self->header.default_advance_width,
+        .y2 = self->header.font_size,
+    };
+    for (int16_t y = slot_area.y1; y < slot_area.y2; y++) {
+        for (int16_t x = slot_area.x1; x < slot_area.x2; x++) {
+            displayio_bitmap_write_pixel(self->bitmap, x, y, 0);
+        }
+    }
+    displayio_bitmap_set_dirty_area(self->bitmap, &slot_area);
 
     // Read bitmap data pixel by pixel
-    uint16_t x_offset = slot * self->header.default_advance_width;
     uint16_t y_offset = self->header.ascent - bbox_y - bbox_h;
     for (uint16_t y = 0; y < bbox_h; y++) {
         for (uint16_t x = 0; x < bbox_w; x++) {
             uint32_t pixel_value;
-            FRESULT res = read_bits(file, self->header.bits_per_pixel, byte_val, remaining_bits, &pixel_value);
+            FRESULT res = read_bits(reader, self->header.bits_per_pixel, &pixel_value);
             if (res != FR_OK) {
                 return false;
             }
@@ -393,12 +705,7 @@ static bool load_glyph_bitmap(FIL *file, lvfontio_ondiskfont_t *self, uint32_t c
                 bitmap_x < self->header.default_advance_width * self->max_glyphs &&
                 bitmap_y >= 0 &&
                 bitmap_y < self->header.font_size) {
-                common_hal_displayio_bitmap_set_pixel(
-                    self->bitmap,
-                    bitmap_x,
-                    bitmap_y,
-                    pixel_value
-                    );
+                displayio_bitmap_write_pixel(self->bitmap, bitmap_x, bitmap_y, pixel_value);
             }
         }
     }
@@ -410,15 +717,27 @@ static bool load_glyph_bitmap(FIL *file, lvfontio_ondiskfont_t *self, uint32_t c
 void common_hal_lvfontio_ondiskfont_construct(lvfontio_ondiskfont_t *self,
     const char *file_path,
     uint16_t max_glyphs,
+    size_t cache_size,
     bool use_gc_allocator) {
 
     // Store the allocation mode
     self->use_gc_allocator = use_gc_allocator;
     // Store parameters
     self->file_path = file_path; // Store the provided path string directly
-    self->max_glyphs = max_glyphs;
+    self->max_glyphs = 0;
     self->cmap_ranges = NULL;
+    self->cmap_range_count = 0;
     self->file_is_open = false;
+    self->bitmap = NULL;
+    self->codepoints = NULL;
+    self->reference_counts = NULL;
+    self->slot_last_used = NULL;
+    self->use_count = 0;
+    self->glyph_offsets = NULL;
+    self->glyph_records = NULL;
+    self->glyph_record_info = NULL;
+    self->glyph_record_size = 0;
+    self->glyph_record_count = 0;
 
     // Determine which filesystem to use based on the path
     const char *path_under_mount;
@@ -444,10 +763,9 @@ void common_hal_lvfontio_ondiskfont_construct(lvfontio_ondiskfont_t *self,
     self->file_is_open = true;
 
     // Load font headers
-    size_t max_slots;
+    size_t max_slots = max_glyphs;
     if (!load_font_header(self, &self->file, &max_slots)) {
-        f_close(&self->file);
-        self->file_is_open = false;
+        common_hal_lvfontio_ondiskfont_deinit(self);
         if (self->use_gc_allocator) {
             mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_file);
         }
@@ -456,6 +774,7 @@ void common_hal_lvfontio_ondiskfont_construct(lvfontio_ondiskfont_t *self,
     // Cap the number of slots to the number of slots needed by the font. That way
     // small font files don't need a bunch of extra cache space.
     max_glyphs = MIN(max_glyphs, max_slots);
+    self->max_glyphs = max_glyphs;
 
     // Allocate codepoints array. allocate_memory will raise an exception if
     // allocation fails and the VM is active.
@@ -478,14 +797,20 @@ void common_hal_lvfontio_ondiskfont_construct(lvfontio_ondiskfont_t *self,
     // Initialize reference counts to 0
     memset(self->reference_counts, 0, sizeof(uint16_t) * max_glyphs);
 
+    self->slot_last_used = allocate_memory(self, sizeof(uint32_t) * max_glyphs);
+    if (self->slot_last_used == NULL) {
+        return;
+    }
+    memset(self->slot_last_used, 0, sizeof(uint32_t) * max_glyphs);
+
     self->half_width_px = self->header.default_advance_width;
 
     // Create bitmap for glyph cache
     displayio_bitmap_t *bitmap = allocate_memory(self, sizeof(displayio_bitmap_t));
-    bitmap->base.type = &displayio_bitmap_type;
     if (bitmap == NULL) {
         return;
     }
+    bitmap->base.type = &displayio_bitmap_type;
 
     // Calculate bitmap stride
     uint32_t bits_per_pixel = 1 << self->header.bits_per_pixel;
@@ -511,6 +836,9 @@ void common_hal_lvfontio_ondiskfont_construct(lvfontio_ondiskfont_t *self,
             bitmap_buffer,
             false);
     self->bitmap = bitmap;
+
+    // Only once the font has everything it needs does the optional memory get what it can.
+    load_index(self, cache_size);
 }
 
 void common_hal_lvfontio_ondiskfont_deinit(lvfontio_ondiskfont_t *self) {
@@ -533,9 +861,33 @@ void common_hal_lvfontio_ondiskfont_deinit(lvfontio_ondiskfont_t *self) {
         self->reference_counts = NULL;
     }
 
+    if (self->slot_last_used != NULL) {
+        free_memory(self, self->slot_last_used);
+        self->slot_last_used = NULL;
+    }
 
+    if (self->glyph_offsets != NULL) {
+        free_memory(self, self->glyph_offsets);
+        self->glyph_offsets = NULL;
+    }
+
+    if (self->glyph_records != NULL) {
+        free_memory(self, self->glyph_records);
+        self->glyph_records = NULL;
+    }
+
+    if (self->glyph_record_info != NULL) {
+        free_memory(self, self->glyph_record_info);
+        self->glyph_record_info = NULL;
+    }
+    self->glyph_record_count = 0;
 
     if (self->cmap_ranges != NULL) {
+        for (uint16_t i = 0; i < self->cmap_range_count; i++) {
+            if (self->cmap_ranges[i].data != NULL) {
+                free_memory(self, self->cmap_ranges[i].data);
+            }
+        }
         free_memory(self, self->cmap_ranges);
         self->cmap_ranges = NULL;
     }
@@ -569,22 +921,42 @@ void common_hal_lvfontio_ondiskfont_get_dimensions(const lvfontio_ondiskfont_t *
     }
 }
 
+// Returns the other slot of a full-width glyph, or -1 if the slot holds no glyph or one that
+// is regular width.
+static int32_t slot_partner(lvfontio_ondiskfont_t *self, uint16_t slot) {
+    uint32_t codepoint = self->codepoints[slot];
+    if (codepoint == LVFONTIO_INVALID_CODEPOINT) {
+        return -1;
+    }
+    if (slot > 0 && self->codepoints[slot - 1] == codepoint) {
+        return slot - 1;
+    }
+    if (slot + 1 < self->max_glyphs && self->codepoints[slot + 1] == codepoint) {
+        return slot + 1;
+    }
+    return -1;
+}
+
 int16_t common_hal_lvfontio_ondiskfont_cache_glyph(lvfontio_ondiskfont_t *self, uint32_t codepoint, bool *is_full_width) {
+    if (self->max_glyphs == 0) {
+        return -1;
+    }
+
     // Check if already cached
     int16_t existing_slot = find_codepoint_slot(self, codepoint);
     if (existing_slot >= 0) {
-        // Glyph is already cached, increment reference count
-        self->reference_counts[existing_slot]++;
+        // Glyph is already cached, increment reference count. A full-width
+        // character has a second slot with the same codepoint right after this
+        // one, which is shown and released separately.
+        bool existing_full_width = slot_partner(self, existing_slot) >= 0;
+        uint32_t use_count = ++self->use_count;
+        for (uint16_t i = 0; i < (existing_full_width ? 2 : 1); i++) {
+            self->reference_counts[existing_slot + i]++;
+            self->slot_last_used[existing_slot + i] = use_count;
+        }
 
-        // Check if this is a full-width character by looking for a second slot
-        // with the same codepoint right after this one
         if (is_full_width != NULL) {
-            if (existing_slot + 1 < self->max_glyphs &&
-                self->codepoints[existing_slot + 1] == codepoint) {
-                *is_full_width = true;
-            } else {
-                *is_full_width = false;
-            }
+            *is_full_width = existing_full_width;
         }
 
         return existing_slot;
@@ -606,38 +978,8 @@ int16_t common_hal_lvfontio_ondiskfont_cache_glyph(lvfontio_ondiskfont_t *self,
         return -1; // Invalid character
     }
 
-    // Get glyph offset from location table
-    uint32_t glyph_offset = 0;
-    uint32_t loca_offset = self->loca_table_offset + char_id *
-        (self->header.index_to_loc_format == 1 ? 4 : 2);
-
-    FRESULT res = f_lseek(&self->file, loca_offset);
-    if (res != FR_OK) {
-        return -1;
-    }
-
-    UINT bytes_read;
-    if (self->header.index_to_loc_format == 1) {
-        // 4-byte offset
-        uint8_t offset_buf[4];
-        res = f_read(&self->file, offset_buf, 4, &bytes_read);
-        if (res != FR_OK || bytes_read < 4) {
-            return -1;
-        }
-        glyph_offset = offset_buf[0] | (offset_buf[1] << 8) |
-            (offset_buf[2] << 16) | (offset_buf[3] << 24);
-    } else {
-        // 2-byte offset
-        uint8_t offset_buf[2];
-        res = f_read(&self->file, offset_buf, 2, &bytes_read);
-        if (res != FR_OK || bytes_read < 2) {
-            return -1;
-        }
-        glyph_offset = offset_buf[0] | (offset_buf[1] << 8);
-    }
-    // Seek to glyph data
-    res = f_lseek(&self->file, self->glyf_table_offset + glyph_offset);
-    if (res != FR_OK) {
+    bit_reader_t reader;
+    if (!open_glyph(self, char_id, &reader)) {
         return -1;
     }
 
@@ -646,12 +988,8 @@ int16_t common_hal_lvfontio_ondiskfont_cache_glyph(lvfontio_ondiskfont_t *self,
     int32_t bbox_x, bbox_y;
     uint32_t bbox_w, bbox_h;
 
-    // Initialize bit reading state
-    uint8_t byte_val = 0;
-    uint8_t remaining_bits = 0;
-
     // Use the helper function to read glyph dimensions
-    res = read_glyph_dimensions(&self->file, self, &glyph_advance, &bbox_x, &bbox_y, &bbox_w, &bbox_h, &byte_val, &remaining_bits);
+    FRESULT res = read_glyph_dimensions(&reader, self, &glyph_advance, &bbox_x, &bbox_y, &bbox_w, &bbox_h);
     if (res != FR_OK) {
         return -1;
     }
@@ -664,39 +1002,33 @@ int16_t common_hal_lvfontio_ondiskfont_cache_glyph(lvfontio_ondiskfont_t *self,
     uint16_t slots_needed = is_full_width_glyph ? 2 : 1;
 
     // Find an appropriate slot (or consecutive slots for full-width)
-    uint16_t slot = UINT16_MAX;
-
-    if (slots_needed == 1) {
-        // For regular width, find a free slot starting at codepoint's position
-        slot = find_free_slot(self, codepoint);
-    } else {
-        // For full-width, find two consecutive free slots
-        for (uint16_t i = 0; i < self->max_glyphs - 1; i++) {
-            if (self->codepoints[i] == LVFONTIO_INVALID_CODEPOINT &&
-                self->reference_counts[i] == 0 &&
-                self->codepoints[i + 1] == LVFONTIO_INVALID_CODEPOINT &&
-                self->reference_counts[i + 1] == 0) {
-                slot = i;
-                break;
-            }
-        }
-    }
+    uint16_t slot = find_free_slot(self, codepoint, slots_needed);
 
     // Check if we found appropriate slot(s)
     if (slot == UINT16_MAX) {
         return -1; // No slots available
     }
 
+    // Forget the glyphs that were in the slots, including the other halves of full-width ones.
+    for (uint16_t i = slot; i < slot + slots_needed; i++) {
+        int32_t partner = slot_partner(self, i);
+        if (partner >= 0) {
+            self->codepoints[partner] = LVFONTIO_INVALID_CODEPOINT;
+        }
+        self->codepoints[i] = LVFONTIO_INVALID_CODEPOINT;
+    }
+
     // Load glyph into the slot
-    if (!load_glyph_bitmap(&self->file, self, codepoint, slot, glyph_advance,
-        bbox_x, bbox_y, bbox_w, bbox_h, &byte_val, &remaining_bits)) {
+    if (!load_glyph_bitmap(&reader, self, slot, slots_needed, bbox_x, bbox_y, bbox_w, bbox_h)) {
         return -1; // Failed to load glyph
     }
 
     // For full-width characters, mark both slots with the same codepoint
-    if (is_full_width_glyph && slot + 1 < self->max_glyphs) {
-        self->codepoints[slot + 1] = codepoint;
-        self->reference_counts[slot + 1] = 1;
+    uint32_t use_count = ++self->use_count;
+    for (uint16_t i = slot; i < slot + slots_needed; i++) {
+        self->codepoints[i] = codepoint;
+        self->reference_counts[i] = 1;
+        self->slot_last_used[i] = use_count;
     }
 
     if (is_full_width != NULL) {
@@ -716,56 +1048,109 @@ void common_hal_lvfontio_ondiskfont_release_glyph(lvfontio_ondiskfont_t *self, u
     }
 }
 
+size_t common_hal_lvfontio_ondiskfont_prefetch(lvfontio_ondiskfont_t *self, const char *text, size_t len) {
+    size_t found = 0;
+    const byte *s = (const byte *)text;
+    const byte *top = s + len;
+    while (s < top) {
+        unichar codepoint = utf8_get_char(s);
+        s = utf8_next_char(s);
+        int32_t char_id = get_char_id(self, codepoint);
+        if (char_id < 0 || (uint32_t)char_id >= self->max_cid) {
+            continue;
+        }
+        found++;
+        size_t record_len;
+        get_glyph_record(self, char_id, &record_len);
+    }
+    return found;
+}
+
 static int16_t find_codepoint_slot(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
     size_t offset = codepoint % self->max_glyphs;
     for (uint16_t i = 0; i < self->max_glyphs; i++) {
         int16_t slot = (i + offset) % self->max_glyphs;
         if (self->codepoints[slot] == codepoint) {
+            // Full-width glyphs start at their first slot.
+            if (slot > 0 && self->codepoints[slot - 1] == codepoint) {
+                slot--;
+            }
             return slot;
         }
     }
     return -1;
 }
 
-static uint16_t find_free_slot(lvfontio_ondiskfont_t *self, uint32_t codepoint) {
+// Whether the glyph in a slot, and the other half of it if it is full-width, isn't shown anywhere.
+static bool slot_is_free(lvfontio_ondiskfont_t *self, uint16_t slot) {
+    if (self->reference_counts[slot] != 0) {
+        return false;
+    }
+    int32_t partner = slot_partner(self, slot);
+    return partner < 0 || self->reference_counts[partner] == 0;
+}
+
+static uint16_t find_free_slot(lvfontio_ondiskfont_t *self, uint32_t codepoint, uint16_t slots_needed) {
+    if (slots_needed > self->max_glyphs) {
+        return UINT16_MAX;
+    }
     size_t offset = codepoint % self->max_glyphs;
 
     // First look for completely unused slots, starting at the offset
     for (uint16_t i = 0; i < self->max_glyphs; i++) {
-        int16_t slot = (i + offset) % self->max_glyphs;
-        if (self->codepoints[slot] == LVFONTIO_INVALID_CODEPOINT && self->reference_counts[slot] == 0) {
+        uint16_t slot = (i + offset) % self->max_glyphs;
+        if (slot + slots_needed > self->max_glyphs) {
+            continue;
+        }
+        bool unused = true;
+        for (uint16_t j = slot; j < slot + slots_needed; j++) {
+            if (self->codepoints[j] != LVFONTIO_INVALID_CODEPOINT || self->reference_counts[j] != 0) {
+                unused = false;
+            }
+        }
+        if (unused) {
             return slot;
         }
     }
 
-    // If none found, look for slots with zero reference count, starting at the offset
-    for (uint16_t i = 0; i < self->max_glyphs; i++) {
-        int16_t slot = (i + offset) % self->max_glyphs;
-        if (self->reference_counts[slot] == 0) {
-            return slot;
+    // If none found, replace the least recently used glyphs that aren't shown anywhere
+    uint16_t best_slot = UINT16_MAX;
+    uint32_t best_last_used = UINT32_MAX;
+    for (uint16_t slot = 0; slot + slots_needed <= self->max_glyphs; slot++) {
+        uint32_t last_used = 0;
+        bool free = true;
+        for (uint16_t j = slot; j < slot + slots_needed; j++) {
+            if (!slot_is_free(self, j)) {
+                free = false;
+                break;
+            }
+            last_used = MAX(last_used, self->slot_last_used[j]);
+        }
+        if (free && last_used < best_last_used) {
+            best_slot = slot;
+            best_last_used = last_used;
         }
     }
 
-    // No slots available
-    return UINT16_MAX;
+    // UINT16_MAX if no slots are available
+    return best_slot;
 }
 
-static FRESULT read_glyph_dimensions(FIL *file, lvfontio_ondiskfont_t *self,
+static FRESULT read_glyph_dimensions(bit_reader_t *reader, lvfontio_ondiskfont_t *self,
     uint32_t *advance_width, int32_t *bbox_x, int32_t *bbox_y,
-    uint32_t *bbox_w, uint32_t *bbox_h,
-    uint8_t *byte_val, uint8_t *remaining_bits) {
+    uint32_t *bbox_w, uint32_t *bbox_h) {
     FRESULT res;
     uint32_t temp_value;
 
     // Read glyph_advance
-    res = read_bits(file, self->header.glyph_advance_bits, byte_val, remaining_bits, &temp_value);
+    res = read_bits(reader, self->header.glyph_advance_bits, &temp_value);
     if (res != FR_OK) {
         return res;
     }
     *advance_width = temp_value;
 
     // Read bbox_x (signed)
-    res = read_bits(file, self->header.glyph_bbox_xy_bits, byte_val, remaining_bits, &temp_value);
+    res = read_bits(reader, self->header.glyph_bbox_xy_bits, &temp_value);
     if (res != FR_OK) {
         return res;
     }
@@ -777,7 +1162,7 @@ static FRESULT read_glyph_dimensions(FIL *file, lvfontio_ondiskfont_t *self,
     }
 
     // Read bbox_y (signed)
-    res = read_bits(file, self->header.glyph_bbox_xy_bits, byte_val, remaining_bits, &temp_value);
+    res = read_bits(reader, self->header.glyph_bbox_xy_bits, &temp_value);
     if (res != FR_OK) {
         return res;
     }
@@ -789,14 +1174,14 @@ static FRESULT read_glyph_dimensions(FIL *file, lvfontio_ondiskfont_t *self,
     }
 
     // Read bbox_w
-    res = read_bits(file, self->header.glyph_bbox_wh_bits, byte_val, remaining_bits, &temp_value);
+    res = read_bits(reader, self->header.glyph_bbox_wh_bits, &temp_value);
     if (res != FR_OK) {
         return res;
     }
     *bbox_w = temp_value;
 
     // Read bbox_h
-    res = read_bits(file, self->header.glyph_bbox_wh_bits, byte_val, remaining_bits, &temp_value);
+    res = read_bits(reader, self->header.glyph_bbox_wh_bits, &temp_value);
     if (res != FR_OK) {
         return res;
     }
@@ -805,35 +1190,39 @@ static FRESULT read_glyph_dimensions(FIL *file, lvfontio_ondiskfont_t *self,
     return FR_OK;
 }
 
-static FRESULT read_bits(FIL *file, size_t num_bits, uint8_t *byte_val, uint8_t *remaining_bits, uint32_t *result) {
-    FRESULT res = FR_OK;
-    UINT bytes_read;
-
+static FRESULT read_bits(bit_reader_t *reader, size_t num_bits, uint32_t *result) {
     uint32_t value = 0;
     // Bits will be lost when num_bits > 32. However, this is good for skipping bits.
     size_t bits_needed = num_bits;
 
     while (bits_needed > 0) {
         // If no bits remaining, read a new byte
-        if (*remaining_bits == 0) {
-            res = f_read(file, byte_val, 1, &bytes_read);
-            if (res != FR_OK || bytes_read < 1) {
-                return FR_DISK_ERR;
+        if (reader->remaining_bits == 0) {
+            if (reader->data != NULL) {
+                if (reader->pos >= reader->len) {
+                    return FR_DISK_ERR;
+                }
+                reader->byte_val = reader->data[reader->pos++];
+            } else {
+                UINT bytes_read;
+                FRESULT res = f_read(reader->file, &reader->byte_val, 1, &bytes_read);
+                if (res != FR_OK || bytes_read < 1) {
+                    return FR_DISK_ERR;
+                }
             }
-            *remaining_bits = 8;
+            reader->remaining_bits = 8;
         }
 
         // Calculate how many bits to take from current byte
-        uint8_t bits_to_take = (*remaining_bits < bits_needed) ? *remaining_bits : bits_needed;
-        value = (value << bits_to_take) | (*byte_val >> (8 - bits_to_take));
+        uint8_t bits_to_take = (reader->remaining_bits < bits_needed) ? reader->remaining_bits : bits_needed;
+        value = (value << bits_to_take) | (reader->byte_val >> (8 - bits_to_take));
 
         // Update state
-        *remaining_bits -= bits_to_take;
+        reader->remaining_bits -= bits_to_take;
         bits_needed -= bits_to_take;
 
         // Shift byte for next read
-        *byte_val <<= bits_to_take;
-        *byte_val &= 0xFF;
+        reader->byte_val <<= bits_to_take;
     }
 
     if (result != NULL) {
@@ -13,6 +13,11 @@
 
 #define LVFONTIO_INVALID_CODEPOINT 0xFFFFFFFF
 
+// Bytes of glyph data kept in memory when no cache size is given.
+#ifndef LVFONTIO_DEFAULT_CACHE_SIZE
+#define LVFONTIO_DEFAULT_CACHE_SIZE (4096)
+#endif
+
 // LV Font header information
 typedef struct {
     // Font size and metrics
@@ -40,8 +45,17 @@ typedef struct {
     uint8_t format_type;    // Format type: 0=sparse mapping, 2=range to range, 3=direct mapping
     uint16_t entries_count; // Number of entries in sparse data
     uint32_t data_offset;   // File offset to the cmap data
+    uint8_t *data;          // The cmap data read in at load time, or NULL to read it from the file
+    bool sorted;            // Whether format 3 codepoints are in order, so they can be binary searched
 } lvfontio_cmap_range_t;
 
+// A glyph record kept in memory, found by where the record is in the glyf table.
+typedef struct {
+    uint32_t glyph_offset; // UINT32_MAX when unused
+    uint32_t last_used;
+    uint16_t length;
+} lvfontio_glyph_record_t;
+
 typedef struct {
     mp_obj_base_t base;
     // Bitmap containing cached glyphs
@@ -52,6 +66,9 @@ typedef struct {
     uint32_t *codepoints;
     // Array of reference counts for each glyph slot
     uint16_t *reference_counts; // Use uint16_t to handle higher reference counts
+    // When each slot was last used, so the least recently used glyph is replaced first
+    uint32_t *slot_last_used;
+    uint32_t use_count;
     // Maximum number of glyphs to cache at once
     uint16_t max_glyphs;
     // Flag indicating whether to use m_malloc (true) or port_malloc (false)
@@ -71,5 +88,19 @@ typedef struct {
     // Offsets for tables in the file
     uint32_t loca_table_offset;
     uint32_t glyf_table_offset;
+    uint32_t glyf_table_size;
     uint32_t max_cid;
+
+    // The loca table, read in at load time so that finding a glyph doesn't need the file. Entries
+    // are 2 or 4 bytes as in the file. NULL if it didn't fit in memory.
+    uint8_t *glyph_offsets;
+
+    // Glyph records as they are in the file, so redrawing text doesn't read it again. There are
+    // glyph_record_count of them, glyph_record_size bytes apart, and the least recently used one
+    // is replaced first. They don't need the loca table in memory: a record is found by the glyph
+    // offset read from it.
+    uint8_t *glyph_records;
+    lvfontio_glyph_record_t *glyph_record_info;
+    uint16_t glyph_record_size;
+    uint16_t glyph_record_count;
 } lvfontio_ondiskfont_t;
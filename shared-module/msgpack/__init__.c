@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "py/obj.h"
 #include "py/binary.h"
@@ -23,47 +24,166 @@
 ////////////////////////////////////////////////////////////////
 // stream management
 
+// Reads and writes go through a window of MSGPACK_WINDOW_SIZE bytes, so a
+// message costs about one stream call per window instead of one or more per
+// field. unpack only reads ahead on streams that can seek: once the value is
+// complete, the stream is moved back to just after it, so the next value is
+// still there. Other streams, such as sockets and UARTs, are read exactly.
+//
+// pack_into and unpack_from work on the caller's buffer directly: it takes the
+// place of the window, and there is no stream.
+
+#define MSGPACK_WINDOW_SIZE (256)
+
 typedef struct _msgpack_stream_t {
     mp_obj_t stream_obj;
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
     int errcode;
+    // The object whose buffer is used instead of a stream, or MP_OBJ_NULL.
+    mp_obj_t buffer_obj;
+    uint8_t *buf;
+    // When unpacking, buf[pos:len] has not been parsed yet. When packing,
+    // buf[:pos] has been packed, out of room for len bytes.
+    size_t pos;
+    size_t len;
+    bool packing;
+    bool read_ahead;
 } msgpack_stream_t;
 
-static msgpack_stream_t get_stream(mp_obj_t stream_obj, int flags) {
+static void get_stream(msgpack_stream_t *s, mp_obj_t stream_obj, int flags, uint8_t *window) {
     const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, flags);
-    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0};
-    return s;
+    s->stream_obj = stream_obj;
+    s->read = stream_p->read;
+    s->write = stream_p->write;
+    s->errcode = 0;
+    s->buffer_obj = MP_OBJ_NULL;
+    s->buf = window;
+    s->pos = 0;
+    s->packing = flags & MP_STREAM_OP_WRITE;
+    s->len = s->packing ? MSGPACK_WINDOW_SIZE : 0;
+    s->read_ahead = false;
+    if (!s->packing && stream_p->ioctl != NULL) {
+        int errcode;
+        s->read_ahead = mp_stream_seek(stream_obj, 0, MP_SEEK_CUR, &errcode) != (mp_off_t)-1;
+    }
+}
+
+static void get_buffer(msgpack_stream_t *s, mp_obj_t buffer_obj, mp_int_t offset, int flags) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_obj, &bufinfo, flags);
+    s->stream_obj = MP_OBJ_NULL;
+    s->buffer_obj = buffer_obj;
+    s->buf = bufinfo.buf;
+    s->pos = mp_arg_validate_int_range(offset, 0, bufinfo.len, MP_QSTR_offset);
+    s->len = bufinfo.len;
+    s->packing = flags & MP_BUFFER_WRITE;
+    s->read_ahead = false;
+}
+
+static void check_errcode(msgpack_stream_t *s) {
+    if (s->errcode != 0) {
+        mp_raise_OSError(s->errcode);
+    }
+}
+
+// Writes out what has been packed, or moves the stream back over what was
+// read ahead, so that the stream is where the next value starts.
+static void sync_stream(msgpack_stream_t *s) {
+    if (s->stream_obj == MP_OBJ_NULL) {
+        return;
+    }
+    if (s->packing && s->pos > 0) {
+        mp_uint_t ret = s->write(s->stream_obj, s->buf, s->pos, &s->errcode);
+        check_errcode(s);
+        if (ret == 0) {
+            mp_raise_msg(&mp_type_EOFError, NULL);
+        }
+        s->pos = 0;
+    }
+    if (s->read_ahead && s->pos < s->len) {
+        mp_stream_seek(s->stream_obj, -(mp_off_t)(s->len - s->pos), MP_SEEK_CUR, &s->errcode);
+        check_errcode(s);
+        s->pos = s->len = 0;
+    }
+}
+
+// Python code run part way through, by default or ext_hook, may use the
+// stream or resize the buffer. Call sync_stream before it and this after.
+static void resume_stream(msgpack_stream_t *s) {
+    if (s->buffer_obj == MP_OBJ_NULL) {
+        return;
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(s->buffer_obj, &bufinfo, s->packing ? MP_BUFFER_WRITE : MP_BUFFER_READ);
+    if (bufinfo.len < s->pos) {
+        mp_raise_ValueError(MP_ERROR_TEXT("buffer too small"));
+    }
+    s->buf = bufinfo.buf;
+    s->len = bufinfo.len;
 }
 
 ////////////////////////////////////////////////////////////////
 // readers
 
-static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
-    if (size == 0) {
+static void read_bytes(msgpack_stream_t *s, void *buf, mp_uint_t size) {
+    size_t available = s->len - s->pos;
+    if (size <= available) {
+        memcpy(buf, s->buf + s->pos, size);
+        s->pos += size;
         return;
     }
-    mp_uint_t ret = s->read(s->stream_obj, buf, size, &s->errcode);
-    if (s->errcode != 0) {
-        mp_raise_OSError(s->errcode);
+    mp_uint_t ret = 0;
+    if (s->stream_obj != MP_OBJ_NULL) {
+        memcpy(buf, s->buf + s->pos, available);
+        s->pos = s->len;
+        uint8_t *dest = (uint8_t *)buf + available;
+        size_t needed = size - available;
+        if (s->read_ahead && needed < MSGPACK_WINDOW_SIZE) {
+            s->len = s->read(s->stream_obj, s->buf, MSGPACK_WINDOW_SIZE, &s->errcode);
+            if (s->len == MP_STREAM_ERROR) {
+                s->len = 0;
+            }
+            s->pos = MIN(needed, s->len);
+            memcpy(dest, s->buf, s->pos);
+            ret = s->pos;
+        } else {
+            ret = s->read(s->stream_obj, dest, needed, &s->errcode);
+        }
+        check_errcode(s);
+        if (ret == needed) {
+            return;
+        }
     }
-    if (ret == 0) {
+    if (available == 0 && ret == 0) {
         mp_raise_msg(&mp_type_EOFError, NULL);
     }
-    if (ret < size) {
-        mp_raise_ValueError(MP_ERROR_TEXT("short read"));
+    mp_raise_ValueError(MP_ERROR_TEXT("short read"));
+}
+
+// Returns the next size bytes where they are, if they are all in the window
+// or buffer already, and NULL otherwise.
+static const uint8_t *read_in_place(msgpack_stream_t *s, size_t size) {
+    if (size > s->len - s->pos) {
+        return NULL;
     }
+    const uint8_t *p = s->buf + s->pos;
+    s->pos += size;
+    return p;
 }
 
 static uint8_t read1(msgpack_stream_t *s) {
+    if (s->pos < s->len) {
+        return s->buf[s->pos++];
+    }
     uint8_t res = 0;
-    read(s, &res, 1);
+    read_bytes(s, &res, 1);
     return res;
 }
 
 static uint16_t read2(msgpack_stream_t *s) {
     uint16_t res = 0;
-    read(s, &res, 2);
+    read_bytes(s, &res, 2);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap16(res);
@@ -73,7 +193,7 @@ static uint16_t read2(msgpack_stream_t *s) {
 
 static uint32_t read4(msgpack_stream_t *s) {
     uint32_t res = 0;
-    read(s, &res, 4);
+    read_bytes(s, &res, 4);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap32(res);
@@ -83,7 +203,7 @@ static uint32_t read4(msgpack_stream_t *s) {
 
 static uint64_t read8(msgpack_stream_t *s) {
     uint64_t res = 0;
-    read(s, &res, 8);
+    read_bytes(s, &res, 8);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap64(res);
@@ -110,18 +230,34 @@ static size_t read_size(msgpack_stream_t *s, uint8_t len_index) {
 ////////////////////////////////////////////////////////////////
 // writers
 
-static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
-    mp_uint_t ret = s->write(s->stream_obj, buf, size, &s->errcode);
-    if (s->errcode != 0) {
-        mp_raise_OSError(s->errcode);
+static void write_bytes(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+    if (size <= s->len - s->pos) {
+        memcpy(s->buf + s->pos, buf, size);
+        s->pos += size;
+        return;
     }
+    if (s->stream_obj == MP_OBJ_NULL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("buffer too small"));
+    }
+    sync_stream(s);
+    if (size < MSGPACK_WINDOW_SIZE) {
+        memcpy(s->buf, buf, size);
+        s->pos = size;
+        return;
+    }
+    mp_uint_t ret = s->write(s->stream_obj, buf, size, &s->errcode);
+    check_errcode(s);
     if (ret == 0) {
         mp_raise_msg(&mp_type_EOFError, NULL);
     }
 }
 
 static void write1(msgpack_stream_t *s, uint8_t obj) {
-    write(s, &obj, 1);
+    if (s->pos < s->len) {
+        s->buf[s->pos++] = obj;
+        return;
+    }
+    write_bytes(s, &obj, 1);
 }
 
 static void write2(msgpack_stream_t *s, uint16_t obj) {
@@ -129,7 +265,7 @@ static void write2(msgpack_stream_t *s, uint16_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap16(obj);
     }
-    write(s, &obj, 2);
+    write_bytes(s, &obj, 2);
 }
 
 static void write4(msgpack_stream_t *s, uint32_t obj) {
@@ -137,7 +273,7 @@ static void write4(msgpack_stream_t *s, uint32_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap32(obj);
     }
-    write(s, &obj, 4);
+    write_bytes(s, &obj, 4);
 }
 
 // compute and write msgpack size code (array structures)
@@ -192,7 +328,7 @@ static void pack_int(msgpack_stream_t *s, int32_t x) {
 static void pack_bin(msgpack_stream_t *s, const uint8_t *data, size_t len) {
     write_size(s, 0xc4, len);
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -212,7 +348,7 @@ static void pack_ext(msgpack_stream_t *s, int8_t code, const uint8_t *data, size
     }
     write1(s, code);    // type byte
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -223,7 +359,7 @@ static void pack_str(msgpack_stream_t *s, const char *str, size_t len) {
         write_size(s, 0xd9, len);
     }
     if (len > 0) {
-        write(s, str, len);
+        write_bytes(s, str, len);
     }
 }
 
@@ -314,7 +450,10 @@ static void pack(mp_obj_t obj, msgpack_stream_t *s, mp_obj_t default_handler) {
         } else if (default_handler != mp_const_none) {
             // set default_handler to mp_const_none to avoid infinite recursion
             // this also precludes some valid outputs
-            pack(mp_call_function_1(default_handler, obj), s, mp_const_none);
+            sync_stream(s);
+            mp_obj_t packable = mp_call_function_1(default_handler, obj);
+            resume_stream(s);
+            pack(packable, s, mp_const_none);
         } else {
             mp_raise_ValueError(MP_ERROR_TEXT("no default packer"));
         }
@@ -343,6 +482,10 @@ static mp_obj_t unpack_array_elements(msgpack_stream_t *s, size_t size, mp_obj_t
 }
 
 static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
+    const uint8_t *in_place = read_in_place(s, size);
+    if (in_place != NULL) {
+        return mp_obj_new_bytes(in_place, size);
+    }
     vstr_t vstr;
     vstr_init_len(&vstr, size);
     byte *p = (byte *)vstr.buf;
@@ -351,7 +494,7 @@ static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
     // read(s, p, size);
     while (size > 0) {
         int n = size > 256 ? 256 : size;
-        read(s, p, n);
+        read_bytes(s, p, n);
         size -= n;
         p += n;
     }
@@ -362,7 +505,10 @@ static mp_obj_t unpack_ext(msgpack_stream_t *s, size_t size, mp_obj_t ext_hook)
     int8_t code = read1(s);
     mp_obj_t data = unpack_bytes(s, size);
     if (ext_hook != mp_const_none) {
-        return mp_call_function_2(ext_hook, MP_OBJ_NEW_SMALL_INT(code), data);
+        sync_stream(s);
+        mp_obj_t res = mp_call_function_2(ext_hook, MP_OBJ_NEW_SMALL_INT(code), data);
+        resume_stream(s);
+        return res;
     } else {
         mod_msgpack_extype_obj_t *o = mp_obj_malloc(mod_msgpack_extype_obj_t, &mod_msgpack_exttype_type);
         o->code = code;
@@ -380,9 +526,13 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
     if ((code & 0b11100000) == 0b10100000) {
         // str
         size_t len = code & 0b11111;
+        const uint8_t *in_place = read_in_place(s, len);
+        if (in_place != NULL) {
+            return mp_obj_new_str((const char *)in_place, len);
+        }
         // allocate on stack; len < 32
         char str[len];
-        read(s, &str, len);
+        read_bytes(s, &str, len);
         return mp_obj_new_str(str, len);
     }
     if ((code & 0b11110000) == 0b10010000) {
@@ -394,7 +544,8 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         size_t len = code & 0b1111;
         mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
         for (size_t i = 0; i < len; i++) {
-            mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
+            mp_obj_t key = unpack(s, ext_hook, use_list);
+            mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
         }
         return MP_OBJ_FROM_PTR(d);
     }
@@ -450,10 +601,14 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         case 0xdb: {
             // str 8, 16, 32
             size_t size = read_size(s, code - 0xd9);
+            const uint8_t *in_place = read_in_place(s, size);
+            if (in_place != NULL) {
+                return mp_obj_new_str((const char *)in_place, size);
+            }
             vstr_t vstr;
             vstr_init_len(&vstr, size);
             byte *p = (byte *)vstr.buf;
-            read(s, p, size);
+            read_bytes(s, p, size);
             return mp_obj_new_str_from_vstr(&vstr);
         }
         case 0xde:
@@ -462,7 +617,8 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             size_t len = read_size(s, code - 0xde + 1);
             mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
             for (size_t i = 0; i < len; i++) {
-                mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
+                mp_obj_t key = unpack(s, ext_hook, use_list);
+                mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
             }
             return MP_OBJ_FROM_PTR(d);
         }
@@ -494,11 +650,44 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
 }
 
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler) {
-    msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_WRITE);
+    uint8_t window[MSGPACK_WINDOW_SIZE];
+    msgpack_stream_t stream;
+    get_stream(&stream, stream_obj, MP_STREAM_OP_WRITE, window);
+    pack(obj, &stream, default_handler);
+    sync_stream(&stream);
+}
+
+size_t common_hal_msgpack_pack_into(mp_obj_t obj, mp_obj_t buffer_obj, mp_int_t offset, mp_obj_t default_handler) {
+    msgpack_stream_t stream;
+    get_buffer(&stream, buffer_obj, offset, MP_BUFFER_WRITE);
     pack(obj, &stream, default_handler);
+    return stream.pos - offset;
 }
 
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list) {
-    msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_READ);
-    return unpack(&stream, ext_hook, use_list);
+    uint8_t window[MSGPACK_WINDOW_SIZE];
+    msgpack_stream_t stream;
+    get_stream(&stream, stream_obj, MP_STREAM_OP_READ, window);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) != 0) {
+        // Leave the stream just after the bytes that were parsed, as if there had been no read
+        // ahead. The original exception is the one to report, so a failed seek is ignored.
+        if (stream.read_ahead && stream.pos < stream.len) {
+            int errcode;
+            mp_stream_seek(stream.stream_obj, -(mp_off_t)(stream.len - stream.pos), MP_SEEK_CUR, &errcode);
+        }
+        nlr_jump(nlr.ret_val);
+    }
+    mp_obj_t res = unpack(&stream, ext_hook, use_list);
+    nlr_pop();
+    sync_stream(&stream);
+    return res;
+}
+
+mp_obj_t common_hal_msgpack_unpack_from(mp_obj_t buffer_obj, mp_int_t offset, mp_obj_t ext_hook, bool use_list, size_t *end_offset) {
+    msgpack_stream_t stream;
+    get_buffer(&stream, buffer_obj, offset, MP_BUFFER_READ);
+    mp_obj_t res = unpack(&stream, ext_hook, use_list);
+    *end_offset = stream.pos;
+    return res;
 }
@@ -135,6 +135,8 @@ const char *common_hal_os_path_abspath(const char *path) {
 }
 
 void common_hal_os_chdir(const char *path) {
+    // Imports of relative paths are cached too.
+    mp_vfs_import_cache_clear();
     MP_STATE_VM(cwd_path) = common_hal_os_path_abspath(path);
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_dir_path(MP_STATE_VM(cwd_path), &path_out);
@@ -197,6 +199,7 @@ void common_hal_os_mkdir(const char *path) {
     if (vfs == MP_VFS_ROOT || (vfs != MP_VFS_NONE && !strcmp(mp_obj_str_get_str(path_out), "/"))) {
         mp_raise_OSError(MP_EEXIST);
     }
+    mp_vfs_import_cache_clear();
     mp_vfs_proxy_call(vfs, MP_QSTR_mkdir, 1, &path_out);
 }
 
@@ -204,6 +207,7 @@ void common_hal_os_remove(const char *path) {
     const char *abspath = common_hal_os_path_abspath(path);
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(abspath, &path_out);
+    mp_vfs_import_cache_clear();
     mp_vfs_proxy_call(vfs, MP_QSTR_remove, 1, &path_out);
 }
 
@@ -215,6 +219,7 @@ void common_hal_os_rename(const char *old_path, const char *new_path) {
         // can't rename across filesystems
         mp_raise_OSError(MP_EPERM);
     }
+    mp_vfs_import_cache_clear();
     mp_vfs_proxy_call(old_vfs, MP_QSTR_rename, 2, args);
 }
 
@@ -222,6 +227,7 @@ void common_hal_os_rmdir(const char *path) {
     const char *abspath = common_hal_os_path_abspath(path);
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_dir_path(abspath, &path_out);
+    mp_vfs_import_cache_clear();
     mp_vfs_proxy_call(vfs, MP_QSTR_rmdir, 1, &path_out);
 }
 
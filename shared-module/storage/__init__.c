@@ -131,6 +131,7 @@ void common_hal_storage_mount(mp_obj_t vfs_obj, const char *mount_path, bool rea
     mp_vfs_mount_t **vfsp = &MP_STATE_VM(vfs_mount_table);
     vfs->next = *vfsp;
     *vfsp = vfs;
+    mp_vfs_import_cache_clear();
 }
 
 void common_hal_storage_umount_object(mp_obj_t vfs_obj) {
@@ -152,6 +153,7 @@ void common_hal_storage_umount_object(mp_obj_t vfs_obj) {
     if (MP_STATE_VM(vfs_cur) == vfs) {
         MP_STATE_VM(vfs_cur) = MP_VFS_ROOT;
     }
+    mp_vfs_import_cache_clear();
 
     // call the underlying object to do any unmounting operation
     mp_vfs_proxy_call(vfs, MP_QSTR_umount, 0, NULL);
@@ -183,6 +185,12 @@ void common_hal_storage_remount(const char *mount_path, bool readonly, bool disa
         mp_raise_OSError(MP_EINVAL);
     }
 
+    // Imported code may be running from the filesystem in place. It can't be
+    // changed until the VM ends.
+    if ((fs_usermount->blockdev.flags & MP_BLOCKDEV_FLAG_MAPPED) != 0) {
+        mp_raise_OSError(MP_EBUSY);
+    }
+
     #if CIRCUITPY_USB_DEVICE && CIRCUITPY_USB_MSC
     if (!blockdev_lock(fs_usermount)) {
         mp_raise_RuntimeError(MP_ERROR_TEXT("Cannot remount path when visible via USB."));
@@ -192,6 +200,7 @@ void common_hal_storage_remount(const char *mount_path, bool readonly, bool disa
     filesystem_set_writable_by_usb(fs_usermount, readonly);
     filesystem_set_concurrent_write_protection(fs_usermount, !disable_concurrent_write_protection);
     blockdev_unlock(fs_usermount);
+    mp_vfs_import_cache_clear();
 
     #if CIRCUITPY_USB_DEVICE && CIRCUITPY_USB_MSC
     usb_msc_remount(fs_usermount);
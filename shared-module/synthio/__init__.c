@@ -171,7 +171,20 @@ int16_t synthio_mix_down_sample(int32_t sample, int32_t scale) {
     return sample;
 }
 
-static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *out_buffer32, int16_t dur, int16_t loudness[2]) {
+// How a voice sounds during one block: the waveform it reads, the span of the
+// waveform that loops, and the phase increment per sample, each in the fixed
+// point format of synth->accum. The ring fields are only used if ring_dds_rate
+// is nonzero.
+typedef struct {
+    const int16_t *waveform;
+    uint32_t offset, lim, dds_rate;
+    const int16_t *ring_waveform;
+    uint32_t ring_offset, ring_lim, ring_dds_rate;
+} synthio_oscillator_t;
+
+// Works out how voice chan sounds for the next dur samples, and steps its note.
+// Returns false if the voice can't be played, e.g. because it is above nyquist.
+static bool synth_note_setup(synthio_synth_t *synth, int chan, synthio_oscillator_t *osc, int16_t dur, int16_t loudness[2]) {
     mp_obj_t note_obj = synth->span.note_obj[chan];
 
     int32_t sample_rate = synth->base.sample_rate;
@@ -220,62 +233,152 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
         }
     }
 
-    uint32_t offset = waveform_start << SYNTHIO_FREQUENCY_SHIFT;
-    uint32_t lim = waveform_length << SYNTHIO_FREQUENCY_SHIFT;
-    uint32_t accum = synth->accum[chan];
+    osc->waveform = waveform;
+    osc->offset = waveform_start << SYNTHIO_FREQUENCY_SHIFT;
+    osc->lim = waveform_length << SYNTHIO_FREQUENCY_SHIFT;
+    osc->dds_rate = dds_rate;
 
-    if (dds_rate > lim / 2) {
+    if (dds_rate > osc->lim / 2) {
         // beyond nyquist, can't play note
         return false;
     }
 
+    if (ring_dds_rate > osc->lim / 2) {
+        // beyond nyquist, can't play ring (but can play the main sound)
+        ring_dds_rate = 0;
+    }
+    osc->ring_waveform = ring_waveform;
+    osc->ring_offset = ring_waveform_start << SYNTHIO_FREQUENCY_SHIFT;
+    osc->ring_lim = ring_waveform_length << SYNTHIO_FREQUENCY_SHIFT;
+    osc->ring_dds_rate = ring_dds_rate;
+
     // can happen if note waveform gets set mid-note, but the expensive modulo is usually avoided
-    if (accum > lim) {
-        accum = accum % lim + offset;
+    if (synth->accum[chan] > osc->lim) {
+        synth->accum[chan] = synth->accum[chan] % osc->lim + osc->offset;
     }
+    if (ring_dds_rate && synth->ring_accum[chan] > osc->ring_lim) {
+        synth->ring_accum[chan] = synth->ring_accum[chan] % osc->ring_lim + osc->ring_offset;
+    }
+    return true;
+}
+
+// Advances a phase accumulator by one sample and returns the waveform sample
+// it then points at.
+__attribute__((always_inline))
+static inline int32_t synth_oscillator_next(const int16_t *waveform, uint32_t *accum, uint32_t dds_rate, uint32_t lim, uint32_t offset) {
+    *accum += dds_rate;
+    // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
+    if (*accum > lim) {
+        *accum = *accum - lim + offset;
+    }
+    return waveform[*accum >> SYNTHIO_FREQUENCY_SHIFT];
+}
 
+// Renders voice chan into out_buffer32, for voices that need further
+// processing before they are scaled by their loudness and summed.
+static void synth_note_into_buffer(synthio_synth_t *synth, int chan, const synthio_oscillator_t *osc, int32_t *out_buffer32, int16_t dur) {
     // first, fill with waveform
+    uint32_t accum = synth->accum[chan];
     for (uint16_t i = 0; i < dur; i++) {
-        accum += dds_rate;
-        // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
-        if (accum > lim) {
-            accum = accum - lim + offset;
-        }
-        int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
-        out_buffer32[i] = waveform[idx];
+        out_buffer32[i] = synth_oscillator_next(osc->waveform, &accum, osc->dds_rate, osc->lim, osc->offset);
     }
     synth->accum[chan] = accum;
 
-    if (ring_dds_rate) {
-        if (ring_dds_rate > lim / 2) {
-            // beyond nyquist, can't play ring (but did synth main sound so
-            // return true)
-            return true;
-        }
-
+    if (osc->ring_dds_rate) {
         // now modulate by ring and accumulate
         accum = synth->ring_accum[chan];
-        offset = ring_waveform_start << SYNTHIO_FREQUENCY_SHIFT;
-        lim = ring_waveform_length << SYNTHIO_FREQUENCY_SHIFT;
-
-        // can happen if note waveform gets set mid-note, but the expensive modulo is usually avoided
-        if (accum > lim) {
-            accum = accum % lim + offset;
+        for (uint16_t i = 0; i < dur; i++) {
+            int32_t ring = synth_oscillator_next(osc->ring_waveform, &accum, osc->ring_dds_rate, osc->ring_lim, osc->ring_offset);
+            int16_t wi = (ring * out_buffer32[i]) / 32768; // consider for synthio_sat16 but had a weird artificat
+            out_buffer32[i] = wi;
         }
+        synth->ring_accum[chan] = accum;
+    }
+}
 
+// Voices that need neither ring modulation nor a filter, stored as a structure
+// of arrays so that they can be rendered together, straight into the mix
+// without going through a temporary buffer.
+typedef struct {
+    uint8_t count;
+    uint8_t chan[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    const int16_t *waveform[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    uint32_t accum[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    uint32_t dds_rate[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    uint32_t lim[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    uint32_t offset[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    int16_t loudness[2][CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+} synthio_voice_batch_t;
+
+static void synth_batch_add(synthio_voice_batch_t *batch, synthio_synth_t *synth, int chan, const synthio_oscillator_t *osc, int16_t loudness[2]) {
+    uint8_t v = batch->count++;
+    batch->chan[v] = chan;
+    batch->waveform[v] = osc->waveform;
+    batch->accum[v] = synth->accum[chan];
+    batch->dds_rate[v] = osc->dds_rate;
+    batch->lim[v] = osc->lim;
+    batch->offset[v] = osc->offset;
+    batch->loudness[0][v] = loudness[0];
+    batch->loudness[1][v] = loudness[1];
+}
+
+// Same as synthio_sat16(sample * loudness, 16), which can't saturate for a
+// waveform sample and a loudness that both fit in 16 bits.
+__attribute__((always_inline))
+static inline int32_t synth_scale_by_loudness(int32_t sample, int16_t loudness) {
+    int32_t n = sample * loudness;
+    return (n + ((n >> 31) & 0xffff)) >> 16;
+}
+
+// Renders and sums all voices of the batch. Voices are done two at a time, so
+// that each sample of the mix is loaded and stored once per pair of voices.
+static void synth_batch_render(synthio_voice_batch_t *batch, synthio_synth_t *synth, int32_t *out_buffer32, uint16_t dur) {
+    int channel_count = synth->base.channel_count;
+    uint8_t v = 0;
+    for (; v + 2 <= batch->count; v += 2) {
+        const int16_t *wa = batch->waveform[v], *wb = batch->waveform[v + 1];
+        uint32_t accum_a = batch->accum[v], accum_b = batch->accum[v + 1];
+        uint32_t rate_a = batch->dds_rate[v], rate_b = batch->dds_rate[v + 1];
+        uint32_t lim_a = batch->lim[v], lim_b = batch->lim[v + 1];
+        uint32_t offset_a = batch->offset[v], offset_b = batch->offset[v + 1];
+        int16_t left_a = batch->loudness[0][v], left_b = batch->loudness[0][v + 1];
+        int32_t *out = out_buffer32;
+        if (channel_count == 1) {
+            for (uint16_t i = 0; i < dur; i++) {
+                int32_t a = synth_oscillator_next(wa, &accum_a, rate_a, lim_a, offset_a);
+                int32_t b = synth_oscillator_next(wb, &accum_b, rate_b, lim_b, offset_b);
+                *out++ += synth_scale_by_loudness(a, left_a) + synth_scale_by_loudness(b, left_b);
+            }
+        } else {
+            int16_t right_a = batch->loudness[1][v], right_b = batch->loudness[1][v + 1];
+            for (uint16_t i = 0; i < dur; i++) {
+                int32_t a = synth_oscillator_next(wa, &accum_a, rate_a, lim_a, offset_a);
+                int32_t b = synth_oscillator_next(wb, &accum_b, rate_b, lim_b, offset_b);
+                *out++ += synth_scale_by_loudness(a, left_a) + synth_scale_by_loudness(b, left_b);
+                *out++ += synth_scale_by_loudness(a, right_a) + synth_scale_by_loudness(b, right_b);
+            }
+        }
+        batch->accum[v] = accum_a;
+        batch->accum[v + 1] = accum_b;
+    }
+    if (v < batch->count) {
+        const int16_t *wa = batch->waveform[v];
+        uint32_t accum_a = batch->accum[v];
+        uint32_t rate_a = batch->dds_rate[v], lim_a = batch->lim[v], offset_a = batch->offset[v];
+        int16_t left_a = batch->loudness[0][v], right_a = batch->loudness[1][v];
+        int32_t *out = out_buffer32;
         for (uint16_t i = 0; i < dur; i++) {
-            accum += ring_dds_rate;
-            // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
-            if (accum > lim) {
-                accum = accum - lim + offset;
+            int32_t a = synth_oscillator_next(wa, &accum_a, rate_a, lim_a, offset_a);
+            *out++ += synth_scale_by_loudness(a, left_a);
+            if (channel_count == 2) {
+                *out++ += synth_scale_by_loudness(a, right_a);
             }
-            int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
-            int16_t wi = (ring_waveform[idx] * out_buffer32[i]) / 32768; // consider for synthio_sat16 but had a weird artificat
-            out_buffer32[i] = wi;
         }
-        synth->ring_accum[chan] = accum;
+        batch->accum[v] = accum_a;
+    }
+    for (v = 0; v < batch->count; v++) {
+        synth->accum[batch->chan[v]] = batch->accum[v];
     }
-    return true;
 }
 
 static mp_obj_t synthio_synth_get_note_filter(mp_obj_t note_obj) {
@@ -323,6 +426,9 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
     int32_t tmp_buffer32[SYNTHIO_MAX_DUR];
     memset(out_buffer32, 0, synth->base.channel_count * dur * sizeof(int32_t));
 
+    synthio_voice_batch_t batch;
+    batch.count = 0;
+
     for (int chan = 0; chan < CIRCUITPY_SYNTHIO_MAX_CHANNELS; chan++) {
         mp_obj_t note_obj = synth->span.note_obj[chan];
         if (note_obj == SYNTHIO_SILENCE) {
@@ -337,13 +443,21 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
 
         int16_t loudness[2] = {synth->envelope_state[chan].level, synth->envelope_state[chan].level};
 
-        if (!synth_note_into_buffer(synth, chan, tmp_buffer32, dur, loudness)) {
+        synthio_oscillator_t osc;
+        if (!synth_note_setup(synth, chan, &osc, dur, loudness)) {
             // for some other reason, such as being above nyquist, note
             // couldn't be synthed, so don't filter or sum it in
             continue;
         }
 
         mp_obj_t filter_obj = synthio_synth_get_note_filter(note_obj);
+        if (filter_obj == mp_const_none && !osc.ring_dds_rate) {
+            synth_batch_add(&batch, synth, chan, &osc, loudness);
+            continue;
+        }
+
+        synth_note_into_buffer(synth, chan, &osc, tmp_buffer32, dur);
+
         if (filter_obj != mp_const_none) {
             synthio_note_obj_t *note = MP_OBJ_TO_PTR(note_obj);
             common_hal_synthio_biquad_tick(filter_obj);
@@ -354,6 +468,8 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
         sum_with_loudness(out_buffer32, tmp_buffer32, loudness, dur, synth->base.channel_count);
     }
 
+    synth_batch_render(&batch, synth, out_buffer32, dur);
+
     int16_t *out_buffer16 = (int16_t *)(void *)synth->buffers[synth->buffer_index];
 
     // mix down audio
@@ -19,6 +19,40 @@
 // #define VECTORIO_POLYGON_DEBUG(...) mp_printf(&mp_plat_print, __VA_ARGS__)
 
 
+// Fills in the edges from points_list, ordered by the first row they cross. Horizontal edges
+// never change the winding number, so they are left out.
+static void _build_edge_table(vectorio_polygon_t *self) {
+    uint16_t edge_count = 0;
+    for (uint16_t i = 0; i < self->len; i += 2) {
+        int16_t x1 = self->points_list[i];
+        int16_t y1 = self->points_list[i + 1];
+        int16_t x2 = self->points_list[(i + 2) % self->len];
+        int16_t y2 = self->points_list[(i + 3) % self->len];
+        if (y1 == y2) {
+            continue;
+        }
+        vectorio_polygon_edge_t edge;
+        if (y1 < y2) {
+            edge = (vectorio_polygon_edge_t) { .dx = x2 - x1, .x = x1, .y1 = y1, .y2 = y2, .winding = 1 };
+        } else {
+            edge = (vectorio_polygon_edge_t) { .dx = x1 - x2, .x = x2, .y1 = y2, .y2 = y1, .winding = -1 };
+        }
+        // Polygons usually have few points, so an insertion sort is enough.
+        uint16_t j = edge_count;
+        while (j > 0 && self->edges[j - 1].y1 > edge.y1) {
+            self->edges[j] = self->edges[j - 1];
+            j--;
+        }
+        self->edges[j] = edge;
+        edge_count++;
+    }
+    self->edge_count = edge_count;
+    self->active_count = 0;
+    self->next_edge = 0;
+    // No row comes after this one, so the next row rasterized builds the table afresh.
+    self->active_y = SHRT_MAX;
+}
+
 // Converts a list of points tuples to a flat list of ints for speedier internal use.
 // Also validates the points. If this fails due to invalid types or values, the
 // number of points is 0 and the points_list is NULL.
@@ -38,6 +72,12 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
     // In case the validation calls below fail, set these values temporarily
     self->points_list = NULL;
     self->len = 0;
+    self->edge_count = 0;
+    self->active_count = 0;
+
+    // There is at most one edge per point.
+    self->edges = gc_realloc(self->edges, len * sizeof(vectorio_polygon_edge_t), true);
+    self->active_edges = gc_realloc(self->active_edges, len * sizeof(vectorio_polygon_active_edge_t), true);
 
     for (uint16_t i = 0; i < len; ++i) {
         size_t tuple_len = 0;
@@ -57,6 +97,7 @@ static void _clobber_points_list(vectorio_polygon_t *self, mp_obj_t points_tuple
 
     self->points_list = points_list;
     self->len = 2 * len;
+    _build_edge_table(self);
 }
 
 
@@ -65,6 +106,8 @@ void common_hal_vectorio_polygon_construct(vectorio_polygon_t *self, mp_obj_t po
     VECTORIO_POLYGON_DEBUG("%p polygon_construct: ", self);
     self->points_list = NULL;
     self->len = 0;
+    self->edges = NULL;
+    self->active_edges = NULL;
     self->on_dirty.obj = NULL;
     self->color_index = color_index + 1;
     _clobber_points_list(self, points_list);
@@ -185,6 +228,74 @@ uint32_t common_hal_vectorio_polygon_get_pixel(void *obj, int16_t x, int16_t y)
     return winding_number == 0 ? 0 : self->color_index;
 }
 
+// Rasterizes a row with an active edge table. A pixel is inside when get_pixel would give it a
+// nonzero winding number: the sum of the windings of the edges that cross the row right of it.
+uint16_t common_hal_vectorio_polygon_get_spans(void *obj, int16_t y, vectorio_span_t *spans, uint16_t max_spans, uint32_t *out_pixel) {
+    vectorio_polygon_t *self = obj;
+    *out_pixel = self->color_index;
+
+    vectorio_polygon_active_edge_t *active = self->active_edges;
+    uint16_t active_count = 0;
+    if (y == self->active_y + 1) {
+        // Keep the edges that continue onto this row, in their order on the last one.
+        for (uint16_t i = 0; i < self->active_count; i++) {
+            if (self->edges[active[i].edge].y2 > y) {
+                active[active_count++] = active[i];
+            }
+        }
+    } else {
+        self->next_edge = 0;
+    }
+    // Edges are added in the order of the table, and the ones that end above this row skipped.
+    while (self->next_edge < self->edge_count && self->edges[self->next_edge].y1 <= y) {
+        if (self->edges[self->next_edge].y2 > y) {
+            active[active_count++].edge = self->next_edge;
+        }
+        self->next_edge++;
+    }
+    self->active_count = active_count;
+    self->active_y = y;
+
+    for (uint16_t i = 0; i < active_count; i++) {
+        const vectorio_polygon_edge_t *edge = &self->edges[active[i].edge];
+        // The edge passes pixel x when x is less than where it crosses the row, so round that up.
+        int32_t numerator = (int32_t)(y - edge->y1) * edge->dx;
+        int32_t denominator = edge->y2 - edge->y1;
+        int32_t offset = numerator / denominator;
+        if (numerator > 0 && numerator % denominator != 0) {
+            offset++;
+        }
+        vectorio_polygon_active_edge_t current = { .x = edge->x + offset, .edge = active[i].edge };
+        // Edges rarely cross each other, so the order from the last row is nearly right.
+        uint16_t j = i;
+        while (j > 0 && active[j - 1].x > current.x) {
+            active[j] = active[j - 1];
+            j--;
+        }
+        active[j] = current;
+    }
+
+    // Left of all of the edges, every crossing is counted and they add up to zero.
+    uint16_t span_count = 0;
+    int16_t winding_number = 0;
+    int16_t span_start = 0;
+    for (uint16_t i = 0; i < active_count; i++) {
+        int16_t x = active[i].x;
+        bool was_inside = winding_number != 0;
+        winding_number -= self->edges[active[i].edge].winding;
+        if (!was_inside && winding_number != 0) {
+            span_start = x;
+        } else if (was_inside && winding_number == 0 && x > span_start) {
+            if (span_count < max_spans) {
+                spans[span_count].x1 = span_start;
+                spans[span_count].x2 = x;
+            }
+            span_count++;
+        }
+    }
+    return span_count;
+}
+
 mp_obj_t common_hal_vectorio_polygon_get_draw_protocol(void *polygon) {
     vectorio_polygon_t *self = polygon;
     return self->draw_protocol_instance;
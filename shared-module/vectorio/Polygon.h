@@ -11,11 +11,40 @@
 #include "py/obj.h"
 #include "shared-module/vectorio/__init__.h"
 
+// An edge of the polygon that isn't horizontal, from its top end to its bottom end.
+typedef struct {
+    // x at the bottom minus x at the top.
+    int32_t dx;
+    // x at the top.
+    int16_t x;
+    // The first row the edge crosses, and the row after the last.
+    int16_t y1;
+    int16_t y2;
+    // 1 if the edge goes down the screen, -1 if it goes up.
+    int8_t winding;
+} vectorio_polygon_edge_t;
+
+// An edge that crosses the row that was last rasterized.
+typedef struct {
+    // The first pixel on the row that is right of the edge.
+    int16_t x;
+    uint16_t edge;
+} vectorio_polygon_active_edge_t;
+
 typedef struct {
     mp_obj_base_t base;
     // An int array[ x, y, ... ]
     int16_t *points_list;
     uint16_t len;
+    // The edges ordered by y1, and the active edge table for row active_y ordered by x. The
+    // active edges are updated from one row to the next instead of being found again.
+    vectorio_polygon_edge_t *edges;
+    vectorio_polygon_active_edge_t *active_edges;
+    uint16_t edge_count;
+    uint16_t active_count;
+    // The first edge in edges that starts below active_y.
+    uint16_t next_edge;
+    int16_t active_y;
     uint16_t color_index;
     vectorio_event_t on_dirty;
     mp_obj_t draw_protocol_instance;
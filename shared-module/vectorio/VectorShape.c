@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "stdlib.h"
+#include <string.h>
 
 #include "shared-module/vectorio/__init__.h"
 #include "shared-bindings/vectorio/VectorShape.h"
@@ -19,6 +20,9 @@
 #include "shared-bindings/vectorio/Polygon.h"
 #include "shared-bindings/vectorio/Rectangle.h"
 
+// Rows with more runs than this are drawn a pixel at a time.
+#define VECTORIO_SHAPE_MAX_SPANS (16)
+
 // Lifecycle actions.
 #define VECTORIO_SHAPE_DEBUG(...) (void)0
 // #define VECTORIO_SHAPE_DEBUG(...) mp_printf(&mp_plat_print, __VA_ARGS__)
@@ -326,6 +330,163 @@ void common_hal_vectorio_vector_shape_set_pixel_shader(vectorio_vector_shape_t *
     common_hal_vectorio_vector_shape_set_dirty(self);
 }
 
+// Colors a pixel value from a shape. vectorio shapes use 0 to mean "area is not covered", so the
+// value is pulled down to 0-base for more error-resistant palettes.
+static void _shade_pixel(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_pixel) {
+    input_pixel->pixel -= 1;
+    output_pixel->pixel = 0;
+    output_pixel->opaque = true;
+
+    if (self->pixel_shader == mp_const_none) {
+        output_pixel->pixel = input_pixel->pixel;
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        displayio_palette_get_color(self->pixel_shader, colorspace, input_pixel, output_pixel);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        displayio_colorconverter_convert(self->pixel_shader, colorspace, input_pixel, output_pixel);
+    }
+}
+
+// Whether the pixel shader gives every pixel with the same value the same color.
+static bool _shader_is_uniform(vectorio_vector_shape_t *self) {
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        return !common_hal_displayio_palette_get_dither(self->pixel_shader);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        return !common_hal_displayio_colorconverter_get_dither(self->pixel_shader);
+    }
+    return true;
+}
+
+static void _write_pixel(const _displayio_colorspace_t *colorspace, uint16_t linestride_px, uint32_t *buffer, uint32_t pixel_index, uint32_t pixel) {
+    if (colorspace->depth == 16) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 16", pixel);
+        *(((uint16_t *)buffer) + pixel_index) = pixel;
+    } else if (colorspace->depth == 32) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 32", pixel);
+        *(((uint32_t *)buffer) + pixel_index) = pixel;
+    } else if (colorspace->depth == 8) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %02x 8", pixel);
+        *(((uint8_t *)buffer) + pixel_index) = pixel;
+    } else if (colorspace->depth < 8) {
+        uint8_t pixels_per_byte = 8 / colorspace->depth;
+        // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
+        if (!colorspace->pixels_in_byte_share_row) {
+            uint32_t row = pixel_index / linestride_px;
+            uint32_t col = pixel_index % linestride_px;
+            pixel_index = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * linestride_px + row % pixels_per_byte;
+        }
+        uint8_t shift = (pixel_index % pixels_per_byte) * colorspace->depth;
+        if (colorspace->reverse_pixels_in_byte) {
+            // Reverse the shift by subtracting it from the leftmost shift.
+            shift = (pixels_per_byte - 1) * colorspace->depth - shift;
+        }
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %2d %d", pixel, colorspace->depth);
+        ((uint8_t *)buffer)[pixel_index / pixels_per_byte] |= pixel << shift;
+    }
+}
+
+// Draws the screen pixel x, y unless the mask shows it has already been set. Returns false if the
+// shape leaves it uncovered or transparent.
+static bool _fill_pixel(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, int16_t x, int16_t y, uint32_t *mask, uint32_t *buffer) {
+    uint16_t linestride_px = displayio_area_width(area);
+    uint32_t pixel_index = (y - area->y1) * linestride_px + (x - area->x1);
+    uint32_t *mask_doubleword = &(mask[pixel_index / 32]);
+    uint8_t mask_bit = pixel_index % 32;
+    VECTORIO_SHAPE_PIXEL_DEBUG("\n%p pixel_index: %5u mask_bit: %2u mask: "U32_TO_BINARY_FMT, self, pixel_index, mask_bit, U32_TO_BINARY(*mask_doubleword));
+    if ((*mask_doubleword & (1u << mask_bit)) != 0) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" masked");
+        return true;
+    }
+
+    // Cast input screen coordinates to shape coordinates to pick the pixel to draw
+    int16_t pixel_to_get_x;
+    int16_t pixel_to_get_y;
+    screen_to_shape_coordinates(self, x, y, &pixel_to_get_x, &pixel_to_get_y);
+
+    VECTORIO_SHAPE_PIXEL_DEBUG(" get_pixel %p (%3d, %3d) -> ( %3d, %3d )", self->ishape.shape, x, y, pixel_to_get_x, pixel_to_get_y);
+    displayio_input_pixel_t input_pixel = {
+        .pixel = self->ishape.get_pixel(self->ishape.shape, pixel_to_get_x, pixel_to_get_y),
+        .x = x,
+        .y = y,
+        .tile_x = pixel_to_get_x,
+        .tile_y = pixel_to_get_y,
+    };
+    VECTORIO_SHAPE_PIXEL_DEBUG(" -> %d", input_pixel.pixel);
+
+    // We can skip all the rest of the work for this pixel if it's not currently covered by the shape.
+    if (input_pixel.pixel == 0) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel; input area is not fully covered)");
+        return false;
+    }
+    displayio_output_pixel_t output_pixel;
+    _shade_pixel(self, colorspace, &input_pixel, &output_pixel);
+
+    *mask_doubleword |= 1u << mask_bit;
+    _write_pixel(colorspace, linestride_px, buffer, pixel_index, output_pixel.pixel);
+    return output_pixel.opaque;
+}
+
+// Draws pixel over a run of count buffer pixels, step apart, leaving the ones that are already
+// masked alone. Returns how many were drawn.
+static uint32_t _fill_run(const _displayio_colorspace_t *colorspace, uint16_t linestride_px, uint32_t *mask, uint32_t *buffer, uint32_t pixel_index, uint16_t count, uint16_t step, uint32_t pixel) {
+    uint32_t drawn = 0;
+    if (step != 1) {
+        for (; count > 0; count--, pixel_index += step) {
+            uint32_t mask_bit = 1u << (pixel_index % 32);
+            if ((mask[pixel_index / 32] & mask_bit) == 0) {
+                mask[pixel_index / 32] |= mask_bit;
+                _write_pixel(colorspace, linestride_px, buffer, pixel_index, pixel);
+                drawn++;
+            }
+        }
+        return drawn;
+    }
+    // Along a row, the mask is checked and set a word at a time.
+    while (count > 0) {
+        uint32_t *mask_doubleword = &mask[pixel_index / 32];
+        uint8_t first_bit = pixel_index % 32;
+        uint8_t bit_count = MIN(count, 32 - first_bit);
+        uint32_t run_bits = (bit_count == 32 ? 0xffffffff : (1u << bit_count) - 1) << first_bit;
+        uint32_t unmasked = run_bits & ~*mask_doubleword;
+        *mask_doubleword |= run_bits;
+        if (unmasked == run_bits && colorspace->depth >= 8) {
+            if (colorspace->depth == 16) {
+                uint16_t *pixels = ((uint16_t *)buffer) + pixel_index;
+                for (uint8_t i = 0; i < bit_count; i++) {
+                    pixels[i] = pixel;
+                }
+            } else if (colorspace->depth == 32) {
+                uint32_t *pixels = buffer + pixel_index;
+                for (uint8_t i = 0; i < bit_count; i++) {
+                    pixels[i] = pixel;
+                }
+            } else if (colorspace->depth == 8) {
+                memset(((uint8_t *)buffer) + pixel_index, pixel, bit_count);
+            }
+            drawn += bit_count;
+        } else {
+            uint32_t word_start = pixel_index - first_bit;
+            while (unmasked != 0) {
+                _write_pixel(colorspace, linestride_px, buffer, word_start + __builtin_ctz(unmasked), pixel);
+                unmasked &= unmasked - 1;
+                drawn++;
+            }
+        }
+        pixel_index += bit_count;
+        count -= bit_count;
+    }
+    return drawn;
+}
+
+// Whether any of count buffer pixels, step apart, hasn't been masked.
+static bool _any_unmasked(const uint32_t *mask, uint32_t pixel_index, uint16_t count, uint16_t step) {
+    for (; count > 0; count--, pixel_index += step) {
+        if ((mask[pixel_index / 32] & (1u << (pixel_index % 32))) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     // Shape areas are relative to 0,0.  This will allow rotation about a known axis.
     //   The consequence is that the area reported by the shape itself is _relative_ to 0,0.
@@ -354,7 +515,6 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
 
     bool full_coverage = displayio_area_equal(area, &overlap);
 
-    uint8_t pixels_per_byte = 8 / colorspace->depth;
     VECTORIO_SHAPE_DEBUG(" xy:(%3d %3d) tform:{x:%d y:%d dx:%d dy:%d scl:%d w:%d h:%d mx:%d my:%d tr:%d}",
         self->x, self->y,
         self->absolute_transform->x, self->absolute_transform->y, self->absolute_transform->dx, self->absolute_transform->dy, self->absolute_transform->scale,
@@ -362,100 +522,149 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
         );
 
     uint16_t linestride_px = displayio_area_width(area);
-    uint16_t line_dirty_offset_px = (overlap.y1 - area->y1) * linestride_px;
-    uint16_t column_dirty_offset_px = overlap.x1 - area->x1;
-    VECTORIO_SHAPE_DEBUG(", linestride:%3d line_offset:%3d col_offset:%3d depth:%2d ppb:%2d shape:%s",
-        linestride_px, line_dirty_offset_px, column_dirty_offset_px, colorspace->depth, pixels_per_byte, mp_obj_get_type_str(self->ishape.shape));
-
-    displayio_input_pixel_t input_pixel;
-    displayio_output_pixel_t output_pixel;
-
-    displayio_area_t shape_area;
-    self->ishape.get_area(self->ishape.shape, &shape_area);
-
-    uint16_t mask_start_px = line_dirty_offset_px;
-    for (input_pixel.y = overlap.y1; input_pixel.y < overlap.y2; ++input_pixel.y) {
-        mask_start_px += column_dirty_offset_px;
-        for (input_pixel.x = overlap.x1; input_pixel.x < overlap.x2; ++input_pixel.x) {
-            // Check the mask first to see if the pixel has already been set.
-            uint16_t pixel_index = mask_start_px + (input_pixel.x - overlap.x1);
-            uint32_t *mask_doubleword = &(mask[pixel_index / 32]);
-            uint8_t mask_bit = pixel_index % 32;
-            VECTORIO_SHAPE_PIXEL_DEBUG("\n%p pixel_index: %5u mask_bit: %2u mask: "U32_TO_BINARY_FMT, self, pixel_index, mask_bit, U32_TO_BINARY(*mask_doubleword));
-            if ((*mask_doubleword & (1u << mask_bit)) != 0) {
-                VECTORIO_SHAPE_PIXEL_DEBUG(" masked");
-                continue;
+    VECTORIO_SHAPE_DEBUG(", linestride:%3d depth:%2d shape:%s",
+        linestride_px, colorspace->depth, mp_obj_get_type_str(self->ishape.shape));
+
+    if (self->ishape.get_spans == NULL) {
+        for (int16_t y = overlap.y1; y < overlap.y2; ++y) {
+            for (int16_t x = overlap.x1; x < overlap.x2; ++x) {
+                #ifdef VECTORIO_PERF
+                uint64_t pre_pixel = common_hal_time_monotonic_ns();
+                #endif
+                if (!_fill_pixel(self, colorspace, area, x, y, mask, buffer)) {
+                    full_coverage = false;
+                }
+                #ifdef VECTORIO_PERF
+                pixel_time += common_hal_time_monotonic_ns() - pre_pixel;
+                #endif
             }
-            output_pixel.pixel = 0;
-
-            // Cast input screen coordinates to shape coordinates to pick the pixel to draw
-            int16_t pixel_to_get_x;
-            int16_t pixel_to_get_y;
-            screen_to_shape_coordinates(self, input_pixel.x, input_pixel.y, &pixel_to_get_x, &pixel_to_get_y);
+        }
+    } else {
+        // Each line of the area is a row of the shape. Lines run along the screen's x axis, or
+        // its y axis when the transform transposes them. u is the position along a line, v the
+        // line, and either can be mirrored as in screen_to_shape_coordinates.
+        const displayio_buffer_transform_t *transform = self->absolute_transform;
+        bool transposed = transform->transpose_xy;
+        int16_t u_offset, v_offset;
+        bool u_mirrored, v_mirrored;
+        int16_t u1, u2, v1, v2;
+        uint32_t u_start_index;
+        uint16_t u_step, v_step;
+        if (transposed) {
+            u_offset = transform->y + transform->dy * self->x;
+            v_offset = transform->x + transform->dx * self->y;
+            u_mirrored = transform->dy < 1;
+            v_mirrored = transform->dx < 1;
+            u1 = overlap.y1;
+            u2 = overlap.y2;
+            v1 = overlap.x1;
+            v2 = overlap.x2;
+            u_start_index = (overlap.y1 - area->y1) * linestride_px - area->x1;
+            u_step = linestride_px;
+            v_step = 1;
+        } else {
+            u_offset = transform->x + transform->dx * self->x;
+            v_offset = transform->y + transform->dy * self->y;
+            u_mirrored = transform->dx < 1;
+            v_mirrored = transform->dy < 1;
+            u1 = overlap.x1;
+            u2 = overlap.x2;
+            v1 = overlap.y1;
+            v2 = overlap.y2;
+            u_start_index = (overlap.x1 - area->x1) - area->y1 * linestride_px;
+            u_step = 1;
+            v_step = linestride_px;
+        }
+        bool uniform = _shader_is_uniform(self);
 
-            VECTORIO_SHAPE_PIXEL_DEBUG(" get_pixel %p (%3d, %3d) -> ( %3d, %3d )", self->ishape.shape, input_pixel.x, input_pixel.y, pixel_to_get_x, pixel_to_get_y);
+        vectorio_span_t spans[VECTORIO_SHAPE_MAX_SPANS];
+        for (int16_t v = v1; v < v2; ++v) {
+            int16_t shape_y = v_mirrored ? v_offset - 1 - v : v - v_offset;
+            uint32_t pixel;
             #ifdef VECTORIO_PERF
             uint64_t pre_pixel = common_hal_time_monotonic_ns();
             #endif
-            input_pixel.pixel = self->ishape.get_pixel(self->ishape.shape, pixel_to_get_x, pixel_to_get_y);
+            uint16_t span_count = self->ishape.get_spans(self->ishape.shape, shape_y, spans, VECTORIO_SHAPE_MAX_SPANS, &pixel);
             #ifdef VECTORIO_PERF
-            uint64_t post_pixel = common_hal_time_monotonic_ns();
-            pixel_time += post_pixel - pre_pixel;
+            pixel_time += common_hal_time_monotonic_ns() - pre_pixel;
             #endif
-            VECTORIO_SHAPE_PIXEL_DEBUG(" -> %d", input_pixel.pixel);
-
-            // vectorio shapes use 0 to mean "area is not covered."
-            // We can skip all the rest of the work for this pixel if it's not currently covered by the shape.
-            if (input_pixel.pixel == 0) {
-                VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel; input area is not fully covered)");
-                full_coverage = false;
-            } else {
-                // Pixel is not transparent. Let's pull the pixel value index down to 0-base for more error-resistant palettes.
-                input_pixel.pixel -= 1;
-                output_pixel.opaque = true;
-
-                if (self->pixel_shader == mp_const_none) {
-                    output_pixel.pixel = input_pixel.pixel;
-                } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
-                    displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-                } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
-                    displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
+            // The buffer index of u1 on this line.
+            uint32_t line_index = u_start_index + v * v_step;
+
+            if (span_count > VECTORIO_SHAPE_MAX_SPANS) {
+                // Too many runs to hold, so draw this line a pixel at a time.
+                for (int16_t u = u1; u < u2; ++u) {
+                    if (!_fill_pixel(self, colorspace, area, transposed ? v : u, transposed ? u : v, mask, buffer)) {
+                        full_coverage = false;
+                    }
                 }
+                continue;
+            }
+            if (pixel == 0) {
+                span_count = 0;
+            }
+
+            displayio_output_pixel_t output_pixel;
+            if (uniform && span_count > 0) {
+                displayio_input_pixel_t input_pixel = { .pixel = pixel };
+                _shade_pixel(self, colorspace, &input_pixel, &output_pixel);
+            }
 
-                // We double-check this to fast-path the case when a pixel is not covered by the shape & not call the color converter unnecessarily.
-                if (!output_pixel.opaque) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel from colorconverter; input area is not fully covered)");
+            // Pixels before this on the line are either drawn or known to be masked.
+            int16_t done = u1;
+            for (uint16_t i = 0; i <= span_count; i++) {
+                int32_t run_start = u2;
+                int32_t run_end = u2;
+                if (i < span_count) {
+                    // Mirrored spans come in right to left on the screen.
+                    const vectorio_span_t *span = &spans[u_mirrored ? span_count - 1 - i : i];
+                    run_start = MAX(u_mirrored ? u_offset - span->x2 : u_offset + span->x1, done);
+                    run_end = MIN(u_mirrored ? u_offset - span->x1 : u_offset + span->x2, u2);
+                    if (run_start >= run_end) {
+                        continue;
+                    }
+                }
+                if (full_coverage && run_start > done &&
+                    _any_unmasked(mask, line_index + (done - u1) * u_step, run_start - done, u_step)) {
+                    VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel; input area is not fully covered)");
                     full_coverage = false;
                 }
+                if (run_start == run_end) {
+                    break;
+                }
 
-                *mask_doubleword |= 1u << mask_bit;
-                if (colorspace->depth == 16) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 16", output_pixel.pixel);
-                    *(((uint16_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth == 32) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 32", output_pixel.pixel);
-                    *(((uint32_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth == 8) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %02x 8", output_pixel.pixel);
-                    *(((uint8_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth < 8) {
-                    // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
-                    if (!colorspace->pixels_in_byte_share_row) {
-                        uint16_t row = pixel_index / linestride_px;
-                        uint16_t col = pixel_index % linestride_px;
-                        pixel_index = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * linestride_px + row % pixels_per_byte;
+                uint32_t run_index = line_index + (run_start - u1) * u_step;
+                if (uniform) {
+                    uint32_t drawn = _fill_run(colorspace, linestride_px, mask, buffer, run_index, run_end - run_start, u_step, output_pixel.pixel);
+                    if (drawn > 0 && !output_pixel.opaque) {
+                        VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel from colorconverter; input area is not fully covered)");
+                        full_coverage = false;
                     }
-                    uint8_t shift = (pixel_index % pixels_per_byte) * colorspace->depth;
-                    if (colorspace->reverse_pixels_in_byte) {
-                        // Reverse the shift by subtracting it from the leftmost shift.
-                        shift = (pixels_per_byte - 1) * colorspace->depth - shift;
+                } else {
+                    // Dithering depends on where the pixel is in the shape.
+                    for (int16_t u = run_start; u < run_end; ++u, run_index += u_step) {
+                        uint32_t mask_bit = 1u << (run_index % 32);
+                        if ((mask[run_index / 32] & mask_bit) != 0) {
+                            continue;
+                        }
+                        displayio_input_pixel_t input_pixel = {
+                            .pixel = pixel,
+                            .x = transposed ? v : u,
+                            .y = transposed ? u : v,
+                            .tile_x = u_mirrored ? u_offset - 1 - u : u - u_offset,
+                            .tile_y = shape_y,
+                        };
+                        _shade_pixel(self, colorspace, &input_pixel, &output_pixel);
+                        if (!output_pixel.opaque) {
+                            full_coverage = false;
+                        }
+                        mask[run_index / 32] |= mask_bit;
+                        _write_pixel(colorspace, linestride_px, buffer, run_index, output_pixel.pixel);
                     }
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %2d %d", output_pixel.pixel, colorspace->depth);
-                    ((uint8_t *)buffer)[pixel_index / pixels_per_byte] |= output_pixel.pixel << shift;
                 }
+                done = run_end;
             }
         }
-        mask_start_px += linestride_px - column_dirty_offset_px;
     }
     #ifdef VECTORIO_PERF
     uint64_t end = common_hal_time_monotonic_ns();
@@ -13,9 +13,14 @@
 #include "py/obj.h"
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/Palette.h"
+#include "shared-module/vectorio/__init__.h"
 
 typedef void get_area_function(mp_obj_t shape, displayio_area_t *out_area);
 typedef uint32_t get_pixel_function(mp_obj_t shape, int16_t x, int16_t y);
+// Writes the runs of row y that the shape covers to spans, left to right, and returns how many
+// there are. Only the first max_spans are written if there are more. All of them have the pixel
+// value stored in out_pixel.
+typedef uint16_t get_spans_function(mp_obj_t shape, int16_t y, vectorio_span_t *spans, uint16_t max_spans, uint32_t *out_pixel);
 
 // This struct binds a shape's common Shape support functions (its vector shape interface)
 //   to its instance pointer.  We only check at construction time what the type of the
@@ -27,6 +32,7 @@ typedef struct {
     mp_obj_t shape;
     get_area_function *get_area;
     get_pixel_function *get_pixel;
+    get_spans_function *get_spans;
 } vectorio_ishape_t;
 
 typedef struct {
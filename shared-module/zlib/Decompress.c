@@ -0,0 +1,336 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Scott Shawcroft for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+
+#include "shared-bindings/zlib/Decompress.h"
+
+// Once the current input (in pending) is used up, carry on with the input
+// passed to this call. Returning -1 marks the decoder as out of input.
+static int zlib_decompress_read_source(TINF_DATA *d) {
+    zlib_decompress_obj_t *self = d->self;
+    if (d->source_limit != self->input_limit && self->input < self->input_limit) {
+        d->source = self->input + 1;
+        d->source_limit = self->input_limit;
+        return self->input[0];
+    }
+    return -1;
+}
+
+void common_hal_zlib_decompress_construct(zlib_decompress_obj_t *self, mp_int_t wbits) {
+    mp_int_t window_bits = wbits;
+    if (wbits >= 16) {
+        window_bits = wbits - 16;
+    } else if (wbits < 0) {
+        window_bits = -wbits;
+    }
+    if (window_bits != 0 && (window_bits < 8 || window_bits > 15)) {
+        mp_arg_error_invalid(MP_QSTR_wbits);
+    }
+
+    memset(&self->decomp, 0, sizeof(self->decomp));
+    uzlib_uncompress_init(&self->decomp, NULL, 0);
+    self->decomp.self = self;
+    self->decomp.readSource = zlib_decompress_read_source;
+    self->window = NULL;
+    self->pending = NULL;
+    self->pending_len = 0;
+    self->pending_alloc = 0;
+    self->input = NULL;
+    self->input_limit = NULL;
+    self->unconsumed_tail = mp_const_empty_bytes;
+    self->unused_data = mp_const_empty_bytes;
+    self->wbits = wbits;
+    self->header_done = false;
+    self->needs_input = false;
+    self->eof = false;
+}
+
+// Reads the gzip or zlib header, if any, and sets up the window. Returns false
+// if the input ran out first.
+static bool zlib_decompress_read_header(zlib_decompress_obj_t *self) {
+    TINF_DATA *d = &self->decomp;
+    int st = TINF_OK;
+    mp_int_t window_bits;
+    if (self->wbits >= 16) {
+        st = uzlib_gzip_parse_header(d);
+        window_bits = self->wbits == 16 ? 15 : self->wbits - 16;
+    } else if (self->wbits >= 0) {
+        st = uzlib_zlib_parse_header(d);
+        window_bits = st + 8;
+        if (self->wbits != 0 && self->wbits < window_bits) {
+            window_bits = self->wbits;
+        }
+    } else {
+        window_bits = -self->wbits;
+    }
+    if (d->eof) {
+        return false;
+    }
+    if (st < 0) {
+        mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(st));
+    }
+
+    size_t window_size = 1 << window_bits;
+    self->window = m_new(uint8_t, window_size);
+    uzlib_uncompress_init(d, self->window, window_size);
+    self->header_done = true;
+    return true;
+}
+
+static void zlib_decompress_save(zlib_decompress_obj_t *self) {
+    TINF_DATA *d = &self->decomp;
+    zlib_decompress_state_t *saved = &self->saved;
+    saved->source = d->source;
+    saved->source_limit = d->source_limit;
+    saved->dest = d->dest;
+    saved->tag = d->tag;
+    saved->bitcount = d->bitcount;
+    saved->checksum = d->checksum;
+    saved->curlen = d->curlen;
+    saved->dict_idx = d->dict_idx;
+    saved->blocks = d->blocks;
+    saved->btype = d->btype;
+    saved->bfinal = d->bfinal;
+    saved->lzOff = d->lzOff;
+}
+
+static void zlib_decompress_restore(zlib_decompress_obj_t *self) {
+    TINF_DATA *d = &self->decomp;
+    const zlib_decompress_state_t *saved = &self->saved;
+    d->source = saved->source;
+    d->source_limit = saved->source_limit;
+    d->dest = saved->dest;
+    d->tag = saved->tag;
+    d->bitcount = saved->bitcount;
+    d->checksum = saved->checksum;
+    d->curlen = saved->curlen;
+    d->dict_idx = saved->dict_idx;
+    d->blocks = saved->blocks;
+    d->btype = saved->btype;
+    d->bfinal = saved->bfinal;
+    d->lzOff = saved->lzOff;
+    d->eof = false;
+}
+
+// Copies the len window bytes from index idx, wrapping around, to or from
+// window_saved starting at offset.
+static void zlib_decompress_copy_window(zlib_decompress_obj_t *self, size_t idx, size_t offset, size_t len, bool restore) {
+    size_t window_size = self->decomp.dict_size;
+    size_t first = MIN(len, window_size - idx);
+    size_t second = MIN(len - first, idx);
+    uint8_t *saved = self->window_saved + offset;
+    if (restore) {
+        memcpy(self->window + idx, saved, first);
+        memcpy(self->window, saved + first, second);
+    } else {
+        memcpy(saved, self->window + idx, first);
+        memcpy(saved + first, self->window, second);
+    }
+}
+
+// Undoes a step of n bytes that ran out of input. If a block started during
+// the step, the output before it is kept and decoding starts that block again.
+// Otherwise the whole step is undone, which leaves the trees as they were.
+// Returns whether any output was kept.
+static bool zlib_decompress_undo_step(zlib_decompress_obj_t *self, size_t n) {
+    TINF_DATA *d = &self->decomp;
+    uint8_t *step_dest = self->saved.dest;
+    if (d->blocks == self->saved.blocks) {
+        zlib_decompress_restore(self);
+        zlib_decompress_copy_window(self, d->dict_idx, 0, n, true);
+        return false;
+    }
+    zlib_decompress_restore(self);
+    size_t kept = d->block_dest - step_dest;
+    d->source = d->block_source;
+    d->source_limit = d->block_source_limit;
+    d->dest = d->block_dest;
+    d->dict_idx = d->block_dict_idx;
+    d->tag = d->block_tag;
+    d->bitcount = d->block_bitcount;
+    d->btype = -1;
+    d->bfinal = 0;
+    d->curlen = 0;
+    if (d->checksum_type == TINF_CHKSUM_ADLER) {
+        d->checksum = uzlib_adler32(step_dest, kept, d->checksum);
+    } else if (d->checksum_type == TINF_CHKSUM_CRC) {
+        d->checksum = uzlib_crc32(step_dest, kept, d->checksum);
+    }
+    zlib_decompress_copy_window(self, d->dict_idx, kept, n - kept, true);
+    return kept > 0;
+}
+
+// Decompresses as much as fits in buf from pending and then the current input.
+// Stops early at the end of the stream, or when the input runs out part way
+// through a symbol or header. That partial step is rolled back so it can be
+// repeated once more input has been added.
+static size_t zlib_decompress_run(zlib_decompress_obj_t *self, uint8_t *buf, size_t size) {
+    TINF_DATA *d = &self->decomp;
+    d->dest_start = buf;
+    d->dest = buf;
+    size_t step = ZLIB_DECOMPRESS_STEP;
+    self->needs_input = false;
+    while (!self->eof) {
+        zlib_decompress_save(self);
+        if (!self->header_done) {
+            if (!zlib_decompress_read_header(self)) {
+                zlib_decompress_restore(self);
+                self->needs_input = true;
+                break;
+            }
+            continue;
+        }
+        size_t left = buf + size - d->dest;
+        if (left == 0) {
+            break;
+        }
+        size_t n = MIN(step, left);
+        zlib_decompress_copy_window(self, d->dict_idx, 0, n, false);
+        d->dest_limit = d->dest + n;
+        int st = uzlib_uncompress_chksum(d);
+        if (d->eof) {
+            if (zlib_decompress_undo_step(self, n)) {
+                continue;
+            }
+            // What is left may still be enough for a shorter step.
+            if (n == 1) {
+                self->needs_input = true;
+                break;
+            }
+            step = n / 2;
+            continue;
+        }
+        if (st < 0) {
+            mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(st));
+        }
+        if (st == TINF_DONE) {
+            self->eof = true;
+        }
+    }
+    return d->dest - buf;
+}
+
+static void zlib_decompress_begin(zlib_decompress_obj_t *self, const uint8_t *data, size_t len) {
+    TINF_DATA *d = &self->decomp;
+    self->input = data;
+    self->input_limit = data + len;
+    if (self->pending_len > 0) {
+        d->source = self->pending;
+        d->source_limit = self->pending + self->pending_len;
+    } else {
+        d->source = data;
+        d->source_limit = data + len;
+    }
+}
+
+static void zlib_decompress_add_pending(zlib_decompress_obj_t *self, const uint8_t *data, size_t len) {
+    size_t needed = self->pending_len + len;
+    if (needed > self->pending_alloc) {
+        size_t new_alloc = MAX(needed, self->pending_alloc * 2);
+        self->pending = m_renew(uint8_t, self->pending, self->pending_alloc, new_alloc);
+        self->pending_alloc = new_alloc;
+    }
+    memcpy(self->pending + self->pending_len, data, len);
+    self->pending_len = needed;
+}
+
+// Deals with whatever input the last run didn't use: past the end of the
+// stream it is unused_data, input that ran out part way through is kept for
+// the next call, and anything left because the output was full is returned to
+// the caller as unconsumed_tail.
+static void zlib_decompress_end(zlib_decompress_obj_t *self) {
+    TINF_DATA *d = &self->decomp;
+    const uint8_t *rest = self->input;
+    size_t pending_left = 0;
+    if (self->pending_len > 0 && d->source_limit == self->pending + self->pending_len) {
+        pending_left = d->source_limit - d->source;
+        memmove(self->pending, d->source, pending_left);
+    } else {
+        rest = d->source;
+    }
+    size_t rest_len = self->input_limit - rest;
+    self->pending_len = pending_left;
+    self->unconsumed_tail = mp_const_empty_bytes;
+
+    if (self->eof) {
+        if (pending_left + rest_len > 0) {
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(self->unused_data, &bufinfo, MP_BUFFER_READ);
+            vstr_t vstr;
+            vstr_init(&vstr, bufinfo.len + pending_left + rest_len);
+            vstr_add_strn(&vstr, bufinfo.buf, bufinfo.len);
+            vstr_add_strn(&vstr, (const char *)self->pending, pending_left);
+            vstr_add_strn(&vstr, (const char *)rest, rest_len);
+            self->unused_data = mp_obj_new_bytes_from_vstr(&vstr);
+        }
+        self->pending_len = 0;
+    } else if (self->needs_input) {
+        zlib_decompress_add_pending(self, rest, rest_len);
+    } else if (rest_len > 0) {
+        self->unconsumed_tail = mp_obj_new_bytes(rest, rest_len);
+    }
+
+    d->source = NULL;
+    d->source_limit = NULL;
+    self->input = NULL;
+    self->input_limit = NULL;
+}
+
+mp_obj_t common_hal_zlib_decompress_decompress(zlib_decompress_obj_t *self, const uint8_t *data, size_t len, size_t max_length) {
+    // Start with room for about twice the input, and then grow by half again
+    // each time so that copying stays linear in the size of the output.
+    size_t alloc = MAX(2 * len, 64);
+    if (max_length > 0) {
+        alloc = MIN(alloc, max_length);
+    }
+    vstr_t vstr;
+    vstr_init(&vstr, alloc);
+
+    zlib_decompress_begin(self, data, len);
+    while (true) {
+        size_t space = vstr.alloc - vstr.len;
+        if (max_length > 0) {
+            space = MIN(space, max_length - vstr.len);
+        }
+        vstr.len += zlib_decompress_run(self, (uint8_t *)vstr.buf + vstr.len, space);
+        if (self->eof || self->needs_input || (max_length > 0 && vstr.len == max_length)) {
+            break;
+        }
+        vstr_hint_size(&vstr, vstr.alloc / 2);
+    }
+    zlib_decompress_end(self);
+
+    return mp_obj_new_bytes_from_vstr(&vstr);
+}
+
+size_t common_hal_zlib_decompress_decompress_into(zlib_decompress_obj_t *self, const uint8_t *data, size_t len, uint8_t *buf, size_t size) {
+    zlib_decompress_begin(self, data, len);
+    size_t written = zlib_decompress_run(self, buf, size);
+    zlib_decompress_end(self);
+    return written;
+}
+
+mp_obj_t common_hal_zlib_decompress_flush(zlib_decompress_obj_t *self) {
+    mp_obj_t tail = self->unconsumed_tail;
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(tail, &bufinfo, MP_BUFFER_READ);
+    return common_hal_zlib_decompress_decompress(self, bufinfo.buf, bufinfo.len, 0);
+}
+
+bool common_hal_zlib_decompress_get_eof(zlib_decompress_obj_t *self) {
+    return self->eof;
+}
+
+mp_obj_t common_hal_zlib_decompress_get_unconsumed_tail(zlib_decompress_obj_t *self) {
+    return self->unconsumed_tail;
+}
+
+mp_obj_t common_hal_zlib_decompress_get_unused_data(zlib_decompress_obj_t *self) {
+    return self->unused_data;
+}
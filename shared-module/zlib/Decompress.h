@@ -0,0 +1,59 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Scott Shawcroft for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#include "lib/uzlib/uzlib.h"
+
+// Most output produced by one uzlib call. uzlib can't stop part way through a
+// symbol when it runs out of input, so the state each call changes is saved
+// first and put back if the input ran out.
+#define ZLIB_DECOMPRESS_STEP (512)
+
+// The parts of TINF_DATA that decoding within a block changes. The Huffman
+// trees only change when a block starts, and a step that runs out of input
+// after that goes back to the start of the new block instead.
+typedef struct {
+    const unsigned char *source;
+    const unsigned char *source_limit;
+    unsigned char *dest;
+    unsigned int tag;
+    unsigned int bitcount;
+    unsigned int checksum;
+    unsigned int curlen;
+    unsigned int dict_idx;
+    unsigned int blocks;
+    int btype;
+    int bfinal;
+    int lzOff;
+} zlib_decompress_state_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    TINF_DATA decomp;
+    // Decoder state before the current step.
+    zlib_decompress_state_t saved;
+    // The history window, allocated once the header has been read.
+    uint8_t *window;
+    // Input from earlier calls that couldn't be decoded yet. It is read before
+    // the current input.
+    uint8_t *pending;
+    size_t pending_len;
+    size_t pending_alloc;
+    // The current input.
+    const uint8_t *input;
+    const uint8_t *input_limit;
+    mp_obj_t unconsumed_tail;
+    mp_obj_t unused_data;
+    int8_t wbits;
+    bool header_done;
+    bool needs_input;
+    bool eof;
+    // Window bytes that the current step may overwrite.
+    uint8_t window_saved[ZLIB_DECOMPRESS_STEP];
+} zlib_decompress_obj_t;
@@ -28,6 +28,23 @@
 #define DEBUG_printf(...) (void)0
 #endif
 
+// Grows the output by half again, so that copying stays linear in the size of
+// the output. If the heap can't fit that, settles for less.
+static byte *grow_output(byte *buf, mp_uint_t *size) {
+    mp_uint_t extra = *size / 2;
+    while (extra > 256) {
+        byte *new_buf = m_renew_maybe(byte, buf, *size, *size + extra, true);
+        if (new_buf != NULL) {
+            *size += extra;
+            return new_buf;
+        }
+        extra /= 2;
+    }
+    buf = m_renew(byte, buf, *size, *size + 256);
+    *size += 256;
+    return buf;
+}
+
 mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
@@ -67,10 +84,9 @@ mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits) {
             break;
         }
         size_t offset = decomp->dest - dest_buf;
-        dest_buf = m_renew(byte, dest_buf, dest_buf_size, dest_buf_size + 256);
-        dest_buf_size += 256;
+        dest_buf = grow_output(dest_buf, &dest_buf_size);
         decomp->dest = dest_buf + offset;
-        decomp->dest_limit = dest_buf + offset + 256;
+        decomp->dest_limit = dest_buf + dest_buf_size;
     }
 
     mp_uint_t final_sz = decomp->dest - dest_buf;
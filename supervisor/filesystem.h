@@ -45,3 +45,12 @@ void filesystem_unlock(fs_user_mount_t *fs_mount);
 
 bool blockdev_lock(fs_user_mount_t *fs_mount);
 void blockdev_unlock(fs_user_mount_t *fs_mount);
+
+// Lets the VM reference the filesystem's blocks in place, if nothing else can
+// change them. Python must not be able to write, and no workflow may be
+// connected. The blockdev lock is then held until filesystem_release_mapped()
+// is called when the VM ends, so workflows see the filesystem as read-only.
+bool filesystem_map_for_vm(fs_user_mount_t *fs_mount);
+void filesystem_release_mapped(void);
+// boot.py may remount the filesystem, so nothing is mapped while it runs.
+void filesystem_set_mapping_allowed(bool allowed);
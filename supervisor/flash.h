@@ -29,6 +29,10 @@ void supervisor_flash_init_vfs(struct _fs_user_mount_t *vfs);
 void supervisor_flash_flush(void);
 void supervisor_flash_release_cache(void);
 
+// Where the given block can be read directly, or NULL if the flash isn't
+// memory-mapped. Ports provide this when they can; by default it is NULL.
+const uint8_t *supervisor_flash_get_mapped_address(uint32_t block_num);
+
 void supervisor_flash_set_extended(bool extended);
 bool supervisor_flash_get_extended(void);
 void supervisor_flash_update_extended(void);
@@ -107,7 +107,7 @@ static bool init_lvfont(lvfontio_ondiskfont_t *font, const char *font_path, uint
     font->base.type = &lvfontio_ondiskfont_type;
 
     // Pass false for use_gc_allocator during startup when garbage collector isn't fully initialized
-    common_hal_lvfontio_ondiskfont_construct(font, font_path, max_slots, false);
+    common_hal_lvfontio_ondiskfont_construct(font, font_path, max_slots, LVFONTIO_DEFAULT_CACHE_SIZE, false);
 
     return !common_hal_lvfontio_ondiskfont_deinited(font);
 }
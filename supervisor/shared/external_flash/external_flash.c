@@ -22,24 +22,40 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
-static uint32_t current_sector;
-
 static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES};
 #define EXTERNAL_FLASH_DEVICE_COUNT MP_ARRAY_SIZE(possible_devices)
 
 static const external_flash_device *flash_device = NULL;
 
-// Track which blocks (up to 32) in the current sector currently live in the
-// cache.
-static uint32_t dirty_mask;
-
-// Table of pointers to each cached block. Should be zero'd after allocation.
+// Writes are cached a whole erase sector at a time, so that a sector is erased
+// once for many block writes. Up to CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+// sectors are cached in ram, so writes that go back and forth between a few
+// sectors, like the FAT, a directory and a file's data, don't each cause an
+// erase. When another sector is needed, the least recently written one is
+// flushed. If there isn't even ram for one sector, a single sector is cached in
+// the scratch sector at the end of the flash instead.
+#define CACHED_SECTOR_COUNT CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+
+typedef struct {
+    uint32_t sector;
+    // Track which blocks (up to 32) in the sector currently live in the cache.
+    uint32_t dirty_mask;
+    uint32_t last_write;
+} cached_sector_t;
+
+static cached_sector_t cached_sectors[CACHED_SECTOR_COUNT];
+// Counts writes, to find the least recently written sector.
+static uint32_t write_count;
+
+// Table of pointers to each cached page, FLASH_CACHE_TABLE_NUM_ENTRIES for each
+// cached sector. Should be zero'd after allocation.
 #define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
 #define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
 #define FLASH_CACHE_TABLE_NUM_ENTRIES (BLOCKS_PER_SECTOR * PAGES_PER_BLOCK)
-#define FLASH_CACHE_TABLE_SIZE (FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
+#define FLASH_CACHE_TABLE_SIZE (CACHED_SECTOR_COUNT * FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
 static uint8_t **flash_cache_table = NULL;
+// How many sectors have pages allocated in flash_cache_table.
+static size_t ram_cached_sectors;
 
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
@@ -135,7 +151,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -281,9 +297,12 @@ void supervisor_flash_init(void) {
 
     wait_for_flash_ready();
 
-    current_sector = NO_SECTOR_LOADED;
-    dirty_mask = 0;
+    for (size_t i = 0; i < CACHED_SECTOR_COUNT; i++) {
+        cached_sectors[i].sector = NO_SECTOR_LOADED;
+        cached_sectors[i].dirty_mask = 0;
+    }
     flash_cache_table = NULL;
+    ram_cached_sectors = 0;
 }
 
 // The size of each individual block.
@@ -304,7 +323,8 @@ uint32_t supervisor_flash_get_block_count(void) {
 // Flush the cache that was written to the scratch portion of flash. Only used
 // when ram is tight.
 static bool flush_scratch_flash(void) {
-    if (current_sector == NO_SECTOR_LOADED) {
+    cached_sector_t *cached = &cached_sectors[0];
+    if (cached->sector == NO_SECTOR_LOADED) {
         return true;
     }
     // First, copy out any blocks that we haven't touched from the sector we've
@@ -312,9 +332,9 @@ static bool flush_scratch_flash(void) {
     bool copy_to_scratch_ok = true;
     uint32_t scratch_sector = flash_device->total_size - SPI_FLASH_ERASE_SIZE;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((cached->dirty_mask & (1 << i)) == 0) {
             copy_to_scratch_ok = copy_to_scratch_ok &&
-                copy_block(current_sector + i * FILESYSTEM_BLOCK_SIZE,
+                copy_block(cached->sector + i * FILESYSTEM_BLOCK_SIZE,
                 scratch_sector + i * FILESYSTEM_BLOCK_SIZE);
         }
     }
@@ -324,35 +344,61 @@ static bool flush_scratch_flash(void) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(cached->sector);
     // Finally, copy the new version into it.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         copy_block(scratch_sector + i * FILESYSTEM_BLOCK_SIZE,
-            current_sector + i * FILESYSTEM_BLOCK_SIZE);
+            cached->sector + i * FILESYSTEM_BLOCK_SIZE);
     }
     return true;
 }
 
+static uint8_t *cached_page(size_t index, size_t page) {
+    return flash_cache_table[index * FLASH_CACHE_TABLE_NUM_ENTRIES + page];
+}
+
 // Free all entries in the partially or completely filled flash_cache_table, and then free the table itself.
 static void release_ram_cache(void) {
     if (flash_cache_table == NULL) {
         return;
     }
 
-    for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
-        // Table may not be completely full. Stop at first NULL entry.
-        if (flash_cache_table[i] == NULL) {
-            break;
+    for (size_t i = 0; i < CACHED_SECTOR_COUNT * FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
+        if (flash_cache_table[i] != NULL) {
+            port_free(flash_cache_table[i]);
         }
-        port_free(flash_cache_table[i]);
     }
     port_free(flash_cache_table);
     flash_cache_table = NULL;
+    ram_cached_sectors = 0;
+}
+
+// Attempts to allocate the page buffers for caching one more sector in ram.
+// Each page is allocated separately so that the GC doesn't need to provide one
+// huge block.
+static bool allocate_ram_cached_sector(void) {
+    if (ram_cached_sectors == CACHED_SECTOR_COUNT) {
+        return false;
+    }
+    uint8_t **pages = flash_cache_table + ram_cached_sectors * FLASH_CACHE_TABLE_NUM_ENTRIES;
+    for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
+        pages[i] = port_malloc(SPI_FLASH_PAGE_SIZE, false);
+        if (pages[i] == NULL) {
+            // We couldn't allocate enough so give back what we got.
+            while (i > 0) {
+                i--;
+                port_free(pages[i]);
+                pages[i] = NULL;
+            }
+            return false;
+        }
+    }
+    ram_cached_sectors++;
+    return true;
 }
 
-// Attempts to allocate a new set of page buffers for caching a full sector in
-// ram. Each page is allocated separately so that the GC doesn't need to provide
-// one huge block. We can free it as we write if we want to also.
+// Attempts to allocate the table of page buffers, and the pages for caching
+// the first sector in ram. More sectors are allocated when they are needed.
 static bool allocate_ram_cache(void) {
     flash_cache_table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
     if (flash_cache_table == NULL) {
@@ -360,99 +406,132 @@ static bool allocate_ram_cache(void) {
         return false;
     }
 
-    // Clear all the entries so it's easy to find the last entry.
+    // Clear all the entries so it's easy to tell which are allocated.
     memset(flash_cache_table, 0, FLASH_CACHE_TABLE_SIZE);
+    ram_cached_sectors = 0;
 
-    bool success = true;
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR && success; i++) {
-        for (size_t j = 0; j < PAGES_PER_BLOCK && success; j++) {
-            uint8_t *page_cache = port_malloc(SPI_FLASH_PAGE_SIZE, false);
-            if (page_cache == NULL) {
-                success = false;
-                break;
-            }
-            flash_cache_table[i * PAGES_PER_BLOCK + j] = page_cache;
-        }
+    if (!allocate_ram_cached_sector()) {
+        release_ram_cache();
+        return false;
     }
+    return true;
+}
 
-    // We couldn't allocate enough so give back what we got.
-    if (!success) {
-        release_ram_cache();
+static bool page_is_blank(const uint8_t *page) {
+    for (size_t i = 0; i < SPI_FLASH_PAGE_SIZE; i++) {
+        if (page[i] != 0xff) {
+            return false;
+        }
     }
-    return success;
+    return true;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (flash_cache_table == NULL) {
-        // Nothing to flush because there is no cache.
+// Flush a sector cached in ram onto the flash. Pages that are already on the
+// flash aren't written again, and the sector is only erased when a page that
+// changed isn't blank on the flash.
+static bool flush_ram_cached_sector(size_t index) {
+    cached_sector_t *cached = &cached_sectors[index];
+    if (cached->sector == NO_SECTOR_LOADED) {
         return true;
     }
+    uint32_t sector = cached->sector;
+    uint32_t dirty_mask = cached->dirty_mask;
+    cached->sector = NO_SECTOR_LOADED;
+    cached->dirty_mask = 0;
+
+    // First, compare what we've cached with the flash.
+    uint8_t buffer[SPI_FLASH_PAGE_SIZE];
+    uint32_t changed_pages = 0;
+    bool needs_erase = false;
+    for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
+        if ((dirty_mask & (1 << i)) == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
+            size_t page = i * PAGES_PER_BLOCK + j;
+            if (!read_flash(sector + page * SPI_FLASH_PAGE_SIZE, buffer, SPI_FLASH_PAGE_SIZE)) {
+                return false;
+            }
+            if (memcmp(buffer, cached_page(index, page), SPI_FLASH_PAGE_SIZE) != 0) {
+                changed_pages |= 1 << page;
+                needs_erase = needs_erase || (!flash_device->no_erase_cmd && !page_is_blank(buffer));
+            }
+        }
+    }
 
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
+    if (!needs_erase) {
+        for (size_t page = 0; page < FLASH_CACHE_TABLE_NUM_ENTRIES; page++) {
+            if ((changed_pages & (1 << page)) != 0) {
+                write_flash(sector + page * SPI_FLASH_PAGE_SIZE, cached_page(index, page), SPI_FLASH_PAGE_SIZE);
+            }
         }
         return true;
     }
-    // First, copy out any blocks that we haven't touched from the sector
-    // we've cached. If we don't do this we'll erase the data during the sector
-    // erase below.
-    bool copy_to_ram_ok = true;
+
+    // Copy out any blocks that we haven't touched from the sector we've cached.
+    // If we don't do this we'll erase the data during the sector erase below.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         if ((dirty_mask & (1 << i)) == 0) {
             for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-                copy_to_ram_ok = read_flash(
-                    current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[i * PAGES_PER_BLOCK + j],
-                    SPI_FLASH_PAGE_SIZE);
-                if (!copy_to_ram_ok) {
-                    break;
+                size_t page = i * PAGES_PER_BLOCK + j;
+                if (!read_flash(sector + page * SPI_FLASH_PAGE_SIZE, cached_page(index, page), SPI_FLASH_PAGE_SIZE)) {
+                    return false;
                 }
             }
         }
-        if (!copy_to_ram_ok) {
-            break;
-        }
-    }
-
-    if (!copy_to_ram_ok) {
-        return false;
     }
-    // Second, erase the current sector.
-    erase_sector(current_sector);
+    // Second, erase the sector.
+    erase_sector(sector);
     // Lastly, write all the data in ram that we've cached.
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-            write_flash(current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                flash_cache_table[i * PAGES_PER_BLOCK + j],
-                SPI_FLASH_PAGE_SIZE);
-        }
-    }
-    // We're done with the cache for now so give it back.
-    if (!keep_cache) {
-        release_ram_cache();
+    for (size_t page = 0; page < FLASH_CACHE_TABLE_NUM_ENTRIES; page++) {
+        write_flash(sector + page * SPI_FLASH_PAGE_SIZE, cached_page(index, page), SPI_FLASH_PAGE_SIZE);
     }
     return true;
 }
 
-// Delegates to the correct flash flush method depending on the existing cache.
-// TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
-static void spi_flash_flush_keep_cache(bool keep_cache) {
+static void set_flash_activity_led(bool on) {
     #ifdef MICROPY_HW_LED_MSC
-    port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
+    port_pin_set_output_level(MICROPY_HW_LED_MSC, on);
+    #else
+    (void)on;
     #endif
-    // If we've cached to the flash itself flush from there.
-    if (flash_cache_table == NULL) {
-        flush_scratch_flash();
-    } else {
-        flush_ram_cache(keep_cache);
+}
+
+// Delegates to the correct flash flush method depending on the existing cache.
+static void spi_flash_flush_keep_cache(bool keep_cache) {
+    bool cached = false;
+    for (size_t i = 0; i < CACHED_SECTOR_COUNT; i++) {
+        cached = cached || cached_sectors[i].sector != NO_SECTOR_LOADED;
+    }
+    if (cached) {
+        set_flash_activity_led(true);
+        // If we've cached to the flash itself flush from there.
+        if (flash_cache_table == NULL) {
+            flush_scratch_flash();
+            cached_sectors[0].sector = NO_SECTOR_LOADED;
+            cached_sectors[0].dirty_mask = 0;
+        } else {
+            // Write the sectors back in address order.
+            for (;;) {
+                size_t lowest = CACHED_SECTOR_COUNT;
+                for (size_t i = 0; i < ram_cached_sectors; i++) {
+                    if (cached_sectors[i].sector != NO_SECTOR_LOADED &&
+                        (lowest == CACHED_SECTOR_COUNT || cached_sectors[i].sector < cached_sectors[lowest].sector)) {
+                        lowest = i;
+                    }
+                }
+                if (lowest == CACHED_SECTOR_COUNT) {
+                    break;
+                }
+                flush_ram_cached_sector(lowest);
+            }
+        }
+        set_flash_activity_led(false);
+    }
+    // We're done with the cache for now so give it back.
+    if (!keep_cache) {
+        release_ram_cache();
     }
-    current_sector = NO_SECTOR_LOADED;
-    #ifdef MICROPY_HW_LED_MSC
-    port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
-    #endif
 }
 
 void supervisor_external_flash_flush(void) {
@@ -472,6 +551,53 @@ static int32_t convert_block_to_flash_addr(uint32_t block) {
     return -1;
 }
 
+static cached_sector_t *find_cached_sector(uint32_t sector) {
+    for (size_t i = 0; i < CACHED_SECTOR_COUNT; i++) {
+        if (cached_sectors[i].sector == sector) {
+            return &cached_sectors[i];
+        }
+    }
+    return NULL;
+}
+
+// Finds a place to cache the given sector, flushing the least recently
+// written sector if every place is in use.
+static cached_sector_t *start_caching_sector(uint32_t sector) {
+    if (flash_cache_table == NULL) {
+        if (cached_sectors[0].sector != NO_SECTOR_LOADED) {
+            supervisor_flash_flush();
+        }
+        if (!allocate_ram_cache()) {
+            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
+            wait_for_flash_ready();
+            cached_sectors[0].sector = sector;
+            cached_sectors[0].dirty_mask = 0;
+            return &cached_sectors[0];
+        }
+    }
+    size_t index = ram_cached_sectors;
+    for (size_t i = 0; i < ram_cached_sectors; i++) {
+        if (cached_sectors[i].sector == NO_SECTOR_LOADED) {
+            index = i;
+            break;
+        }
+    }
+    if (index == ram_cached_sectors && !allocate_ram_cached_sector()) {
+        index = 0;
+        for (size_t i = 1; i < ram_cached_sectors; i++) {
+            if (cached_sectors[i].last_write < cached_sectors[index].last_write) {
+                index = i;
+            }
+        }
+        set_flash_activity_led(true);
+        flush_ram_cached_sector(index);
+        set_flash_activity_led(false);
+    }
+    cached_sectors[index].sector = sector;
+    cached_sectors[index].dirty_mask = 0;
+    return &cached_sectors[index];
+}
+
 static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     int32_t address = convert_block_to_flash_addr(block);
     if (address == -1) {
@@ -483,12 +609,13 @@ static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
+    cached_sector_t *cached = find_cached_sector(this_sector);
+    // We're reading from a cached sector.
+    if (cached != NULL && (mask & cached->dirty_mask) > 0) {
         if (flash_cache_table != NULL) {
             for (int i = 0; i < PAGES_PER_BLOCK; i++) {
                 memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+                    cached_page(cached - cached_sectors, block_index * PAGES_PER_BLOCK + i),
                     SPI_FLASH_PAGE_SIZE);
             }
             return true;
@@ -513,29 +640,28 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
+    cached_sector_t *cached = find_cached_sector(this_sector);
+    // A block in the scratch sector can't be written again without an erase,
+    // so flush the cache if we're writing the same block again. In ram, it is
+    // simply replaced.
+    if (cached != NULL && flash_cache_table == NULL && (mask & cached->dirty_mask) > 0) {
+        supervisor_flash_flush();
+        cached = NULL;
+    }
+    if (cached == NULL) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
         if (page_erased(address)) {
             return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        if (current_sector != NO_SECTOR_LOADED) {
-            supervisor_flash_flush();
-        }
-        if (flash_cache_table == NULL && !allocate_ram_cache()) {
-            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
-            wait_for_flash_ready();
-        }
-        current_sector = this_sector;
-        dirty_mask = 0;
+        cached = start_caching_sector(this_sector);
     }
-    dirty_mask |= mask;
+    cached->dirty_mask |= mask;
+    cached->last_write = ++write_count;
     // Copy the block to the appropriate cache.
     if (flash_cache_table != NULL) {
         for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-            memcpy(flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+            memcpy(cached_page(cached - cached_sectors, block_index * PAGES_PER_BLOCK + i),
                 data + i * SPI_FLASH_PAGE_SIZE,
                 SPI_FLASH_PAGE_SIZE);
         }
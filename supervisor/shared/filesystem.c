@@ -14,6 +14,7 @@
 
 #include "supervisor/flash.h"
 #include "supervisor/linker.h"
+#include "supervisor/workflow.h"
 
 #if CIRCUITPY_SDCARDIO
 #include "shared-module/sdcardio/__init__.h"
@@ -332,3 +333,35 @@ bool blockdev_lock(fs_user_mount_t *fs_mount) {
 void blockdev_unlock(fs_user_mount_t *fs_mount) {
     fs_mount->blockdev.flags &= ~MP_BLOCKDEV_FLAG_LOCKED;
 }
+
+static bool mapping_allowed = true;
+
+void filesystem_set_mapping_allowed(bool allowed) {
+    mapping_allowed = allowed;
+}
+
+bool filesystem_map_for_vm(fs_user_mount_t *fs_mount) {
+    if ((fs_mount->blockdev.flags & MP_BLOCKDEV_FLAG_MAPPED) != 0) {
+        return true;
+    }
+    if (!mapping_allowed || filesystem_is_writable_by_python(fs_mount) || supervisor_workflow_active() ||
+        !blockdev_lock(fs_mount)) {
+        return false;
+    }
+    fs_mount->blockdev.flags |= MP_BLOCKDEV_FLAG_MAPPED;
+    return true;
+}
+
+static void release_mapped(fs_user_mount_t *fs_mount) {
+    if ((fs_mount->blockdev.flags & MP_BLOCKDEV_FLAG_MAPPED) != 0) {
+        fs_mount->blockdev.flags &= ~MP_BLOCKDEV_FLAG_MAPPED;
+        blockdev_unlock(fs_mount);
+    }
+}
+
+void filesystem_release_mapped(void) {
+    release_mapped(&_circuitpy_usermount);
+    #if CIRCUITPY_SAVES_PARTITION_SIZE > 0
+    release_mapped(&_saves_usermount);
+    #endif
+}
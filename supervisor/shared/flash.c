@@ -9,6 +9,7 @@
 #include "py/runtime.h"
 #include "lib/oofatfs/diskio.h"
 #include "lib/oofatfs/ff.h"
+#include "supervisor/filesystem.h"
 #include "supervisor/flash.h"
 #include "supervisor/shared/tick.h"
 
@@ -60,6 +61,34 @@ static bool flash_ioctl(mp_obj_t self_in, size_t cmd, size_t arg, mp_int_t *out_
         case MP_BLOCKDEV_IOCTL_BLOCK_SIZE:
             *out_value = self->block_size;
             break;
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+        case MP_BLOCKDEV_IOCTL_MEMMAP: {
+            if (arg < PART1_START_BLOCK) {
+                // The MBR is made up on the fly.
+                return false;
+            }
+            uint32_t block_num = arg - PART1_START_BLOCK;
+            #if CIRCUITPY_SAVES_PARTITION_SIZE > 0
+            block_num += self->offset / self->block_size;
+            #endif
+            const uint8_t *address = supervisor_flash_get_mapped_address(block_num);
+            if (address == NULL) {
+                return false;
+            }
+            *out_value = (uintptr_t)address;
+            break;
+        }
+        case MP_BLOCKDEV_IOCTL_MEMMAP_LOCK: {
+            fs_user_mount_t *vfs = (fs_user_mount_t *)((uint8_t *)self - offsetof(fs_user_mount_t, blockdev));
+            if (!filesystem_map_for_vm(vfs)) {
+                return false;
+            }
+            // Blocks still cached in RAM have to reach the flash to be read there.
+            supervisor_flash_flush();
+            *out_value = 0;
+            break;
+        }
+        #endif
         default:
             return false;
     }
@@ -70,6 +99,12 @@ static mp_obj_t supervisor_flash_obj_ioctl(mp_obj_t self, mp_obj_t cmd_in, mp_ob
     mp_int_t cmd = mp_obj_get_int(cmd_in);
     mp_int_t arg = mp_obj_get_int(arg_in);
     mp_int_t out_value;
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+    // Mapping is for the VM's imports, not for Python code.
+    if (cmd == MP_BLOCKDEV_IOCTL_MEMMAP || cmd == MP_BLOCKDEV_IOCTL_MEMMAP_LOCK) {
+        return mp_const_none;
+    }
+    #endif
     if (flash_ioctl(self, cmd, arg, &out_value)) {
         return MP_OBJ_NEW_SMALL_INT(out_value);
     }
@@ -173,6 +208,10 @@ static mp_uint_t flash_write_blocks(mp_obj_t self_in, const uint8_t *src, uint32
     }
 }
 
+MP_WEAK const uint8_t *supervisor_flash_get_mapped_address(uint32_t block_num) {
+    return NULL;
+}
+
 void PLACE_IN_ITCM(supervisor_flash_flush)(void) {
     #if INTERNAL_FLASH_FILESYSTEM
     port_internal_flash_flush();
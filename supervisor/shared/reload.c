@@ -6,6 +6,7 @@
 
 #include "reload.h"
 
+#include "extmod/vfs.h"
 #include "py/mphal.h"
 #include "py/mpstate.h"
 #include "supervisor/port.h"
@@ -61,6 +62,9 @@ inline bool autoreload_is_enabled(void) {
 }
 
 void autoreload_trigger(void) {
+    // Files were changed from outside the VM, so imports can't trust the
+    // directory listings they have cached.
+    mp_vfs_import_cache_clear();
     if (!autoreload_enabled || autoreload_suspended != 0) {
         return;
     }
@@ -0,0 +1,201 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Scott Shawcroft for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/misc.h"
+
+#include "supervisor/shared/web_workflow/gzip.h"
+
+#define MATCH_MIN (3)
+#define MATCH_MAX (258)
+
+static const uint16_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint16_t distance_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const uint32_t crc_table[16] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+static void put_byte(web_workflow_gzip_t *self, uint8_t b) {
+    self->out[self->out_len++] = b;
+    if (self->out_len == WEB_WORKFLOW_GZIP_OUT_SIZE) {
+        self->sink(self->env, self->out, self->out_len);
+        self->out_len = 0;
+    }
+}
+
+static void put_u32(web_workflow_gzip_t *self, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        put_byte(self, value >> (8 * i));
+    }
+}
+
+// DEFLATE packs fields starting from the least significant bit.
+static void put_bits(web_workflow_gzip_t *self, uint32_t bits, uint8_t count) {
+    self->bit_buffer |= bits << self->bit_count;
+    self->bit_count += count;
+    while (self->bit_count >= 8) {
+        put_byte(self, self->bit_buffer);
+        self->bit_buffer >>= 8;
+        self->bit_count -= 8;
+    }
+}
+
+// Huffman codes are the exception, and go most significant bit first.
+static void put_code(web_workflow_gzip_t *self, uint32_t code, uint8_t count) {
+    uint32_t reversed = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    put_bits(self, reversed, count);
+}
+
+// Writes a literal/length symbol with the fixed Huffman code.
+static void put_symbol(web_workflow_gzip_t *self, uint16_t symbol) {
+    if (symbol < 144) {
+        put_code(self, 0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        put_code(self, 0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        put_code(self, symbol - 256, 7);
+    } else {
+        put_code(self, 0xc0 + symbol - 280, 8);
+    }
+}
+
+static void put_match(web_workflow_gzip_t *self, size_t length, size_t distance) {
+    int i = MP_ARRAY_SIZE(length_base) - 1;
+    while (length_base[i] > length) {
+        i--;
+    }
+    put_symbol(self, 257 + i);
+    if (i >= 8 && i < 28) {
+        put_bits(self, length - length_base[i], i / 4 - 1);
+    }
+
+    i = MP_ARRAY_SIZE(distance_base) - 1;
+    while (distance_base[i] > distance) {
+        i--;
+    }
+    put_code(self, i, 5);
+    if (i >= 4) {
+        put_bits(self, distance - distance_base[i], i / 2 - 1);
+    }
+}
+
+static uint32_t hash(const uint8_t *p) {
+    uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16);
+    return (v * 2654435761u) >> (32 - WEB_WORKFLOW_GZIP_HASH_BITS);
+}
+
+static void remember(web_workflow_gzip_t *self, size_t pos) {
+    self->head[hash(self->window + pos)] = self->window_start + pos + 1;
+}
+
+// Encodes window[pos:window_len], using what is before pos as history.
+static void compress(web_workflow_gzip_t *self, size_t pos) {
+    while (pos < self->window_len) {
+        size_t available = self->window_len - pos;
+        size_t length = 0;
+        size_t distance = 0;
+        if (available >= MATCH_MIN) {
+            uint32_t here = self->window_start + pos;
+            uint32_t candidate = self->head[hash(self->window + pos)];
+            remember(self, pos);
+            if (candidate > self->window_start) {
+                const uint8_t *earlier = self->window + (candidate - 1 - self->window_start);
+                const uint8_t *current = self->window + pos;
+                size_t max_length = MIN(available, MATCH_MAX);
+                while (length < max_length && earlier[length] == current[length]) {
+                    length++;
+                }
+                distance = here - (candidate - 1);
+            }
+        }
+        if (length >= MATCH_MIN) {
+            put_match(self, length, distance);
+            for (size_t i = 1; i < length && pos + i + MATCH_MIN <= self->window_len; i++) {
+                remember(self, pos + i);
+            }
+            pos += length;
+        } else {
+            put_symbol(self, self->window[pos]);
+            pos++;
+        }
+    }
+}
+
+void web_workflow_gzip_init(web_workflow_gzip_t *self, web_workflow_gzip_sink_t sink, void *env) {
+    self->sink = sink;
+    self->env = env;
+    self->crc = 0xffffffff;
+    self->input_size = 0;
+    self->bit_buffer = 0;
+    self->bit_count = 0;
+    self->out_len = 0;
+    self->window_start = 0;
+    self->window_len = 0;
+    memset(self->head, 0, sizeof(self->head));
+
+    // Magic, deflate, no flags, no modification time, no extra flags, unknown OS.
+    static const uint8_t header[] = { 0x1f, 0x8b, 0x08, 0x00, 0, 0, 0, 0, 0x00, 0xff };
+    for (size_t i = 0; i < sizeof(header); i++) {
+        put_byte(self, header[i]);
+    }
+    // Everything goes in one block that uses the fixed codes. Whether it is the
+    // last isn't known yet, so an empty final block is added at the end.
+    put_bits(self, 0x2, 3);
+}
+
+void web_workflow_gzip_write(web_workflow_gzip_t *self, const uint8_t *data, size_t len) {
+    self->input_size += len;
+    for (size_t i = 0; i < len; i++) {
+        self->crc ^= data[i];
+        self->crc = crc_table[self->crc & 0x0f] ^ (self->crc >> 4);
+        self->crc = crc_table[self->crc & 0x0f] ^ (self->crc >> 4);
+    }
+
+    while (len > 0) {
+        if (self->window_len == WEB_WORKFLOW_GZIP_WINDOW_SIZE) {
+            size_t drop = self->window_len - WEB_WORKFLOW_GZIP_HISTORY_SIZE;
+            memmove(self->window, self->window + drop, WEB_WORKFLOW_GZIP_HISTORY_SIZE);
+            self->window_start += drop;
+            self->window_len = WEB_WORKFLOW_GZIP_HISTORY_SIZE;
+        }
+        size_t n = MIN(len, WEB_WORKFLOW_GZIP_WINDOW_SIZE - self->window_len);
+        memcpy(self->window + self->window_len, data, n);
+        size_t pos = self->window_len;
+        self->window_len += n;
+        compress(self, pos);
+        data += n;
+        len -= n;
+    }
+}
+
+void web_workflow_gzip_finish(web_workflow_gzip_t *self) {
+    put_symbol(self, 256);
+    put_bits(self, 0x3, 3);
+    put_symbol(self, 256);
+    if (self->bit_count > 0) {
+        put_bits(self, 0, 8 - self->bit_count);
+    }
+    put_u32(self, self->crc ^ 0xffffffff);
+    put_u32(self, self->input_size);
+    if (self->out_len > 0) {
+        self->sink(self->env, self->out, self->out_len);
+        self->out_len = 0;
+    }
+}
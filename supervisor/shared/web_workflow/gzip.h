@@ -0,0 +1,46 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Scott Shawcroft for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// A small streaming gzip encoder for serving text files. It finds repeats with
+// a single-entry hash table over a 2kB window and codes them with the fixed
+// DEFLATE Huffman codes, so it needs no per-file tables. Source code and logs
+// typically shrink to about half.
+
+#define WEB_WORKFLOW_GZIP_WINDOW_SIZE (2048)
+// How much of the window is kept as history when it slides.
+#define WEB_WORKFLOW_GZIP_HISTORY_SIZE (1024)
+#define WEB_WORKFLOW_GZIP_HASH_BITS (9)
+#define WEB_WORKFLOW_GZIP_OUT_SIZE (512)
+
+// Called with each full output buffer, and with what is left by finish.
+typedef void (*web_workflow_gzip_sink_t)(void *env, const uint8_t *buf, size_t len);
+
+typedef struct {
+    web_workflow_gzip_sink_t sink;
+    void *env;
+    uint32_t crc;
+    uint32_t input_size;
+    uint32_t bit_buffer;
+    uint8_t bit_count;
+    size_t out_len;
+    // Position in the input of window[0].
+    uint32_t window_start;
+    size_t window_len;
+    // Most recent input position + 1 of each hash of three bytes, or 0.
+    uint32_t head[1 << WEB_WORKFLOW_GZIP_HASH_BITS];
+    uint8_t window[WEB_WORKFLOW_GZIP_WINDOW_SIZE];
+    uint8_t out[WEB_WORKFLOW_GZIP_OUT_SIZE];
+} web_workflow_gzip_t;
+
+void web_workflow_gzip_init(web_workflow_gzip_t *self, web_workflow_gzip_sink_t sink, void *env);
+void web_workflow_gzip_write(web_workflow_gzip_t *self, const uint8_t *data, size_t len);
+void web_workflow_gzip_finish(web_workflow_gzip_t *self);
@@ -21,7 +21,9 @@
 #include "supervisor/fatfs.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/port.h"
+#include "supervisor/port_heap.h"
 #include "supervisor/shared/reload.h"
+#include "supervisor/shared/web_workflow/gzip.h"
 #include "supervisor/shared/web_workflow/web_workflow.h"
 #include "supervisor/shared/web_workflow/websocket.h"
 #include "supervisor/shared/workflow.h"
@@ -79,6 +81,12 @@ typedef struct {
     bool json;
     bool websocket;
     bool new_socket;
+    bool gzip;              // The client accepts gzip encoded replies.
+    bool range;             // The client asked for a single range of bytes.
+    // A negative range_start asks for the last range_end bytes, and a negative
+    // range_end for everything from range_start on.
+    int64_t range_start;
+    int64_t range_end;
     uint32_t websocket_version;
     // RFC6455 for websockets says this header should be 24 base64 characters long.
     char websocket_key[24 + 1];
@@ -108,6 +116,13 @@ static _request active_request;
 static char _api_password[64];
 static char web_instance_name[50];
 
+// File contents are read and written through this buffer. When it is a multiple
+// of the sector size, FatFS moves whole sectors directly to and from it.
+#ifndef CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE
+#define CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE (1024)
+#endif
+static uint8_t _transfer_buffer[CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE];
+
 // Store the encoded IP so we don't duplicate work.
 static uint32_t _encoded_ip = 0;
 static char _our_ip_encoded[4 * 4];
@@ -544,7 +559,7 @@ static void _reply_access_control(socketpool_socket_obj_t *socket, _request *req
         "HTTP/1.1 204 No Content\r\n",
         "Content-Length: 0\r\n",
         "Access-Control-Expose-Headers: Access-Control-Allow-Methods\r\n",
-        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization\r\n",
+        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization, Range\r\n",
         "Access-Control-Allow-Methods:GET, OPTIONS, PUT, DELETE, MOVE", NULL);
     _send_str(socket, "\r\n");
     _cors_header(socket, request);
@@ -600,6 +615,16 @@ static void _reply_payload_too_large(socketpool_socket_obj_t *socket, _request *
     _send_final_str(socket, "\r\n");
 }
 
+static void _reply_range_not_satisfiable(socketpool_socket_obj_t *socket, _request *request, uint32_t total_length) {
+    _send_strs(socket,
+        "HTTP/1.1 416 Range Not Satisfiable\r\n",
+        "Content-Length: 0\r\n", NULL);
+    mp_print_t _socket_print = {socket, _print_raw};
+    mp_printf(&_socket_print, "Content-Range: bytes */%u\r\n", total_length);
+    _cors_header(socket, request);
+    _send_final_str(socket, "\r\n");
+}
+
 static void _reply_expectation_failed(socketpool_socket_obj_t *socket, _request *request) {
     _send_strs(socket,
         "HTTP/1.1 417 Expectation Failed\r\n",
@@ -736,63 +761,120 @@ static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *req
     _send_chunk(socket, "");
 }
 
+static void _send_gzip_chunk(void *env, const uint8_t *buf, size_t len) {
+    socketpool_socket_obj_t *socket = env;
+    mp_print_t _socket_print = {socket, _print_raw};
+    mp_printf(&_socket_print, "%X\r\n", len);
+    web_workflow_send_raw(socket, false, buf, len);
+    web_workflow_send_raw(socket, false, (const uint8_t *)"\r\n", 2);
+}
+
+// Sends length bytes from the file's current position, through gzip if it isn't
+// NULL. Returns false if reading the file or sending stopped part way.
+static bool _send_file_contents(socketpool_socket_obj_t *socket, FIL *active_file, uint32_t length, web_workflow_gzip_t *gzip) {
+    uint32_t total_read = 0;
+    while (total_read < length) {
+        // The first read may be short so that the rest start on a multiple of the buffer size.
+        size_t to_read = CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE - f_tell(active_file) % CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE;
+        to_read = MIN(to_read, length - total_read);
+        UINT quantity_read;
+        if (f_read(active_file, _transfer_buffer, to_read, &quantity_read) != FR_OK || quantity_read == 0) {
+            return false;
+        }
+        total_read += quantity_read;
+        if (gzip != NULL) {
+            web_workflow_gzip_write(gzip, _transfer_buffer, quantity_read);
+        } else {
+            // Flush the last piece so that it isn't held back by Nagle's algorithm.
+            web_workflow_send_raw(socket, total_read == length, _transfer_buffer, quantity_read);
+        }
+        if (!common_hal_socketpool_socket_get_connected(socket)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file) {
     uint32_t total_length = f_size(active_file);
+    uint32_t start = 0;
+    uint32_t length = total_length;
+    if (request->range) {
+        int64_t first = request->range_start;
+        int64_t last = request->range_end;
+        if (first < 0) {
+            first = MAX(0, (int64_t)total_length - last);
+            last = total_length - 1;
+        } else if (last < 0 || last >= total_length) {
+            last = total_length - 1;
+        }
+        if (first > last) {
+            _reply_range_not_satisfiable(socket, request, total_length);
+            return;
+        }
+        start = first;
+        length = last - first + 1;
+        f_lseek(active_file, start);
+    }
 
-    _send_str(socket, "HTTP/1.1 200 OK\r\n");
-    mp_print_t _socket_print = {socket, _print_raw};
-    mp_printf(&_socket_print, "Content-Length: %d\r\n", total_length);
     // TODO: Make this a table to save space.
+    const char *content_type = "application/octet-stream";
+    bool text = true;
     if (_endswith(filename, ".txt") || _endswith(filename, ".py") || _endswith(filename, ".toml")) {
-        _send_strs(socket, "Content-Type:", "text/plain", ";charset=UTF-8\r\n", NULL);
+        content_type = "text/plain";
     } else if (_endswith(filename, ".js")) {
-        _send_strs(socket, "Content-Type:", "text/javascript", ";charset=UTF-8\r\n", NULL);
+        content_type = "text/javascript";
     } else if (_endswith(filename, ".html")) {
-        _send_strs(socket, "Content-Type:", "text/html", ";charset=UTF-8\r\n", NULL);
+        content_type = "text/html";
     } else if (_endswith(filename, ".json")) {
-        _send_strs(socket, "Content-Type:", "application/json", ";charset=UTF-8\r\n", NULL);
+        content_type = "application/json";
+    } else {
+        text = false;
+    }
+
+    // Ranges are always of the file as it is, so only whole replies are compressed.
+    web_workflow_gzip_t *gzip = NULL;
+    if (request->gzip && text && !request->range && total_length > 0) {
+        gzip = port_malloc(sizeof(web_workflow_gzip_t), false);
+    }
+
+    mp_print_t _socket_print = {socket, _print_raw};
+    if (request->range) {
+        _send_str(socket, "HTTP/1.1 206 Partial Content\r\n");
+        mp_printf(&_socket_print, "Content-Range: bytes %u-%u/%u\r\n", start, start + length - 1, total_length);
     } else {
-        _send_strs(socket, "Content-Type:", "application/octet-stream\r\n", NULL);
+        _send_str(socket, "HTTP/1.1 200 OK\r\n");
+    }
+    if (gzip != NULL) {
+        _send_strs(socket, "Content-Encoding: gzip\r\n", "Transfer-Encoding: chunked\r\n", NULL);
+    } else {
+        mp_printf(&_socket_print, "Content-Length: %u\r\n", length);
+        _send_str(socket, "Accept-Ranges: bytes\r\n");
+    }
+    if (text) {
+        _send_strs(socket, "Content-Type:", content_type, ";charset=UTF-8\r\n", "Vary: Accept-Encoding\r\n", NULL);
+    } else {
+        _send_strs(socket, "Content-Type:", content_type, "\r\n", NULL);
     }
     _cors_header(socket, request);
     _send_str(socket, "\r\n");
 
-    uint32_t total_read = 0;
-    int nodelay_ok = -1;
-    while (total_read < total_length) {
-        uint8_t data_buffer[64];
-        size_t quantity_read;
-        f_read(active_file, data_buffer, 64, &quantity_read);
-        total_read += quantity_read;
-        // When getting near the end of the file, disable Nagle's combining algorithm so that
-        // data is sent immediately.
-        if (total_length - total_read < 64) {
-            int nodelay = 1;
-            // Returns 0 when it works.
-            nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-        }
-        uint32_t send_offset = 0;
-        while (send_offset < quantity_read) {
-            int sent = socketpool_socket_send(socket, data_buffer + send_offset, quantity_read - send_offset);
-            if (sent < 0) {
-                if (sent == -MP_EAGAIN) {
-                    sent = 0;
-                } else {
-                    break;
-                }
-            }
-            send_offset += sent;
+    bool complete;
+    if (gzip != NULL) {
+        web_workflow_gzip_init(gzip, _send_gzip_chunk, socket);
+        complete = _send_file_contents(socket, active_file, length, gzip);
+        if (complete) {
+            web_workflow_gzip_finish(gzip);
+            // Empty chunk signals the end of the response.
+            _send_chunk(socket, "");
         }
+        port_free(gzip);
+    } else {
+        complete = _send_file_contents(socket, active_file, length, NULL);
     }
-    if (total_read < total_length) {
+    if (!complete) {
         socketpool_socket_close(socket);
     }
-
-    // Re-enable Nagle's algorithm when done sending.
-    if (nodelay_ok == 0) {
-        int nodelay = 0;
-        nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-    }
 }
 
 static void _reply_with_devices_json(socketpool_socket_obj_t *socket, _request *request) {
@@ -1026,11 +1108,11 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     f_rewind(&active_file);
 
     size_t total_read = 0;
+    size_t buffered = 0;
     bool error = false;
     while (total_read < request->content_length && !error) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), request->content_length - total_read);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
+        size_t read_len = MIN(sizeof(_transfer_buffer) - buffered, request->content_length - total_read);
+        int len = socketpool_socket_recv_into(socket, _transfer_buffer + buffered, read_len);
         if (len < 0) {
             if (len == -MP_EAGAIN) {
                 continue;
@@ -1039,11 +1121,16 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
             break;
         }
         total_read += len;
-        UINT actual;
-        f_write(&active_file, bytes, len, &actual);
-        if (actual < (UINT)len) {
-            error = true;
-            break;
+        buffered += len;
+        // Only write full buffers, except at the end, so that writes stay sector aligned.
+        if (buffered == sizeof(_transfer_buffer) || total_read == request->content_length) {
+            UINT actual;
+            f_write(&active_file, _transfer_buffer, buffered, &actual);
+            if (actual < buffered) {
+                error = true;
+                break;
+            }
+            buffered = 0;
         }
     }
 
@@ -1399,6 +1486,43 @@ static void _reset_request(_request *request) {
     request->expect = false;
     request->json = false;
     request->websocket = false;
+    request->gzip = false;
+    request->range = false;
+}
+
+static bool _isdigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Only a single range is supported. Otherwise the header is ignored, and the
+// whole file is sent, as HTTP allows.
+static void _parse_range(_request *request, const char *value) {
+    const char *prefix = "bytes=";
+    if (strncmp(value, prefix, strlen(prefix)) != 0) {
+        return;
+    }
+    const char *p = value + strlen(prefix);
+    char *end;
+    int64_t first = -1;
+    if (_isdigit(*p)) {
+        first = strtoull(p, &end, 10);
+        p = end;
+    }
+    if (*p != '-') {
+        return;
+    }
+    p++;
+    int64_t last = -1;
+    if (_isdigit(*p)) {
+        last = strtoull(p, &end, 10);
+        p = end;
+    }
+    if (*p != '\0' || (first < 0 && last < 0) || (first >= 0 && last >= 0 && last < first)) {
+        return;
+    }
+    request->range = true;
+    request->range_start = first;
+    request->range_end = last;
 }
 
 static void _process_request(socketpool_socket_obj_t *socket, _request *request) {
@@ -1504,6 +1628,10 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
                         request->expect = strcmp(request->header_value, "100-continue") == 0;
                     } else if (strcasecmp(request->header_key, "Accept") == 0) {
                         request->json = strcasecmp(request->header_value, "application/json") == 0;
+                    } else if (strcasecmp(request->header_key, "Accept-Encoding") == 0) {
+                        request->gzip = strstr(request->header_value, "gzip") != NULL;
+                    } else if (strcasecmp(request->header_key, "Range") == 0) {
+                        _parse_range(request, request->header_value);
                     } else if (strcasecmp(request->header_key, "Origin") == 0) {
                         strncpy(request->origin, request->header_value, sizeof(request->origin) - 1);
                         request->origin[sizeof(request->origin) - 1] = '\0';
@@ -0,0 +1,91 @@
+# test that repeated method calls from the same place in the code see changes
+# made to classes and instances in between
+
+
+class A:
+    def f(self):
+        return "A.f"
+
+
+class B(A):
+    pass
+
+
+def call_f(objs):
+    # a single call site used for every object
+    return [o.f() for o in objs]
+
+
+a = A()
+b = B()
+print(call_f([a, a, b, b]))
+
+# replace the method on the base class
+A.f = lambda self: "new A.f"
+print(call_f([a, b]))
+
+# override it in the subclass
+B.f = lambda self: "B.f"
+print(call_f([a, b]))
+
+# remove the override again
+del B.f
+print(call_f([a, b]))
+
+# an instance member shadows the method
+b.f = lambda: "b.f"
+print(call_f([a, b, B()]))
+del b.f
+print(call_f([a, b]))
+
+# remove the method completely
+del A.f
+try:
+    call_f([a])
+except AttributeError:
+    print("AttributeError")
+
+
+# alternate between classes that define a method of the same name
+class C:
+    def f(self):
+        return "C.f"
+
+
+class D:
+    def f(self):
+        return "D.f"
+
+    def g(self):
+        return "D.g"
+
+
+print(call_f([C(), D(), C(), D()]))
+
+# rebinding a method to another function of the class
+D.f = D.g
+print(call_f([D(), C(), D()]))
+
+
+# a class with a native base
+class L(list):
+    def f(self):
+        return len(self)
+
+
+print(call_f([L([1, 2]), L(), C()]))
+
+
+# a class made by type() doesn't follow later changes to the dict it was given
+d = {"f": lambda self: "d.f"}
+E = type("E", (), d)
+print(call_f([E()]))
+d["f"] = lambda self: "new d.f"
+print(call_f([E()]))
+
+# nor can its methods be replaced through __dict__
+try:
+    E.__dict__["f"] = lambda self: "__dict__.f"
+except TypeError:
+    print("TypeError")
+print(call_f([E()]))
@@ -0,0 +1,64 @@
+# test dicts that grow large and have many entries deleted and re-added
+
+
+class Key:
+    # a key type whose instances collide in the hash table
+    def __init__(self, n):
+        self.n = n
+
+    def __hash__(self):
+        return self.n % 4
+
+    def __eq__(self, other):
+        return isinstance(other, Key) and self.n == other.n
+
+
+def check(d, ref):
+    if len(d) != len(ref):
+        return False
+    for k, v in ref.items():
+        if d.get(k) != v:
+            return False
+    return sorted(d.values()) == sorted(ref.values())
+
+
+for make_key in (str, lambda n: n, lambda n: (n, "t"), Key):
+    d = {}
+    ref = {}
+    ok = True
+    for i in range(600):
+        k = make_key(i * 7 % 211)
+        if i % 3 == 2 and k in d:
+            del d[k]
+            del ref[k]
+        else:
+            d[k] = i
+            ref[k] = i
+        if i % 50 == 0:
+            ok = ok and check(d, ref)
+    ok = ok and check(d, ref)
+    c = d.copy()
+    while d:
+        k, v = d.popitem()
+        ok = ok and c.pop(k) == v and k not in d
+    print(ok, len(c), len(ref))
+
+# qstr keys, as for instance and module attributes
+d = {}
+for i in range(100):
+    d["attr%d" % i] = i
+for i in range(0, 100, 2):
+    del d["attr%d" % i]
+print(len(d), sum(d.values()), "attr1" in d, "attr2" in d)
+
+# copy of a dict, then mutate both
+c = d.copy()
+c["new"] = 1
+del d["attr1"]
+print(len(d), len(c), "attr1" in c, "new" in d)
+
+# clear and reuse
+d.clear()
+for i in range(40):
+    d[i] = i
+print(len(d), d[39], sum(d))
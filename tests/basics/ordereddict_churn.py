@@ -0,0 +1,28 @@
+# test an OrderedDict that grows large and has entries deleted and moved
+try:
+    from collections import OrderedDict
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+d = OrderedDict()
+for i in range(50):
+    d["k%d" % i] = i
+for i in range(0, 50, 3):
+    del d["k%d" % i]
+print(len(d), list(d.values()))
+
+# adding after deletions keeps the insertion order
+for i in range(0, 50, 3):
+    d["k%d" % i] = -i
+print(list(d.values())[-5:])
+
+d.move_to_end("k1")
+d.move_to_end("k49", last=False)
+print(list(d.keys())[:3], list(d.keys())[-3:])
+
+# popitem takes the most recently inserted entry
+print(d.popitem(), d.popitem(), len(d))
+
+# lookups still work after all of the above
+print(all(d["k%d" % abs(v)] == v for v in d.values()))
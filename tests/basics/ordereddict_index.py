@@ -0,0 +1,78 @@
+# test OrderedDicts large enough to be indexed, checked against a list of
+# their entries after a long mix of adds, deletes, moves and pops
+try:
+    from collections import OrderedDict
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+seed = 1
+
+
+def rand(n):
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+    return seed % n
+
+
+class Key:
+    # a key type whose instances collide in the index
+    def __init__(self, n):
+        self.n = n
+
+    def __hash__(self):
+        return self.n % 7
+
+    def __eq__(self, other):
+        return isinstance(other, Key) and self.n == other.n
+
+
+def find(ref, k):
+    for i in range(len(ref)):
+        if ref[i][0] == k:
+            return i
+    return None
+
+
+def run(make_key, rounds, nkeys):
+    d = OrderedDict()
+    ref = []
+    ok = True
+    for step in range(rounds):
+        op = rand(10)
+        k = make_key(rand(nkeys))
+        i = find(ref, k)
+        if op < 4:
+            d[k] = step
+            if i is None:
+                ref.append([k, step])
+            else:
+                ref[i][1] = step
+        elif op < 6:
+            if i is None:
+                ok = ok and d.pop(k, None) is None
+            else:
+                del d[k]
+                ref.pop(i)
+        elif op == 6 and i is not None:
+            last = rand(2) == 0
+            d.move_to_end(k, last)
+            if last:
+                ref.append(ref.pop(i))
+            else:
+                ref.insert(0, ref.pop(i))
+        elif op == 7 and ref:
+            ok = ok and d.popitem() == tuple(ref.pop())
+        elif op == 8 and rand(20) == 0:
+            d = d.copy()
+        elif op == 9 and rand(100) == 0:
+            d.clear()
+            ref = []
+        if step % 100 == 0 or step == rounds - 1:
+            ok = ok and [list(kv) for kv in d.items()] == ref
+            ok = ok and all(d.get(kv[0]) == kv[1] for kv in ref)
+    return ok, len(d)
+
+
+for make_key in (lambda n: n, lambda n: "s%d" % n, lambda n: (n, "t"), Key):
+    print(run(make_key, 300, 40), run(make_key, 1500, 250))
@@ -0,0 +1,80 @@
+# check chains of effects, some of which pass their input straight through,
+# against the samples they produce and make sure the source is not modified
+import array
+import audiocore
+import audiodelays
+import audiofilters
+import audiofreeverb
+import audiomixer
+import synthio
+
+RATE = 8000
+data = array.array("h", [((i * 1237) & 0xFFFF) - 0x8000 for i in range(4096)])
+original = bytes(data)
+src = audiocore.RawSample(data, channel_count=2, sample_rate=RATE)
+settings = dict(buffer_size=512, channel_count=2, sample_rate=RATE)
+
+
+def checksum(buf):
+    c = 0
+    for i in range(0, len(buf), 3):
+        c = (c * 33 + buf[i]) & 0xFFFFFF
+    return c
+
+
+def run(name, chain, n=8):
+    # playing resets the upstream sample, which stops a mixer's voices
+    for upstream, effect in zip(chain, chain[1:]):
+        effect.play(upstream, loop=True)
+    chain[0].play(src, loop=True)
+    out = chain[-1]
+    sums = []
+    for _ in range(n):
+        sums.append(checksum(audiocore.get_buffer(out)[1]))
+    print(name, sums)
+
+
+# effects at mix 0 hand their input on
+chain = [
+    audiofilters.Distortion(mix=0.0, **settings),
+    audiofilters.Filter(mix=0.0, **settings),
+    audiodelays.Echo(mix=0.0, **settings),
+    audiofilters.Phaser(mix=0.0, **settings),
+]
+run("dry", chain)
+
+# wet effects processing a read-only sample, then each other's output
+run("distortion", [audiofilters.Distortion(mix=1.0, drive=0.5, **settings)])
+run(
+    "wet",
+    [
+        audiofilters.Distortion(mix=1.0, drive=0.5, **settings),
+        audiofilters.Filter(filter=synthio.Biquad(synthio.FilterMode.LOW_PASS, 1000), **settings),
+        audiodelays.Echo(mix=0.5, delay_ms=20, **settings),
+        audiodelays.Chorus(mix=0.5, voices=2, **settings),
+        audiofilters.Phaser(mix=0.5, **settings),
+        audiodelays.PitchShift(semitones=3, **settings),
+        audiodelays.MultiTapDelay(mix=0.5, taps=(0.25, 0.5), **settings),
+        audiofreeverb.Freeverb(mix=0.5, **settings),
+    ],
+)
+
+# mixes which change between dry and wet within a block
+lfo = synthio.LFO(rate=3)
+large = dict(settings, buffer_size=4096)
+run("lfo", [audiofilters.Distortion(mix=lfo, drive=0.5, **large)])
+run(
+    "lfo chain",
+    [
+        audiofilters.Distortion(mix=0.0, **large),
+        audiofilters.Distortion(mix=lfo, drive=0.5, **large),
+        audiodelays.Echo(mix=lfo, delay_ms=20, **large),
+    ],
+)
+
+# a mixer upstream, with a smaller buffer downstream
+mixer = audiomixer.Mixer(voice_count=1, bits_per_sample=16, samples_signed=True, **settings)
+small = dict(settings, buffer_size=256)
+run("mixer", [mixer, audiofilters.Distortion(mix=0.0, **small), audiodelays.Echo(mix=0.5, **small)])
+
+print(bytes(data) == original)
@@ -0,0 +1,37 @@
+# check the samples produced when voices at different levels are mixed,
+# including saturation and unsigned input and output
+import array
+import audiocore
+import audiomixer
+
+
+def mix(levels, datas, signed=True, typecode="h"):
+    m = audiomixer.Mixer(
+        voice_count=len(datas),
+        buffer_size=64,
+        channel_count=2,
+        bits_per_sample=16,
+        samples_signed=signed,
+        sample_rate=8000,
+    )
+    for v, (level, data) in enumerate(zip(levels, datas)):
+        m.voice[v].level = level
+        m.play(
+            audiocore.RawSample(array.array(typecode, data), channel_count=2, sample_rate=8000),
+            voice=v,
+            loop=True,
+        )
+    print(list(audiocore.get_buffer(m)[1][:8]))
+
+
+a = [0, 1, -1, 1000, -1000, 32767, -32768, 12345]
+b = [7, -7, 20000, -20000, 30000, -30000, 32767, -32768]
+
+mix([1.0], [a])
+mix([0.5], [a])
+mix([0.0], [a])
+mix([1.0, 1.0], [a, b])
+mix([1.0, 1.0], [a, a])
+mix([1.0, 0.5], [a, b])
+mix([0.25, 0.75, 1.0], [a, b, a])
+mix([1.0, 0.5], [[x + 0x8000 for x in a], [x + 0x8000 for x in b]], signed=False, typecode="H")
@@ -0,0 +1,185 @@
+# Encodes frames with gifio.GifWriter, decodes the result with the small GIF
+# decoder below, and checks every pixel against the palette index the writer
+# should have chosen.
+
+import io
+import struct
+from array import array
+
+import displayio
+import gifio
+
+RB_BAYER = ((0, 33, 8, 42), (50, 16, 58, 25), (12, 46, 4, 37), (63, 29, 54, 21))
+G_BAYER = ((0, 16, 4, 20), (24, 8, 28, 12), (6, 22, 2, 18), (31, 14, 26, 10))
+
+
+def read_blocks(gif, pos):
+    blocks = []
+    while gif[pos]:
+        blocks.append(gif[pos + 1 : pos + 1 + gif[pos]])
+        pos += 1 + gif[pos]
+    return blocks, pos + 1
+
+
+def lzw_decode(data, min_code_size):
+    clear = 1 << min_code_size
+    code_bits = min_code_size + 1
+    table = [bytes([i]) for i in range(clear)] + [b"", b""]
+    out = bytearray()
+    prev = None
+    bit_buffer = bit_count = pos = 0
+    while True:
+        while bit_count < code_bits:
+            bit_buffer |= data[pos] << bit_count
+            pos += 1
+            bit_count += 8
+        code = bit_buffer & ((1 << code_bits) - 1)
+        bit_buffer >>= code_bits
+        bit_count -= code_bits
+        if code == clear:
+            table = table[: clear + 2]
+            code_bits = min_code_size + 1
+            prev = None
+            continue
+        if code == clear + 1:
+            break
+        if code < len(table):
+            entry = table[code]
+        elif code == len(table) and prev is not None:
+            entry = prev + prev[:1]
+        else:
+            raise ValueError("bad code %d" % code)
+        out.extend(entry)
+        if prev is not None and len(table) < 4096:
+            table.append(prev + entry[:1])
+            if len(table) == 1 << code_bits and code_bits < 12:
+                code_bits += 1
+        prev = entry
+    if pos != len(data):
+        raise ValueError("data after end code")
+    return out
+
+
+# Returns the palette and, for each frame, its rectangle, delay and the whole
+# image as it is shown after that frame.
+def decode(gif):
+    assert gif[:6] == b"GIF89a"
+    width, height, flags = struct.unpack("<HHB", gif[6:11])
+    pos = 13
+    palette_size = 3 * (2 << (flags & 7))
+    palette = gif[pos : pos + palette_size]
+    pos += palette_size
+    canvas = bytearray(width * height)
+    frames = []
+    loop = False
+    transparent = None
+    delay = 0
+    while True:
+        kind = gif[pos]
+        pos += 1
+        if kind == 0x21:
+            label = gif[pos]
+            blocks, pos = read_blocks(gif, pos + 1)
+            if label == 0xF9:
+                packed, delay, index = struct.unpack("<BHB", blocks[0])
+                transparent = index if packed & 1 else None
+            elif label == 0xFF and blocks[0] == b"NETSCAPE2.0":
+                loop = True
+        elif kind == 0x2C:
+            x0, y0, w, h, flags = struct.unpack("<HHHHB", gif[pos : pos + 9])
+            assert flags == 0
+            min_code_size = gif[pos + 9]
+            blocks, pos = read_blocks(gif, pos + 10)
+            pixels = lzw_decode(b"".join(blocks), min_code_size)
+            assert len(pixels) == w * h
+            for y in range(h):
+                for x in range(w):
+                    p = pixels[y * w + x]
+                    if p != transparent:
+                        canvas[(y0 + y) * width + x0 + x] = p
+            frames.append(((x0, y0, w, h), delay, bytes(canvas)))
+            transparent = None
+            delay = 0
+        else:
+            assert kind == 0x3B
+            break
+    assert pos == len(gif)
+    return width, height, loop, palette, frames
+
+
+def expected_index(colorspace, dither, pixel, x, y):
+    if colorspace == displayio.Colorspace.L8:
+        return pixel >> 1
+    if colorspace in (displayio.Colorspace.RGB565_SWAPPED, displayio.Colorspace.BGR565_SWAPPED):
+        pixel = ((pixel & 0xFF) << 8) | (pixel >> 8)
+    if not dither:
+        return ((pixel >> 14) & 3) << 5 | ((pixel >> 8) & 7) << 2 | ((pixel >> 3) & 3)
+    red = max(0, ((pixel >> 8) & 0xF8) - RB_BAYER[x % 4][y % 4])
+    green = max(0, ((pixel >> 3) & 0xFC) - G_BAYER[x % 4][(y + 2) % 4])
+    blue = max(0, ((pixel << 3) & 0xF8) - RB_BAYER[(x + 2) % 4][y % 4])
+    return ((red >> 1) & 0x60) | ((green >> 3) & 0x1C) | (blue >> 6)
+
+
+def gradient(x, y, n):
+    return (x * 37 + y * 11 + n * 5) & 0xFFFF
+
+
+def noise(x, y, n):
+    return (((x + 1) * 0x9E3779B1 ^ (y + 7) * 0x85EBCA6B ^ n * 0x27D4EB2F) >> 7) & 0xFFFF
+
+
+def square(x, y, n):
+    # A static background with an 8x8 square that moves a little each frame,
+    # and doesn't move in the last frame.
+    n = min(n, 3)
+    if 4 + 3 * n <= x < 12 + 3 * n and 2 + n <= y < 10 + n:
+        return 0xFFFF
+    return (x // 4 * 0x0841 + y * 0x1000) & 0xFFFF
+
+
+def run(name, colorspace, width, height, frames, pattern, dither=False, delta=False):
+    l8 = colorspace == displayio.Colorspace.L8
+    out = io.BytesIO()
+    g = gifio.GifWriter(out, width, height, colorspace, dither=dither, delta=delta)
+    expected = []
+    for n in range(frames):
+        values = [pattern(x, y, n) for y in range(height) for x in range(width)]
+        if l8:
+            buf = bytearray(v & 0xFF for v in values)
+        else:
+            buf = array("H", values)
+        g.add_frame(buf, 0.25)
+        expected.append(
+            bytes(
+                expected_index(colorspace, dither, buf[y * width + x], x, y)
+                for y in range(height)
+                for x in range(width)
+            )
+        )
+    g.deinit()
+    gif = out.getvalue()
+    w, h, loop, palette, decoded = decode(gif)
+    assert (w, h, loop) == (width, height, True)
+    assert len(palette) == (768 if delta else 384)
+    ok = all(d[2] == e for d, e in zip(decoded, expected)) and len(decoded) == frames
+    print(name, width, height, "ok" if ok else "MISMATCH", len(gif))
+    print("  delays", [d[1] for d in decoded])
+    if delta:
+        print("  rects", [d[0] for d in decoded])
+    return palette
+
+
+cs = displayio.Colorspace
+palette = run("RGB565", cs.RGB565, 1, 1, 1, gradient)
+print("  palette", list(palette[3 * 0x7F : 3 * 0x80]), list(palette[3 * 0x60 : 3 * 0x61]))
+run("BGR565", cs.BGR565, 7, 5, 2, gradient)
+run("RGB565_SWAPPED", cs.RGB565_SWAPPED, 33, 17, 2, gradient)
+palette = run("L8", cs.L8, 20, 10, 1, gradient)
+print("  palette", list(palette[3 * 0x40 : 3 * 0x41]))
+run("dither", cs.RGB565, 31, 9, 1, gradient, dither=True)
+# Enough pixels that the dictionary fills up and is cleared.
+run("gradient", cs.RGB565, 96, 64, 1, gradient)
+run("noise", cs.RGB565, 64, 64, 1, noise)
+run("noise L8", cs.L8, 80, 80, 1, noise)
+run("delta", cs.RGB565, 24, 16, 6, square, delta=True)
+run("delta dither", cs.RGB565, 24, 16, 3, square, dither=True, delta=True)
@@ -0,0 +1,66 @@
+from io import BytesIO
+import msgpack
+
+obj = {"a": (-1, 0, 2, [3, None], 128), "b": b"xyz"}
+
+# pack_into writes at offset and returns how many bytes it wrote
+buf = bytearray(b"--" + bytes(40))
+n = msgpack.pack_into(obj, buf, 2)
+print(n, buf[: 2 + n])
+s = BytesIO()
+msgpack.pack(obj, s)
+print(s.getvalue() == buf[2 : 2 + n])
+
+# several objects in a row, each starting where the previous one ended
+offset = 2 + n
+offset += msgpack.pack_into("second", buf, offset)
+offset += msgpack.pack_into(3, buf, offset)
+print(offset)
+
+# unpack_from returns the object and where it ended
+end = 2
+while end < offset:
+    item, end = msgpack.unpack_from(buf, end, use_list=False)
+    print(item, end)
+print(msgpack.unpack_from(memoryview(buf)[2:], 0))
+
+# the buffer is too small, or the offset is outside it
+try:
+    msgpack.pack_into(obj, bytearray(n - 1))
+except ValueError as e:
+    print("ValueError", e)
+try:
+    msgpack.pack_into(1, bytearray(4), 5)
+except ValueError:
+    print("ValueError offset")
+try:
+    msgpack.unpack_from(buf[: 2 + n - 1], 2)
+except (EOFError, ValueError) as e:
+    print(type(e).__name__)
+
+# ext types through default and ext_hook
+class Point:
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+
+def encoder(o):
+    return msgpack.ExtType(5, bytes((o.x, o.y)))
+
+
+def decoder(code, data):
+    return (code, data)
+
+
+n = msgpack.pack_into(Point(1, 2), buf, default=encoder)
+print(n, msgpack.unpack_from(buf, ext_hook=decoder))
+
+# when unpack fails part way through, the stream is left just after the byte that failed,
+# so the next object can still be read
+s = BytesIO(b"\x92\x01\xc1\x07")
+try:
+    msgpack.unpack(s)
+except ValueError as e:
+    print("ValueError", e)
+print(s.tell(), msgpack.unpack(s))
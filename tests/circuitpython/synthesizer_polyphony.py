@@ -0,0 +1,60 @@
+# check the mix of many voices of different kinds, in mono and in stereo
+import array
+from math import sin, pi
+from audiocore import get_buffer
+from synthio import Biquad, Envelope, FilterMode, LFO, Note, Synthesizer
+
+sine = array.array("h", [int(32767 * sin(i * 2 * pi / 64)) for i in range(64)])
+saw = array.array("h", [i * 1024 - 32768 for i in range(64)])
+envelope = Envelope(attack_time=0.01, decay_time=0.02, release_time=0.02, sustain_level=0.6)
+
+
+def checksum(buf):
+    c = 0
+    for i in range(0, len(buf), 5):
+        c = (c * 31 + buf[i]) & 0xFFFFFF
+    return c
+
+
+def run(name, channel_count, notes, blocks=12):
+    synth = Synthesizer(sample_rate=48000, channel_count=channel_count, envelope=envelope)
+    synth.press(notes)
+    sums = []
+    for i in range(blocks):
+        if i == blocks // 2:
+            # release every other note part way through
+            synth.release(notes[::2])
+        sums.append(checksum(get_buffer(synth)[1]))
+    print(name, channel_count, sums)
+
+
+for channel_count in (1, 2):
+    run("midi", channel_count, list(range(40, 51)))
+    run("single", channel_count, [Note(440, waveform=sine)])
+    run(
+        "notes",
+        channel_count,
+        [
+            Note(110 * (i + 1), waveform=(sine, saw)[i % 2], panning=i / 4 - 1, amplitude=1 - i / 10)
+            for i in range(9)
+        ],
+    )
+    run(
+        "loops",
+        channel_count,
+        [Note(220 + 50 * i, waveform=saw, waveform_loop_start=i, waveform_loop_end=40 + i) for i in range(5)],
+    )
+    run(
+        "mixed",
+        channel_count,
+        [
+            Note(261, waveform=sine, panning=-0.5),
+            Note(330, ring_frequency=55, ring_waveform=sine),
+            Note(392, waveform=saw, filter=Biquad(FilterMode.LOW_PASS, 800)),
+            Note(523, waveform=sine, bend=LFO(rate=5, scale=0.1)),
+            Note(659, waveform=saw, amplitude=LFO(rate=3, offset=0.5, scale=0.5), panning=0.7),
+            60,
+            67,
+        ],
+    )
+    run("nyquist", channel_count, [Note(30000), Note(440), 127])
@@ -0,0 +1,112 @@
+# Directory listings are cached for imports, and must be forgotten when files change.
+import os
+import sys
+
+try:
+    os.VfsFat
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMBlockDevice:
+    ERASE_BLOCK_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.ERASE_BLOCK_SIZE)
+        self.fail_reads = False
+
+    def readblocks(self, block, buf, off=0):
+        if self.fail_reads:
+            return -5  # EIO
+        addr = block * self.ERASE_BLOCK_SIZE + off
+        for i in range(len(buf)):
+            buf[i] = self.data[addr + i]
+
+    def writeblocks(self, block, buf, off=None):
+        if off is None:
+            off = 0
+        addr = block * self.ERASE_BLOCK_SIZE + off
+        for i in range(len(buf)):
+            self.data[addr + i] = buf[i]
+
+    def ioctl(self, op, arg):
+        if op == 4:  # block count
+            return len(self.data) // self.ERASE_BLOCK_SIZE
+        if op == 5:  # block size
+            return self.ERASE_BLOCK_SIZE
+        if op == 6:  # erase block
+            return 0
+
+
+def write(path, text):
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def try_import(name):
+    sys.modules.pop(name, None)
+    try:
+        print(name, __import__(name).value)
+    except ImportError:
+        print(name, "ImportError")
+
+
+bdev = RAMBlockDevice(64)
+os.VfsFat.mkfs(bdev)
+os.mount(os.VfsFat(bdev), "/ramdisk")
+sys.path.insert(0, "/ramdisk")
+os.mkdir("/ramdisk/lib")
+sys.path.insert(1, "/ramdisk/lib")
+
+# A module that wasn't there is found once it is written.
+try_import("later")
+write("/ramdisk/later.py", "value = 1\n")
+try_import("later")
+
+# FAT doesn't care about case.
+write("/ramdisk/lib/Mixed.py", "value = 2\n")
+try_import("Mixed")
+try_import("mixed")
+
+# Removing and renaming.
+os.rename("/ramdisk/lib/Mixed.py", "/ramdisk/lib/renamed.py")
+try_import("Mixed")
+try_import("renamed")
+os.remove("/ramdisk/later.py")
+try_import("later")
+
+# A package made after the directory was listed.
+os.mkdir("/ramdisk/pkg")
+write("/ramdisk/pkg/__init__.py", "value = 3\n")
+try_import("pkg")
+
+# Relative paths follow the current directory.
+sys.path.insert(0, "")
+os.chdir("/ramdisk/lib")
+try_import("renamed")
+os.chdir("/")
+
+# A new mount replaces the listing of the old one.
+os.umount("/ramdisk")
+try_import("renamed")
+bdev2 = RAMBlockDevice(64)
+os.VfsFat.mkfs(bdev2)
+vfs2 = os.VfsFat(bdev2)
+os.mount(vfs2, "/ramdisk")
+os.mkdir("/ramdisk/lib")
+write("/ramdisk/lib/renamed.py", "value = 4\n")
+try_import("renamed")
+
+# A directory that couldn't be listed isn't taken to be empty.
+os.mkdir("/ramdisk/flaky")
+write("/ramdisk/flaky/flaky.py", "value = 5\n")
+write("/ramdisk/lib/other.py", "value = 6\n")
+sys.path.insert(0, "/ramdisk/flaky")
+bdev2.fail_reads = True
+try_import("flaky")
+bdev2.fail_reads = False
+try_import("flaky")
+os.umount("/ramdisk")
+sys.path[:] = [p for p in sys.path if not p.startswith("/ramdisk") and p]
+
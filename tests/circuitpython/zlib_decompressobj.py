@@ -0,0 +1,94 @@
+try:
+    import zlib
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# b"0123456789" * 10000, compressed by CPython's zlib.compress(..., 9)
+BIG = (
+    b"x\xda\xed\xc6I\x01\x00 \x08\x00\xb0Jx \xda\xbf\x985xl\xaf\xc5\x98k\xe7\xa9\xfb\xc2"
+    + b"\xcc" * 193
+    + b"\x9a\xed\x03\x1b\x96 \x81"
+)
+BIG_DATA = b"0123456789" * 10000
+HELLO = b"x\x9c\xcbH\xcd\xc9\xc9W(\xcf/\xcaIQ\xc8\x18\x01l\x00UvY\xb1"
+HELLO_DATA = b"hello world " * 20
+GZIP = b"\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\x03K\xaf\xca,P(.)JM\xccUH\xa7#\x1b\x00\x8e\x8bk\x87x\x00\x00\x00"
+GZIP_DATA = b"gzip stream " * 10
+
+# The one-shot path grows its output well past the size of the input.
+print(zlib.decompress(BIG) == BIG_DATA)
+
+
+def feed(d, data, chunk):
+    out = b""
+    for i in range(0, len(data), chunk):
+        out += d.decompress(data[i : i + chunk])
+    return out + d.flush()
+
+
+for data, wbits, expected in ((HELLO, 15, HELLO_DATA), (GZIP, 31, GZIP_DATA), (BIG, 0, BIG_DATA)):
+    for chunk in (1, 3, 16, 1000):
+        d = zlib.decompressobj(wbits)
+        print(wbits, chunk, feed(d, data, chunk) == expected, d.eof, d.unused_data)
+
+# Several blocks, each started again when the input runs out part way through
+# one. CPython's zlib.compressobj(9) with Z_FULL_FLUSH after each third of
+# BLOCKS_DATA.
+BLOCKS = bytes.fromhex(
+    "78da7491410e80200c04efbea24f28a510f88e068391c841fe1fe303e63cd96e3b1dd7d344659eb27a937dcc"
+    "e396d5deb58d1f04024ea0e2a84cc412918819c79e8cab15bc26281b304eb9f3b1eca1b2083661895305bba2"
+    "39abe5dfaa7e000000ffff74d1c10d80200c85e1bb537404a885c23a1a88462207d93f4ef09fbfbcf4b595d9"
+    "655d4d8e31cf4756fbd636eeb7895914a26244492b9267a2ac098953ceb39c1b16deab86809431a58e212589"
+    "09abab16a48aa9dd719699f3b7e84c3f000000ffff7491410e80200c04efbea24f8042817e4783d148f420ff"
+    "8f1f70ce934eb75b2921c9b3cb3cbaace3d92e99fd9dcb38ef2ea56542b55442cd94902727942291a8e8d368"
+    "ec0b8472c0ec160a96c1539577354ee87c57c2de63469f5a435fc51f67ffcbfe010000ffff0300ab260d1d"
+)
+BLOCKS_DATA = b"".join(b"line %d of the block test\n" % (i * i % 997) for i in range(60))
+for chunk in (1, 2, 5, 64):
+    d = zlib.decompressobj()
+    print("blocks", chunk, feed(d, BLOCKS, chunk) == BLOCKS_DATA, d.eof)
+
+# Raw DEFLATE, with a small window.
+d = zlib.decompressobj(-9)
+print(d.decompress(b"\xcbH\xcd\xc9\xc9\x07\x00"), d.eof)
+
+# Input after the end of the stream.
+d = zlib.decompressobj()
+print(d.decompress(HELLO + b"abc")[:11], d.eof, d.unused_data)
+d.decompress(b"def")
+print(d.unused_data)
+
+# max_length leaves the input it didn't need in unconsumed_tail.
+d = zlib.decompressobj()
+out = d.decompress(BIG, 1000)
+print(len(out), len(d.unconsumed_tail) > 0)
+while d.unconsumed_tail:
+    out += d.decompress(d.unconsumed_tail, 7000)
+print(out == BIG_DATA, d.eof)
+
+# decompress_into fills a caller-supplied buffer.
+d = zlib.Decompress(wbits=31)
+buf = bytearray(16)
+out = b""
+tail = GZIP
+while not d.eof:
+    n = d.decompress_into(tail, buf)
+    out += buf[:n]
+    tail = d.unconsumed_tail
+print(out == GZIP_DATA, len(d.unused_data))
+
+# A window smaller than the header asks for is enough for this stream.
+d = zlib.decompressobj(9)
+print(d.decompress(BIG) == BIG_DATA)
+
+for wbits in (7, -16, 40):
+    try:
+        zlib.decompressobj(wbits)
+    except ValueError:
+        print("ValueError", wbits)
+
+try:
+    zlib.decompressobj().decompress(b"abc")
+except ValueError as e:
+    print("ValueError", e)
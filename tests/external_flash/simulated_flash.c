@@ -0,0 +1,105 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "simulated_flash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/flash.h"
+#include "supervisor/port.h"
+#include "supervisor/spi_flash_api.h"
+#include "supervisor/shared/external_flash/common_commands.h"
+
+uint8_t simulated_flash[SIMULATED_FLASH_SIZE];
+simulated_flash_counts_t simulated_flash_counts;
+
+static size_t ram_budget = SIZE_MAX;
+static size_t ram_in_use;
+
+bool spi_flash_command(uint8_t command) {
+    return true;
+}
+
+bool spi_flash_read_command(uint8_t command, uint8_t *response, uint32_t length) {
+    memset(response, 0, length);
+    if (command == CMD_READ_JEDEC_ID && length >= 3) {
+        response[0] = 0xef;
+        response[1] = 0x40;
+        response[2] = 0x15;
+    }
+    return true;
+}
+
+bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t length) {
+    return true;
+}
+
+bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    if (command == CMD_SECTOR_ERASE) {
+        memset(simulated_flash + (address & ~(SIMULATED_FLASH_SECTOR_SIZE - 1)), 0xff, SIMULATED_FLASH_SECTOR_SIZE);
+        simulated_flash_counts.erases++;
+    }
+    return true;
+}
+
+bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    for (uint32_t i = 0; i < data_length; i++) {
+        if ((data[i] & ~simulated_flash[address + i]) != 0) {
+            simulated_flash_counts.violations++;
+        }
+        simulated_flash[address + i] &= data[i];
+    }
+    simulated_flash_counts.bytes_programmed += data_length;
+    return true;
+}
+
+bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    memcpy(data, simulated_flash + address, data_length);
+    return true;
+}
+
+void spi_flash_init(void) {
+}
+
+void spi_flash_init_device(const external_flash_device *device) {
+}
+
+void common_hal_mcu_delay_us(uint32_t delay) {
+}
+
+// Each allocation remembers its size so that port_free can give it back to the budget.
+void *port_malloc(size_t size, bool dma_capable) {
+    if (size > ram_budget - ram_in_use) {
+        return NULL;
+    }
+    size_t *allocation = malloc(sizeof(size_t) + size);
+    if (allocation == NULL) {
+        return NULL;
+    }
+    allocation[0] = size;
+    ram_in_use += size;
+    return allocation + 1;
+}
+
+void port_free(void *ptr) {
+    size_t *allocation = (size_t *)ptr - 1;
+    ram_in_use -= allocation[0];
+    free(allocation);
+}
+
+void supervisor_flash_flush(void) {
+    supervisor_external_flash_flush();
+}
+
+void simulated_flash_set_ram_budget(size_t budget) {
+    ram_budget = budget;
+}
+
+size_t simulated_flash_ram_in_use(void) {
+    return ram_in_use;
+}
@@ -0,0 +1,31 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// A NOR flash part behind the spi_flash_api, for running external_flash.c on the host. Like the
+// real thing, programming can only clear bits and erasing sets a whole 4kB sector to 0xff.
+// Programming a bit back to 1 without an erase is counted as a violation instead of being ignored.
+
+#define SIMULATED_FLASH_SIZE (1 << 21)
+#define SIMULATED_FLASH_SECTOR_SIZE (4096)
+
+typedef struct {
+    uint32_t erases;
+    uint32_t bytes_programmed;
+    uint32_t violations;
+} simulated_flash_counts_t;
+
+extern uint8_t simulated_flash[SIMULATED_FLASH_SIZE];
+extern simulated_flash_counts_t simulated_flash_counts;
+
+// Limits how much port_malloc hands out at once, to run the cache short of ram.
+void simulated_flash_set_ram_budget(size_t budget);
+size_t simulated_flash_ram_in_use(void);
@@ -0,0 +1,21 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Stands in for the real header when external_flash.c is built on the host.
+
+#pragma once
+
+// A 2MB part that answers the JEDEC ID that simulated_flash.c sends.
+#define EXTERNAL_FLASH_DEVICES { \
+        .total_size = (1 << 21), \
+        .start_up_time_us = 0, \
+        .manufacturer_id = 0xef, \
+        .memory_type = 0x40, \
+        .capacity = 0x15, \
+        .max_clock_speed_mhz = 80, \
+        .single_status_byte = true, \
+        .no_reset_cmd = true, \
+}
@@ -0,0 +1,13 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Stands in for the real header when external_flash.c is built on the host.
+
+#pragma once
+
+#include <stdint.h>
+
+void common_hal_mcu_delay_us(uint32_t delay);
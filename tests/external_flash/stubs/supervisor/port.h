@@ -0,0 +1,15 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Stands in for the real header when external_flash.c is built on the host.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+void *port_malloc(size_t size, bool dma_capable);
+void port_free(void *ptr);
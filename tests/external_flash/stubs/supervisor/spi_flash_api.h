@@ -0,0 +1,23 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Stands in for the real header when external_flash.c is built on the host.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "supervisor/shared/external_flash/device.h"
+
+bool spi_flash_command(uint8_t command);
+bool spi_flash_read_command(uint8_t command, uint8_t *response, uint32_t length);
+bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t length);
+bool spi_flash_sector_command(uint8_t command, uint32_t address);
+bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length);
+bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length);
+void spi_flash_init(void);
+void spi_flash_init_device(const external_flash_device *device);
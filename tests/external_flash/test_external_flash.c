@@ -0,0 +1,262 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Runs supervisor/shared/external_flash/external_flash.c against simulated_flash.c on the host.
+// Every test keeps a copy of what each block should hold, and checks it both through the block
+// API and, once the cache is released, on the flash itself. The workloads at the end print how
+// many sectors they erased, to compare changes to the cache by.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "simulated_flash.h"
+#include "supervisor/flash.h"
+
+#define BLOCKS_PER_SECTOR (SIMULATED_FLASH_SECTOR_SIZE / FILESYSTEM_BLOCK_SIZE)
+#define PAGES_PER_SECTOR (SIMULATED_FLASH_SECTOR_SIZE / SPI_FLASH_PAGE_SIZE)
+
+static uint8_t *expected;
+static uint32_t block_count;
+static int failures;
+
+#define CHECK(condition) check((condition), #condition, __func__, __LINE__)
+
+static void check(bool ok, const char *condition, const char *test, int line) {
+    if (!ok) {
+        printf("FAIL %s:%d: %s\n", test, line, condition);
+        failures++;
+    }
+}
+
+static void random_bytes(uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = rand();
+    }
+}
+
+// Starts a test with nothing cached, the given flash contents and fresh counts.
+static void start(bool blank) {
+    supervisor_flash_release_cache();
+    simulated_flash_set_ram_budget(SIZE_MAX);
+    if (blank) {
+        memset(simulated_flash, 0xff, SIMULATED_FLASH_SIZE);
+    } else {
+        random_bytes(simulated_flash, SIMULATED_FLASH_SIZE);
+    }
+    memcpy(expected, simulated_flash, block_count * FILESYSTEM_BLOCK_SIZE);
+    memset(&simulated_flash_counts, 0, sizeof(simulated_flash_counts));
+}
+
+static void write_block(uint32_t block, const uint8_t *data) {
+    CHECK(supervisor_flash_write_blocks(data, block, 1) == 0);
+    memcpy(expected + block * FILESYSTEM_BLOCK_SIZE, data, FILESYSTEM_BLOCK_SIZE);
+}
+
+static void write_random_block(uint32_t block) {
+    uint8_t data[FILESYSTEM_BLOCK_SIZE];
+    random_bytes(data, sizeof(data));
+    write_block(block, data);
+}
+
+static bool blocks_read_back(void) {
+    uint8_t data[FILESYSTEM_BLOCK_SIZE];
+    for (uint32_t block = 0; block < block_count; block++) {
+        if (supervisor_flash_read_blocks(data, block, 1) != 0 ||
+            memcmp(data, expected + block * FILESYSTEM_BLOCK_SIZE, FILESYSTEM_BLOCK_SIZE) != 0) {
+            printf("block %u reads back wrong\n", (unsigned)block);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks the blocks with the cache in use, then releases it and checks the flash.
+static void finish(void) {
+    CHECK(blocks_read_back());
+    supervisor_flash_release_cache();
+    CHECK(memcmp(simulated_flash, expected, block_count * FILESYSTEM_BLOCK_SIZE) == 0);
+    CHECK(simulated_flash_counts.violations == 0);
+    CHECK(simulated_flash_ram_in_use() == 0);
+}
+
+static void test_blank_flash(void) {
+    start(true);
+    for (uint32_t block = 0; block < BLOCKS_PER_SECTOR; block++) {
+        write_random_block(block);
+    }
+    supervisor_flash_flush();
+    CHECK(simulated_flash_counts.erases == 0);
+    CHECK(simulated_flash_counts.bytes_programmed == SIMULATED_FLASH_SECTOR_SIZE);
+    finish();
+}
+
+static void test_unchanged_pages(void) {
+    start(false);
+    // Writing back what is already there doesn't erase or program anything.
+    for (uint32_t block = 0; block < BLOCKS_PER_SECTOR; block++) {
+        write_block(block, expected + block * FILESYSTEM_BLOCK_SIZE);
+    }
+    supervisor_flash_flush();
+    CHECK(simulated_flash_counts.erases == 0);
+    CHECK(simulated_flash_counts.bytes_programmed == 0);
+
+    // A changed block that is blank on the flash is programmed without an erase.
+    uint32_t block = BLOCKS_PER_SECTOR;
+    memset(simulated_flash + (block + 1) * FILESYSTEM_BLOCK_SIZE, 0xff, FILESYSTEM_BLOCK_SIZE);
+    memset(expected + (block + 1) * FILESYSTEM_BLOCK_SIZE, 0xff, FILESYSTEM_BLOCK_SIZE);
+    write_block(block, expected + block * FILESYSTEM_BLOCK_SIZE);
+    write_random_block(block + 1);
+    supervisor_flash_flush();
+    CHECK(simulated_flash_counts.erases == 0);
+    CHECK(simulated_flash_counts.bytes_programmed == FILESYSTEM_BLOCK_SIZE);
+
+    // A changed block that isn't blank erases the sector, and the rest of it is kept.
+    write_random_block(2 * BLOCKS_PER_SECTOR + 3);
+    supervisor_flash_flush();
+    CHECK(simulated_flash_counts.erases == 1);
+    CHECK(simulated_flash_counts.bytes_programmed == FILESYSTEM_BLOCK_SIZE + SIMULATED_FLASH_SECTOR_SIZE);
+    finish();
+}
+
+#if CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS >= 4
+static bool on_flash(uint32_t block) {
+    return memcmp(simulated_flash + block * FILESYSTEM_BLOCK_SIZE,
+        expected + block * FILESYSTEM_BLOCK_SIZE, FILESYSTEM_BLOCK_SIZE) == 0;
+}
+
+static void test_least_recently_written_is_evicted(void) {
+    start(false);
+    for (uint32_t sector = 0; sector < 4; sector++) {
+        write_random_block(sector * BLOCKS_PER_SECTOR);
+    }
+    // Four sectors fit, so nothing has been erased yet.
+    CHECK(simulated_flash_counts.erases == 0);
+    // Writing the first sector again makes the second one the least recently written.
+    write_random_block(1);
+    write_random_block(4 * BLOCKS_PER_SECTOR);
+    CHECK(simulated_flash_counts.erases == 1);
+    CHECK(on_flash(BLOCKS_PER_SECTOR));
+    CHECK(!on_flash(0));
+    CHECK(!on_flash(1));
+    CHECK(!on_flash(2 * BLOCKS_PER_SECTOR));
+    CHECK(!on_flash(3 * BLOCKS_PER_SECTOR));
+    CHECK(!on_flash(4 * BLOCKS_PER_SECTOR));
+    CHECK(blocks_read_back());
+    supervisor_flash_flush();
+    CHECK(simulated_flash_counts.erases == 5);
+    finish();
+}
+
+static void test_short_of_ram(void) {
+    start(false);
+    // Room for the page table and the pages of two sectors only.
+    simulated_flash_set_ram_budget(CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS * PAGES_PER_SECTOR * sizeof(uint8_t *) +
+        2 * SIMULATED_FLASH_SECTOR_SIZE);
+    write_random_block(0);
+    write_random_block(BLOCKS_PER_SECTOR);
+    CHECK(simulated_flash_counts.erases == 0);
+    write_random_block(2 * BLOCKS_PER_SECTOR);
+    CHECK(simulated_flash_counts.erases == 1);
+    CHECK(on_flash(0));
+    supervisor_flash_flush();
+    CHECK(simulated_flash_counts.erases == 3);
+    finish();
+}
+#endif
+
+static void test_no_ram(void) {
+    start(false);
+    // Without ram the sector is cached in the scratch sector at the end of the flash.
+    simulated_flash_set_ram_budget(0);
+    write_random_block(0);
+    write_random_block(1);
+    // The same block again can't be programmed over, so the scratch sector is flushed first.
+    write_random_block(1);
+    write_random_block(BLOCKS_PER_SECTOR);
+    finish();
+}
+
+// Appends 512 byte records to a file: the data block, then the FAT and the directory entry are
+// rewritten. Flushed every 16 records.
+static void workload_append(void) {
+    start(false);
+    uint8_t data[FILESYSTEM_BLOCK_SIZE];
+    for (int n = 0; n < 2000; n++) {
+        write_random_block(1000 + n);
+        memset(data, 0, sizeof(data));
+        data[n % FILESYSTEM_BLOCK_SIZE] = n;
+        write_block(10 + n / 128, data);
+        memset(data, 0x20, sizeof(data));
+        data[0] = n;
+        write_block(300, data);
+        if (n % 16 == 15) {
+            supervisor_flash_flush();
+        }
+    }
+    printf("append: %u erases, %u bytes programmed\n",
+        (unsigned)simulated_flash_counts.erases, (unsigned)simulated_flash_counts.bytes_programmed);
+    finish();
+}
+
+// Random writes and reads over a few sectors, with the occasional flush or release.
+static void workload_random(void) {
+    start(false);
+    uint8_t data[FILESYSTEM_BLOCK_SIZE];
+    for (int n = 0; n < 20000; n++) {
+        uint32_t block = (rand() % 6) * 7 * BLOCKS_PER_SECTOR + rand() % (3 * BLOCKS_PER_SECTOR);
+        uint8_t *old = expected + block * FILESYSTEM_BLOCK_SIZE;
+        int action = rand() % 10;
+        if (action < 6) {
+            int kind = rand() % 3;
+            for (size_t i = 0; i < sizeof(data); i++) {
+                data[i] = kind == 0 ? 0xff : kind == 1 ? (old[i] & rand()) : rand();
+            }
+            write_block(block, data);
+        } else if (action < 9) {
+            CHECK(supervisor_flash_read_blocks(data, block, 1) == 0);
+            CHECK(memcmp(data, old, sizeof(data)) == 0);
+        } else if (rand() % 10 == 0) {
+            if (rand() % 2) {
+                supervisor_flash_flush();
+            } else {
+                supervisor_flash_release_cache();
+            }
+        }
+    }
+    printf("random: %u erases, %u bytes programmed\n",
+        (unsigned)simulated_flash_counts.erases, (unsigned)simulated_flash_counts.bytes_programmed);
+    finish();
+}
+
+int main(void) {
+    srand(1);
+    supervisor_flash_init();
+    block_count = supervisor_flash_get_block_count();
+    if (block_count == 0) {
+        printf("FAIL the simulated flash wasn't found\n");
+        return 1;
+    }
+    expected = malloc(block_count * FILESYSTEM_BLOCK_SIZE);
+
+    test_blank_flash();
+    test_unchanged_pages();
+    #if CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS >= 4
+    test_least_recently_written_is_evicted();
+    test_short_of_ram();
+    #endif
+    test_no_ram();
+    workload_append();
+    workload_random();
+
+    free(expected);
+    if (failures > 0) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,49 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+try:
+    import io
+    import json
+
+    json.iterload
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# Each element of the top-level array is parsed when it is asked for.
+s = io.StringIO('[1, "two", [3, {"four": 4}], null] {"next": true}')
+it = json.iterload(s)
+for value in it:
+    print(value)
+print(list(it))
+# The stream is left just after the array.
+print(repr(s.read()))
+
+print(list(json.iterload(io.BytesIO(b" [ ] "))))
+print(list(json.iterload(io.BytesIO(b"[[]]"))))
+
+
+# Objects that only have readinto work too.
+class Buffer:
+    def __init__(self, data):
+        self._data = data
+        self._i = 0
+
+    def readinto(self, buf):
+        n = min(len(buf), len(self._data) - self._i, 5)
+        buf[:n] = self._data[self._i : self._i + n]
+        self._i += n
+        return n
+
+
+print(list(json.iterload(Buffer(b'[{"a": [1, 2, 3]}, "bcdefghijklmnop", 1.5]'))))
+
+for data in ("{}", "[1, 2", "[1, }", "", "7", "[1 2]", "[,1]", "[1,,2]", "[1,]", "[,]"):
+    try:
+        print(list(json.iterload(io.StringIO(data))))
+    except ValueError:
+        print("ValueError", repr(data))
+
+# load reads ahead from streams that can seek, and moves them back afterwards.
+s = io.StringIO('{"a": [1, 2]} [3]  "four" ' + "x" * 1000)
+print(json.load(s), json.load(s), json.load(s), len(s.read()))
+s = io.BytesIO(b"[" + b"1, " * 1000 + b"1] rest")
+print(len(json.load(s)), s.read())
@@ -0,0 +1,33 @@
+try:
+    import re
+
+    re.finditer
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def spans(it):
+    return [m.span() for m in it]
+
+
+print(spans(re.finditer("ab", "xxabyyabab")))
+print(spans(re.finditer("z", "abc")))
+print([m.group(1) for m in re.finditer("(\\d+)-", "1-22-333-4")])
+print([m.group(0) for m in re.finditer(b"[0-9]+", b"a1b22c333")])
+
+# Empty matches, including one just after a non-empty match.
+print([m.group(0) for m in re.finditer("x*", "axb")])
+print(spans(re.finditer("", "abc")))
+
+# A compiled pattern, iterated a step at a time.
+r = re.compile("o+")
+it = r.finditer("foo boo")
+print(next(it).group(0), next(it).span())
+try:
+    next(it)
+except StopIteration:
+    print("StopIteration")
+
+# ^ only matches at the start of the string.
+print(spans(re.finditer("^a", "aaa")))
@@ -0,0 +1,28 @@
+# Searches for patterns that start with a literal, which only run the matcher
+# where the literal is found.
+try:
+    import re
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+print(re.search("abc", "xxabxabcx").span())
+print(re.search("abc", "xxabxab"))
+print(re.search("(a)(b)c", "aabaabc").span(2))
+print(re.search("ab+c", "abac abbbc abc").group(0))
+print(re.search("ab?c", "abbc ac").group(0))
+print(re.search("ab*c", "abbd abbbbc").group(0))
+print(re.search("ab|cd", "xxcd").group(0))
+print(re.search("\\.x", "a.b.x").span())
+print(re.search("ab$", "abab").span())
+print(re.search("^ab", "xab"))
+print(re.search("abcdefghijkl", "abcdefghijk abcdefghijkl").span())
+print(re.compile("ab").split("1ab2ab3"))
+print(re.sub("cat", "dog", "cat catcat ca"))
+
+# More patterns than are kept compiled at once, used in turn.
+for _ in range(2):
+    for i in range(10):
+        print(re.match("p%d" % i, "p%d" % i).group(0), end=" ")
+        print(re.search("q%d" % i, "p%d" % i), end=" ")
+    print()
@@ -0,0 +1,54 @@
+# check that live objects survive when automatic collections are frequent,
+# including objects that are allocated, grown, shrunk and freed while the
+# heap is still being swept after such a collection
+
+try:
+    import gc
+
+    gc.threshold
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# a small threshold triggers an automatic collection every few allocations
+gc.collect()
+gc.threshold(512)
+
+live = []
+for i in range(2000):
+    # short-lived garbage of varying size
+    junk = [i] * (i % 37)
+    junk = bytearray(i % 200)
+
+    # long-lived objects, some of which are grown in place or moved
+    if i % 5 == 0:
+        live.append([i, bytearray(i % 50 + 1), str(i) * (i % 7)])
+    if live and i % 7 == 0:
+        live[(i * 3) % len(live)][1].extend(b"x" * (i % 90))
+    if live and i % 11 == 0:
+        # shrink a large bytearray by slicing it
+        entry = live[i % len(live)]
+        entry[1] = entry[1][: len(entry[1]) // 2]
+    if len(live) > 150:
+        del live[i % len(live)]
+
+gc.threshold(-1)
+
+# verify that nothing reachable was reclaimed or corrupted
+ok = True
+for entry in live:
+    n = entry[0]
+    if entry[2] != str(n) * (n % 7):
+        ok = False
+    b = entry[1]
+    if any(c not in (0, ord("x")) for c in b):
+        ok = False
+print(len(live), ok)
+
+# gc.collect() sweeps completely, so these must match afterwards; a already
+# exists so that storing it doesn't grow the globals in between
+a = 0
+gc.collect()
+a = gc.mem_alloc()
+gc.collect()
+print(a == gc.mem_alloc())
@@ -0,0 +1,41 @@
+# This tests building a large dict and then deleting and re-adding entries,
+# which exercises map growth and the handling of deleted entries.
+
+
+def test(n, keys):
+    total = 0
+    for _ in range(n):
+        d = {}
+        for k in keys:
+            d[k] = k
+        for k in keys[::2]:
+            del d[k]
+        for k in keys[::4]:
+            d[k] = k
+        total += len(d)
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (2, 100),
+    (1000, 10): (10, 1000),
+    (5000, 10): (20, 5000),
+}
+
+
+def bm_setup(params):
+    nloop, nkeys = params
+    keys = [i * 7919 % 100003 for i in range(nkeys)]
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(nloop, keys)
+
+    def result():
+        return nloop * nkeys // 100, state
+
+    return run, result
@@ -0,0 +1,40 @@
+# This tests looking up string keys in a large dict, both keys that are present
+# and keys that are not.
+
+
+def test(n, d, keys):
+    found = 0
+    for _ in range(n):
+        for k in keys:
+            if k in d:
+                found += d[k]
+    return found
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (4, 100),
+    (1000, 10): (20, 1000),
+    (5000, 10): (40, 5000),
+}
+
+
+def bm_setup(params):
+    nloop, nkeys = params
+    d = {}
+    for i in range(nkeys):
+        d["key%d" % (i * 2)] = 1
+    # half of these are in the dict
+    keys = ["key%d" % i for i in range(nkeys)]
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(nloop, d, keys)
+
+    def result():
+        return nloop * nkeys // 100, state
+
+    return run, result
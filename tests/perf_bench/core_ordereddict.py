@@ -0,0 +1,47 @@
+# This tests using an OrderedDict as an LRU cache: looking up keys that are
+# present and keys that are not, moving the keys that are found to the end,
+# and adding the missing ones while dropping the oldest entry.
+
+from collections import OrderedDict
+
+
+def test(n, d, keys):
+    hits = 0
+    for _ in range(n):
+        for k in keys:
+            if k in d:
+                hits += 1
+                d.move_to_end(k)
+            else:
+                del d[next(iter(d))]
+                d[k] = k
+    return hits
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (2, 50),
+    (1000, 10): (10, 500),
+    (5000, 10): (20, 2000),
+}
+
+
+def bm_setup(params):
+    nloop, nkeys = params
+    d = OrderedDict()
+    for i in range(nkeys):
+        d["key%d" % (i * 2)] = i
+    # about half of these are in the dict at any time
+    keys = ["key%d" % (i * 7 % (nkeys * 2)) for i in range(nkeys * 2)]
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(nloop, d, keys)
+
+    def result():
+        return nloop * nkeys // 50, state
+
+    return run, result
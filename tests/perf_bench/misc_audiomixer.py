@@ -0,0 +1,64 @@
+# Mix eight voices of 16-bit stereo audio with an audiomixer.Mixer, as a board
+# does while playing.  Buffers are pulled with audiocore.get_buffer, which is
+# only available when CIRCUITPY_AUDIOCORE_DEBUG is enabled (e.g. the unix
+# coverage build).
+
+try:
+    import array, audiocore, audiomixer
+
+    audiocore.get_buffer
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+VOICES = 8
+# Each mixer buffer holds exactly one period of every voice, so all buffers are
+# the same and the result doesn't depend on how many are mixed.
+FRAMES = 1024
+
+
+def make_sample(voice):
+    # A sawtooth with a different period and phase in each channel.
+    data = array.array("h", [0] * (2 * FRAMES))
+    for i in range(FRAMES):
+        data[2 * i] = ((i * (voice + 3) * 97) & 0xFFFF) - 0x8000
+        data[2 * i + 1] = ((i * (voice + 5) * 61 + voice * 4099) & 0xFFFF) - 0x8000
+    return audiocore.RawSample(data, channel_count=2, sample_rate=48000)
+
+
+def bm_setup(params):
+    (nbuf,) = params
+    mixer = audiomixer.Mixer(
+        voice_count=VOICES,
+        buffer_size=8 * FRAMES,
+        channel_count=2,
+        bits_per_sample=16,
+        samples_signed=True,
+        sample_rate=48000,
+    )
+    for v in range(VOICES):
+        # Mix one voice at full level, which takes the unscaled path.
+        mixer.voice[v].level = 1.0 if v == 0 else 0.1 + v / 10
+        mixer.play(make_sample(v), voice=v, loop=True)
+    state = [None]
+
+    def run():
+        for _ in range(nbuf):
+            state[0] = audiocore.get_buffer(mixer)[1]
+
+    def result():
+        buf = state[0]
+        check = 0
+        for i in range(0, len(buf), 61):
+            check = (check * 31 + buf[i]) & 0xFFFFFF
+        return nbuf * FRAMES * VOICES, check
+
+    return run, result
+
+
+bm_params = {
+    (50, 25): (2,),
+    (100, 100): (8,),
+    (1000, 1000): (64,),
+    (5000, 1000): (256,),
+}
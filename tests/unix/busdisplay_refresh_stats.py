@@ -0,0 +1,49 @@
+# Test that BusDisplay.refresh_stats counts the areas and pixels each refresh takes.
+try:
+    SimulatedDisplayBus
+except NameError:
+    print("SKIP")
+    raise SystemExit
+
+import busdisplay
+import displayio
+
+displayio.release_displays()
+bus = SimulatedDisplayBus(64, 48)
+display = busdisplay.BusDisplay(bus, b"", width=64, height=48, auto_refresh=False)
+print(display.refresh_stats)
+
+palette = displayio.Palette(2)
+palette[1] = 0xFFFFFF
+group = displayio.Group()
+bitmaps = []
+for x, y in ((0, 0), (56, 40)):
+    bitmap = displayio.Bitmap(8, 8, 2)
+    group.append(displayio.TileGrid(bitmap, pixel_shader=palette, x=x, y=y))
+    bitmaps.append(bitmap)
+display.root_group = group
+
+def refresh():
+    before = display.refresh_stats
+    display.refresh()
+    after = display.refresh_stats
+    print(tuple(a - b for a, b in zip(after, before)))
+
+
+# A new root group redraws the whole display as one area.
+refresh()
+
+# Nothing changed.
+refresh()
+
+# Pixels in two tile grids far apart are refreshed as two areas of one pixel each.
+bitmaps[0][1, 1] = 1
+bitmaps[1][4, 4] = 1
+refresh()
+
+# A bitmap tracks one dirty rectangle, so two pixels in it refresh the box around them.
+bitmaps[0][2, 2] = 1
+bitmaps[0][4, 3] = 1
+refresh()
+
+displayio.release_displays()
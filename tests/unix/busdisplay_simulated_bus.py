@@ -0,0 +1,43 @@
+# Test that BusDisplay sends the same pixels whether or not the bus can send in the background.
+# SimulatedDisplayBus uses data sent in the background only once the transaction ends, so a
+# buffer that is rendered into while it is being sent shows up as different pixels.
+try:
+    SimulatedDisplayBus
+except NameError:
+    print("SKIP")
+    raise SystemExit
+
+import busdisplay
+import displayio
+
+
+def refresh(width, height, asynchronous):
+    displayio.release_displays()
+    bus = SimulatedDisplayBus(width, height, asynchronous=asynchronous)
+    display = busdisplay.BusDisplay(bus, b"", width=width, height=height, auto_refresh=False)
+    bitmap = displayio.Bitmap(width, height, 8)
+    for y in range(height):
+        for x in range(width):
+            bitmap[x, y] = (x * 3 + y * 5) % 7
+    palette = displayio.Palette(7)
+    for i in range(7):
+        palette[i] = (i & 1) * 0xFF0000 | (i >> 1 & 1) * 0x00FF00 | (i >> 2) * 0x0000FF
+    group = displayio.Group()
+    group.append(displayio.TileGrid(bitmap, pixel_shader=palette))
+    display.root_group = group
+    display.refresh()
+    return bus
+
+
+# Several subrectangles, rows wider than the 512 byte minimum buffer, and an area that fits in one
+# buffer. Each subrectangle is one RAM write, and the buffer always holds at least one whole row.
+for width, height in ((64, 48), (300, 6), (480, 4), (20, 3)):
+    background = refresh(width, height, True)
+    blocking = refresh(width, height, False)
+    print(width, height)
+    print(background.async_sends > 0, blocking.async_sends)
+    print(background.ram_writes, blocking.ram_writes)
+    print(background.framebuffer == blocking.framebuffer)
+    print(bytes(background.framebuffer[:8]), bytes(background.framebuffer[-8:]))
+
+displayio.release_displays()
@@ -0,0 +1,72 @@
+# Test that a .mpy file imported from a FAT filesystem whose block device can map
+# its blocks is read in place, and that nothing else maps the block device.
+# SimulatedFlash locks its blocks against writes once they are mapped.
+try:
+    SimulatedFlash
+    import os
+
+    os.VfsFat
+except (NameError, ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+import sys
+
+# The .mpy file of a module with a 600 character string, so that it needs two
+# 512 byte clusters:
+#   text = "xxx...xxx"
+#   def check():
+#       return len(text), text.count("x")
+MPY = (
+    b"C\x06\x00\x1f\x07\x01\x0cmod.py\x00\x0f\ncheck\x00\x81\x15\x02x\x00\x08text\x00\x81W\x05\x84X"
+    + b"x" * 600
+    + b"\x00t\x00\x04\x01$#\x00\x16\x052\x00\x16\x02Qc\x01\x81(\x18\x04\x02@\x12\x06\x12\x054\x01"
+    + b"\x12\x05\x14\x03\x10\x046\x01*\x02c"
+)
+
+
+def write(path, data, mode="wb"):
+    with open(path, mode) as f:
+        f.write(data)
+
+
+dev = SimulatedFlash(256)
+os.VfsFat.mkfs(dev)
+vfs = os.VfsFat(dev)
+dev.use_natively(vfs)
+os.mount(vfs, "/flash")
+sys.path.insert(0, "/flash")
+
+write("/flash/source.py", "def check():\n    return 'source'\n")
+# The second cluster of this file comes after the one of another file.
+write("/flash/fragmented.mpy", MPY[:512])
+write("/flash/between.txt", b"between")
+write("/flash/fragmented.mpy", MPY[512:], "ab")
+write("/flash/contiguous.mpy", MPY)
+
+# Files opened by Python code don't map the device.
+with open("/flash/contiguous.mpy", "rb") as f:
+    try:
+        memoryview(f)
+    except TypeError:
+        print("TypeError")
+print(dev.mapped)
+
+# Neither do imports of source files, or of .mpy files that aren't in one run
+# of clusters.
+import source
+
+print(source.check(), dev.mapped)
+
+import fragmented
+
+print(fragmented.check(), dev.mapped)
+
+# A .mpy file in one run of clusters is mapped.
+import contiguous
+
+print(contiguous.check(), dev.mapped)
+try:
+    write("/flash/after.txt", b"after")
+except OSError:
+    print("OSError")
@@ -0,0 +1,61 @@
+# SPDX-FileCopyrightText: 2014 MicroPython & CircuitPython contributors (https://github.com/adafruit/circuitpython/graphs/contributors)
+#
+# SPDX-License-Identifier: MIT
+
+# This script measures how long individual allocations take while a large
+# set of objects is kept alive, and prints a histogram of the results.  The
+# slowest allocations are the ones that trigger a garbage collection, so the
+# tail of the histogram shows the GC pause time.
+#
+# Run it with the unix port, for example to compare the effect of
+# MICROPY_GC_INCREMENTAL_SWEEP on a heap comparable to a board with PSRAM:
+#
+#   make -C ports/unix
+#   make -C ports/unix BUILD=build-sweep CFLAGS_EXTRA=-DMICROPY_GC_INCREMENTAL_SWEEP=1
+#   ports/unix/build-standard/micropython -X heapsize=8M tools/gc_pause_histogram.py
+#   ports/unix/build-sweep/micropython -X heapsize=8M tools/gc_pause_histogram.py
+#
+# The optional arguments are the number of live objects to keep and the
+# number of allocations to time.
+
+import gc
+import sys
+import time
+
+live_count = int(sys.argv[1]) if len(sys.argv) > 1 else 50000
+iterations = int(sys.argv[2]) if len(sys.argv) > 2 else 200000
+
+# Objects that stay alive make the mark phase expensive, and the garbage
+# created below makes the sweep phase expensive.
+live = [[i, str(i)] for i in range(live_count)]
+
+# buckets[n] counts allocations that took less than 2**n microseconds.
+buckets = [0] * 24
+total = 0
+worst = 0
+
+gc.collect()
+free_before = gc.mem_free()
+for i in range(iterations):
+    t0 = time.ticks_us()
+    obj = bytearray(16 + (i & 127))
+    dt = time.ticks_diff(time.ticks_us(), t0)
+    # Replace a live object now and again so that the heap churns.
+    if i & 15 == 0:
+        live[i % live_count] = [i, obj]
+    total += dt
+    if dt > worst:
+        worst = dt
+    n = 0
+    while (1 << n) <= dt and n < len(buckets) - 1:
+        n += 1
+    buckets[n] += 1
+
+print("live objects:", live_count, "heap free at start:", free_before)
+print("allocations:", iterations, "mean us:", total / iterations, "max us:", worst)
+print("  time (us)      count")
+lo = 0
+for n, count in enumerate(buckets):
+    if count:
+        print("{:>6} - {:<6} {:>9}".format(lo, (1 << n) - 1, count))
+    lo = 1 << n
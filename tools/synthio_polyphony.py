@@ -0,0 +1,57 @@
+# SPDX-FileCopyrightText: 2014 MicroPython & CircuitPython contributors (https://github.com/adafruit/circuitpython/graphs/contributors)
+#
+# SPDX-License-Identifier: MIT
+
+# This script measures how much of the CPU a synthio.Synthesizer needs to keep
+# up with playback, for an increasing number of voices.  For each voice count
+# it renders a number of blocks with audiocore.get_buffer and compares the time
+# that took with the duration of the audio that was rendered.
+#
+# Run it on a board, or with the unix port to compare two builds:
+#
+#   make -C ports/unix VARIANT=coverage
+#   ports/unix/build-coverage/micropython tools/synthio_polyphony.py
+#
+# The optional arguments are the largest number of voices, the sample rate,
+# the channel count and the number of blocks to time.  The last column is the
+# number of voices that fit in one percent of the CPU, which should stay about
+# the same as voices are added if the cost per voice doesn't grow.
+
+import array
+import sys
+import time
+from math import sin, pi
+
+from audiocore import get_buffer
+from synthio import Note, Synthesizer
+
+max_voices = int(sys.argv[1]) if len(sys.argv) > 1 else 12
+sample_rate = int(sys.argv[2]) if len(sys.argv) > 2 else 48000
+channel_count = int(sys.argv[3]) if len(sys.argv) > 3 else 1
+blocks = int(sys.argv[4]) if len(sys.argv) > 4 else 200
+
+sine = array.array("h", [int(32767 * sin(i * 2 * pi / 256)) for i in range(256)])
+
+print("sample rate:", sample_rate, "channels:", channel_count, "blocks:", blocks)
+print("voices    us/block      CPU%  voices/CPU%")
+for voices in range(1, max_voices + 1):
+    synth = Synthesizer(sample_rate=sample_rate, channel_count=channel_count, waveform=sine)
+    notes = [
+        Note(frequency=110 * (1 + i / 4), panning=(i % 3 - 1) / 2, waveform=sine)
+        for i in range(voices)
+    ]
+    synth.press(notes)
+    # the first blocks start the notes; don't time them
+    for _ in range(4):
+        get_buffer(synth)
+    frames = len(get_buffer(synth)[1]) // channel_count
+
+    t0 = time.ticks_us()
+    for _ in range(blocks):
+        get_buffer(synth)
+    dt = time.ticks_diff(time.ticks_us(), t0)
+
+    audio_us = blocks * frames * 1000000 // sample_rate
+    cpu = 100 * dt / audio_us
+    print("{:>6} {:>11.1f} {:>9.2f} {:>12.2f}".format(voices, dt / blocks, cpu, voices / cpu))
+    synth.deinit()